@@ -0,0 +1,834 @@
+///////////////////////////////////////////////////////////////////////////////
+// Project:     wxECharts
+// Home:        https://github.com/PBfordev/wxecharts
+// File Name:   arrowreader.cpp
+// Purpose:     Implementation of Apache Arrow IPC data reader
+// Author:      PB
+// Created:     2026-10-18
+// Copyright:   (c) 2026 PB
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#include <wx/wx.h>
+
+#include <cstring>
+
+#include "arrowreader.h"
+
+using namespace std;
+
+namespace {
+
+// the supported platforms are little-endian as is the Arrow data
+// and the flatbuffers with the metadata
+template <typename T>
+T ReadNumber(const void* data, const size_t offset)
+{
+    T value;
+
+    memcpy(&value, static_cast<const char*>(data) + offset, sizeof(T));
+    return value;
+}
+
+constexpr char ArrowFileMagic[] = "ARROW1";
+constexpr uint32_t ContinuationMarker = 0xFFFFFFFF;
+
+// MetadataVersion, older versions differ in the buffer layout
+constexpr int16_t MetadataVersionV4 = 3;
+
+// the field indices in the flatbuffer tables, as defined
+// in Message.fbs and Schema.fbs in the Arrow repository
+enum MessageField
+{
+    MessageVersion,
+    MessageHeaderType,
+    MessageHeader,
+    MessageBodyLength,
+};
+
+enum MessageHeaderType
+{
+    HeaderSchema = 1,
+    HeaderDictionaryBatch = 2,
+    HeaderRecordBatch = 3,
+};
+
+enum SchemaField
+{
+    SchemaEndianness,
+    SchemaFields,
+};
+
+enum FieldField
+{
+    FieldName,
+    FieldNullable,
+    FieldTypeType,
+    FieldType,
+    FieldDictionary,
+    FieldChildren,
+};
+
+enum Type
+{
+    TypeNull = 1,
+    TypeInt = 2,
+    TypeFloatingPoint = 3,
+    TypeBinary = 4,
+    TypeUtf8 = 5,
+    TypeBool = 6,
+    TypeDecimal = 7,
+    TypeDate = 8,
+    TypeTime = 9,
+    TypeTimestamp = 10,
+    TypeInterval = 11,
+    TypeList = 12,
+    TypeStruct = 13,
+    TypeUnion = 14,
+    TypeFixedSizeBinary = 15,
+    TypeFixedSizeList = 16,
+    TypeMap = 17,
+    TypeDuration = 18,
+    TypeLargeBinary = 19,
+    TypeLargeUtf8 = 20,
+    TypeLargeList = 21,
+};
+
+// the field indices of type tables, all types read have just one or two fields
+constexpr size_t IntBitWidth = 0;
+constexpr size_t IntIsSigned = 1;
+constexpr size_t FloatingPointPrecision = 0;
+constexpr size_t TimestampUnit = 0;
+
+constexpr int16_t PrecisionSingle = 1;
+constexpr int16_t PrecisionDouble = 2;
+
+enum DictionaryEncodingField
+{
+    DictionaryEncodingId,
+    DictionaryEncodingIndexType,
+};
+
+enum RecordBatchField
+{
+    RecordBatchLength,
+    RecordBatchNodes,
+    RecordBatchBuffers,
+    RecordBatchCompression,
+};
+
+enum DictionaryBatchField
+{
+    DictionaryBatchId,
+    DictionaryBatchData,
+    DictionaryBatchIsDelta,
+};
+
+// structs FieldNode {length, null_count} and Buffer {offset, length}
+constexpr size_t FieldNodeSize = 16;
+constexpr size_t BufferSize = 16;
+
+// the nodes and buffers of a record batch, with the bounds checked
+class RecordBatchView
+{
+public:
+    RecordBatchView(const uint8_t* nodes, const size_t nodeCount,
+                    const uint8_t* buffers, const size_t bufferCount,
+                    const char* body, const size_t bodySize)
+        : m_nodes(nodes), m_nodeCount(nodeCount),
+          m_buffers(buffers), m_bufferCount(bufferCount),
+          m_body(body), m_bodySize(bodySize)
+    {}
+
+    bool GetNode(const size_t idx, size_t& length, size_t& nullCount) const
+    {
+        if ( idx >= m_nodeCount )
+            return false;
+
+        const int64_t nodeLength = ReadNumber<int64_t>(m_nodes, idx * FieldNodeSize);
+        const int64_t nodeNullCount = ReadNumber<int64_t>(m_nodes, idx * FieldNodeSize + 8);
+
+        if ( nodeLength < 0 || nodeNullCount < 0 || nodeNullCount > nodeLength )
+            return false;
+
+        length = static_cast<size_t>(nodeLength);
+        nullCount = static_cast<size_t>(nodeNullCount);
+        return true;
+    }
+
+    bool GetBuffer(const size_t idx, const char*& data, size_t& size) const
+    {
+        if ( idx >= m_bufferCount )
+            return false;
+
+        const int64_t offset = ReadNumber<int64_t>(m_buffers, idx * BufferSize);
+        const int64_t length = ReadNumber<int64_t>(m_buffers, idx * BufferSize + 8);
+
+        if ( offset < 0 || length < 0
+             || static_cast<uint64_t>(offset) > m_bodySize
+             || static_cast<uint64_t>(length) > m_bodySize - offset )
+            return false;
+
+        data = m_body + offset;
+        size = static_cast<size_t>(length);
+        return true;
+    }
+private:
+    const uint8_t* m_nodes;
+    size_t m_nodeCount;
+    const uint8_t* m_buffers;
+    size_t m_bufferCount;
+    const char* m_body;
+    size_t m_bodySize;
+};
+
+// calls onString(data, length) for each value of a UTF-8 array
+// starting at firstBuffer, null values are passed as empty
+template <typename OnString>
+bool ReadUtf8Array(const RecordBatchView& view, const size_t firstBuffer,
+                   const size_t length, const size_t nullCount,
+                   const bool largeOffsets, OnString onString)
+{
+    const char* validity = nullptr;
+    const char* offsets = nullptr;
+    const char* data = nullptr;
+    size_t validitySize = 0, offsetsSize = 0, dataSize = 0;
+
+    if ( !view.GetBuffer(firstBuffer, validity, validitySize)
+         || !view.GetBuffer(firstBuffer + 1, offsets, offsetsSize)
+         || !view.GetBuffer(firstBuffer + 2, data, dataSize) )
+        return false;
+
+    if ( length == 0 )
+        return true;
+
+    const size_t offsetSize = largeOffsets ? sizeof(int64_t) : sizeof(int32_t);
+
+    if ( (nullCount > 0 && validitySize < (length + 7) / 8)
+         || offsetsSize / offsetSize < length + 1 )
+        return false;
+
+    ArrowReader::ColumnChunk chunk;
+
+    chunk.length = length;
+    chunk.nullCount = nullCount;
+    chunk.validity = nullCount > 0 ? reinterpret_cast<const uint8_t*>(validity) : nullptr;
+
+    auto offsetAt = [=](const size_t idx)
+    {
+        return largeOffsets ? ReadNumber<int64_t>(offsets, idx * offsetSize)
+                            : ReadNumber<int32_t>(offsets, idx * offsetSize);
+    };
+
+    int64_t start = offsetAt(0);
+
+    for ( size_t i = 0; i < length; ++i )
+    {
+        const int64_t end = offsetAt(i + 1);
+
+        if ( start < 0 || end < start || static_cast<uint64_t>(end) > dataSize )
+            return false;
+
+        if ( ArrowReader::IsValid(chunk, i) )
+            onString(data + start, static_cast<size_t>(end - start));
+        else
+            onString(data, 0);
+
+        start = end;
+    }
+
+    return true;
+}
+
+bool ReadIndex(const char* indices, const size_t idx,
+               const int32_t bitWidth, const bool isSigned, int64_t& index)
+{
+    switch ( bitWidth )
+    {
+        case 8:
+            index = isSigned ? ReadNumber<int8_t>(indices, idx) : ReadNumber<uint8_t>(indices, idx);
+            return true;
+        case 16:
+            index = isSigned ? ReadNumber<int16_t>(indices, idx * 2) : ReadNumber<uint16_t>(indices, idx * 2);
+            return true;
+        case 32:
+            index = isSigned ? ReadNumber<int32_t>(indices, idx * 4) : ReadNumber<uint32_t>(indices, idx * 4);
+            return true;
+        case 64:
+            // an unsigned index above INT64_MAX is negative and thus invalid
+            index = ReadNumber<int64_t>(indices, idx * 8);
+            return true;
+    }
+
+    return false;
+}
+
+} // anonymous namespace
+
+// a table in a flatbuffer, see https://flatbuffers.dev/internals/
+// all the accesses are bounds-checked, so that a damaged
+// or malicious buffer cannot make the reader crash
+class ArrowReader::FlatTable
+{
+public:
+    FlatTable()
+    {}
+
+    static FlatTable GetRoot(const uint8_t* buffer, const size_t size)
+    {
+        if ( size < sizeof(uint32_t) )
+            return FlatTable();
+        return FlatTable(buffer, size, ReadNumber<uint32_t>(buffer, 0));
+    }
+
+    bool IsValid() const
+    {
+        return m_buffer != nullptr;
+    }
+
+    template <typename T>
+    T GetScalar(const size_t field, const T defaultValue) const
+    {
+        const size_t offset = GetFieldOffset(field, sizeof(T));
+
+        if ( offset == 0 )
+            return defaultValue;
+        return ReadNumber<T>(m_buffer, offset);
+    }
+
+    // returns an invalid table if the field is absent
+    FlatTable GetTable(const size_t field) const
+    {
+        const size_t offset = GetReferencedOffset(field);
+
+        if ( offset == 0 )
+            return FlatTable();
+        return FlatTable(m_buffer, m_size, offset);
+    }
+
+    // for a vector of scalars or structs, returns false if the field is absent
+    bool GetVector(const size_t field, const size_t elementSize,
+                   const uint8_t*& elements, size_t& count) const
+    {
+        const size_t offset = GetReferencedOffset(field);
+
+        if ( offset == 0 || offset > m_size - sizeof(uint32_t) )
+            return false;
+
+        const uint32_t vectorCount = ReadNumber<uint32_t>(m_buffer, offset);
+
+        if ( vectorCount > (m_size - offset - sizeof(uint32_t)) / elementSize )
+            return false;
+
+        elements = m_buffer + offset + sizeof(uint32_t);
+        count = vectorCount;
+        return true;
+    }
+
+    bool GetString(const size_t field, wxString& str) const
+    {
+        const uint8_t* chars = nullptr;
+        size_t length = 0;
+
+        if ( !GetVector(field, 1, chars, length) )
+            return false;
+
+        str = wxString::FromUTF8(reinterpret_cast<const char*>(chars), length);
+        return true;
+    }
+
+    // returns false if the field is absent or any of the tables is invalid
+    bool GetTables(const size_t field, vector<FlatTable>& tables) const
+    {
+        const uint8_t* elements = nullptr;
+        size_t count = 0;
+
+        if ( !GetVector(field, sizeof(uint32_t), elements, count) )
+            return false;
+
+        for ( size_t i = 0; i < count; ++i )
+        {
+            const size_t elementOffset = (elements - m_buffer) + i * sizeof(uint32_t);
+            const size_t offset = elementOffset + ReadNumber<uint32_t>(m_buffer, elementOffset);
+
+            tables.push_back(FlatTable(m_buffer, m_size, offset));
+            if ( !tables.back().IsValid() )
+                return false;
+        }
+
+        return true;
+    }
+private:
+    const uint8_t* m_buffer{nullptr};
+    size_t m_size{0};
+    size_t m_table{0};
+    size_t m_vtable{0};
+    size_t m_vtableSize{0};
+
+    FlatTable(const uint8_t* buffer, const size_t size, const size_t table)
+    {
+        if ( size < sizeof(int32_t) || table > size - sizeof(int32_t) )
+            return;
+
+        // the vtable offset is signed, the vtable can be before or after the table
+        const int64_t vtable = static_cast<int64_t>(table) - ReadNumber<int32_t>(buffer, table);
+
+        if ( vtable < 0 || static_cast<uint64_t>(vtable) > size - 2 * sizeof(uint16_t) )
+            return;
+
+        const uint16_t vtableSize = ReadNumber<uint16_t>(buffer, vtable);
+
+        if ( vtableSize < 2 * sizeof(uint16_t) || vtableSize > size - vtable )
+            return;
+
+        m_buffer = buffer;
+        m_size = size;
+        m_table = table;
+        m_vtable = static_cast<size_t>(vtable);
+        m_vtableSize = vtableSize;
+    }
+
+    // returns 0 if the field is absent
+    size_t GetFieldOffset(const size_t field, const size_t fieldSize) const
+    {
+        // the vtable starts with its size and the table size
+        const size_t entry = (2 + field) * sizeof(uint16_t);
+
+        if ( !m_buffer || entry + sizeof(uint16_t) > m_vtableSize )
+            return 0;
+
+        const uint16_t fieldOffset = ReadNumber<uint16_t>(m_buffer, m_vtable + entry);
+
+        if ( fieldOffset == 0 || fieldSize > m_size || m_table + fieldOffset > m_size - fieldSize )
+            return 0;
+        return m_table + fieldOffset;
+    }
+
+    // for the fields referencing a table, vector or string, returns 0 if the field is absent
+    size_t GetReferencedOffset(const size_t field) const
+    {
+        const size_t offset = GetFieldOffset(field, sizeof(uint32_t));
+
+        if ( offset == 0 )
+            return 0;
+
+        const size_t referenced = offset + ReadNumber<uint32_t>(m_buffer, offset);
+
+        return referenced < m_size ? referenced : 0;
+    }
+};
+
+bool ArrowReader::IsArrowData(const char* data, const size_t size)
+{
+    if ( size < 8 )
+        return false;
+
+    return memcmp(data, ArrowFileMagic, strlen(ArrowFileMagic)) == 0
+           || ReadNumber<uint32_t>(data, 0) == ContinuationMarker;
+}
+
+bool ArrowReader::Read(const char* data, const size_t size)
+{
+    wxCHECK(data, false);
+    wxCHECK(m_columns.empty(), false);
+
+    size_t pos = 0;
+    bool hasSchema = false;
+
+    // the file format is the stream format between the magic at the start,
+    // padded to 8 bytes, and the footer, which is needed only for random access
+    if ( size >= 8 && memcmp(data, ArrowFileMagic, strlen(ArrowFileMagic)) == 0 )
+        pos = 8;
+
+    while ( pos < size )
+    {
+        if ( size - pos < sizeof(uint32_t) )
+            return false;
+
+        uint32_t metadataSize = ReadNumber<uint32_t>(data, pos);
+
+        pos += sizeof(uint32_t);
+        // the continuation marker precedes the size since Arrow 0.15
+        if ( metadataSize == ContinuationMarker )
+        {
+            if ( size - pos < sizeof(uint32_t) )
+                return false;
+
+            metadataSize = ReadNumber<uint32_t>(data, pos);
+            pos += sizeof(uint32_t);
+        }
+
+        // the end of the stream
+        if ( metadataSize == 0 )
+            break;
+
+        if ( metadataSize > size - pos )
+            return false;
+
+        const FlatTable message = FlatTable::GetRoot(reinterpret_cast<const uint8_t*>(data + pos), metadataSize);
+        const int64_t bodyLength = message.GetScalar<int64_t>(MessageBodyLength, 0);
+
+        // the metadata are padded so that the body is aligned
+        pos += metadataSize;
+        if ( !message.IsValid() || bodyLength < 0 || static_cast<uint64_t>(bodyLength) > size - pos )
+            return false;
+
+        if ( message.GetScalar<int16_t>(MessageVersion, 0) < MetadataVersionV4 )
+        {
+            wxLogError(_("Arrow data written by Arrow versions older than 0.15 are not supported."));
+            return false;
+        }
+
+        const FlatTable header = message.GetTable(MessageHeader);
+        const char* body = data + pos;
+
+        pos += static_cast<size_t>(bodyLength);
+        switch ( message.GetScalar<uint8_t>(MessageHeaderType, 0) )
+        {
+            case HeaderSchema:
+                if ( hasSchema || !ReadSchema(header) )
+                    return false;
+                hasSchema = true;
+                break;
+            case HeaderDictionaryBatch:
+                if ( !hasSchema || !ReadDictionaryBatch(header, body, static_cast<size_t>(bodyLength)) )
+                    return false;
+                break;
+            case HeaderRecordBatch:
+                if ( !hasSchema || !ReadRecordBatch(header, body, static_cast<size_t>(bodyLength)) )
+                    return false;
+                break;
+            default:
+                wxLogError(_("Unsupported Arrow message type %u."), message.GetScalar<uint8_t>(MessageHeaderType, 0));
+                return false;
+        }
+    }
+
+    return hasSchema;
+}
+
+const std::vector<ArrowReader::Column>& ArrowReader::GetColumns() const
+{
+    return m_columns;
+}
+
+size_t ArrowReader::GetRowCount() const
+{
+    return m_rowCount;
+}
+
+bool ArrowReader::IsValid(const ColumnChunk& chunk, const size_t row)
+{
+    return !chunk.validity || (chunk.validity[row / 8] >> (row % 8)) & 1;
+}
+
+bool ArrowReader::ReadSchema(const FlatTable& schema)
+{
+    // Endianness::Little
+    if ( schema.GetScalar<int16_t>(SchemaEndianness, 0) != 0 )
+    {
+        wxLogError(_("Big-endian Arrow data are not supported."));
+        return false;
+    }
+
+    vector<FlatTable> fields;
+
+    if ( !schema.GetTables(SchemaFields, fields) )
+        return false;
+
+    m_columns.resize(fields.size());
+    m_layouts.resize(fields.size());
+    for ( size_t i = 0; i < fields.size(); ++i )
+    {
+        if ( !ReadField(fields[i], m_columns[i], m_layouts[i]) )
+            return false;
+    }
+
+    return true;
+}
+
+bool ArrowReader::ReadField(const FlatTable& field, Column& column, ColumnLayout& layout)
+{
+    layout.firstNode = m_nodeCount;
+    layout.firstBuffer = m_bufferCount;
+    if ( !CountBuffers(field, m_nodeCount, m_bufferCount) )
+        return false;
+
+    field.GetString(FieldName, column.name);
+
+    const uint8_t typeType = field.GetScalar<uint8_t>(FieldTypeType, 0);
+    const FlatTable type = field.GetTable(FieldType);
+    const FlatTable dictionary = field.GetTable(FieldDictionary);
+    const bool isUtf8 = typeType == TypeUtf8 || typeType == TypeLargeUtf8;
+
+    layout.largeOffsets = typeType == TypeLargeUtf8;
+
+    // the record batches contain the indices into the dictionary
+    // sent in the dictionary batches, the field type is the type
+    // of the dictionary values
+    if ( dictionary.IsValid() )
+    {
+        const FlatTable indexType = dictionary.GetTable(DictionaryEncodingIndexType);
+        Dictionary& values = m_dictionaries[dictionary.GetScalar<int64_t>(DictionaryEncodingId, 0)];
+
+        layout.dictionaryId = dictionary.GetScalar<int64_t>(DictionaryEncodingId, 0);
+        // int32 if not specified
+        layout.indexBitWidth = indexType.IsValid() ? indexType.GetScalar<int32_t>(IntBitWidth, 0) : 32;
+        layout.indexSigned = indexType.IsValid() ? indexType.GetScalar<uint8_t>(IntIsSigned, 0) != 0 : true;
+        if ( layout.indexBitWidth != 8 && layout.indexBitWidth != 16
+             && layout.indexBitWidth != 32 && layout.indexBitWidth != 64 )
+            return false;
+
+        values.supported = isUtf8;
+        values.largeOffsets = layout.largeOffsets;
+        if ( isUtf8 )
+            column.type = String;
+        return true;
+    }
+
+    switch ( typeType )
+    {
+        case TypeFloatingPoint:
+        {
+            const int16_t precision = type.GetScalar<int16_t>(FloatingPointPrecision, 0);
+
+            if ( precision == PrecisionDouble )
+                column.type = Float64;
+            else if ( precision == PrecisionSingle )
+                column.type = Float32;
+            break;
+        }
+        case TypeInt:
+            if ( type.GetScalar<int32_t>(IntBitWidth, 0) == 64 && type.GetScalar<uint8_t>(IntIsSigned, 0) != 0 )
+                column.type = Int64;
+            break;
+        case TypeTimestamp:
+        {
+            // TimeUnit: SECOND, MILLISECOND, MICROSECOND, NANOSECOND
+            static const int64_t unitsPerSecond[] = { 1, 1000, 1000000, 1000000000 };
+            const int16_t unit = type.GetScalar<int16_t>(TimestampUnit, 0);
+
+            if ( unit >= 0 && unit <= 3 )
+            {
+                column.type = Timestamp;
+                column.unitsPerSecond = unitsPerSecond[unit];
+            }
+            break;
+        }
+        case TypeUtf8:
+        case TypeLargeUtf8:
+            column.type = String;
+            break;
+    }
+
+    return true;
+}
+
+bool ArrowReader::CountBuffers(const FlatTable& field, size_t& nodeCount, size_t& bufferCount)
+{
+    nodeCount += 1;
+
+    // just the validity and indices
+    if ( field.GetTable(FieldDictionary).IsValid() )
+    {
+        bufferCount += 2;
+        return true;
+    }
+
+    const uint8_t typeType = field.GetScalar<uint8_t>(FieldTypeType, 0);
+
+    switch ( typeType )
+    {
+        case TypeNull:
+            break;
+        case TypeInt:
+        case TypeFloatingPoint:
+        case TypeBool:
+        case TypeDecimal:
+        case TypeDate:
+        case TypeTime:
+        case TypeTimestamp:
+        case TypeInterval:
+        case TypeFixedSizeBinary:
+        case TypeDuration:
+            // validity and values
+            bufferCount += 2;
+            break;
+        case TypeBinary:
+        case TypeUtf8:
+        case TypeLargeBinary:
+        case TypeLargeUtf8:
+            // validity, offsets and values
+            bufferCount += 3;
+            break;
+        case TypeList:
+        case TypeLargeList:
+        case TypeMap:
+            // validity and offsets
+            bufferCount += 2;
+            break;
+        case TypeStruct:
+        case TypeFixedSizeList:
+            // validity
+            bufferCount += 1;
+            break;
+        default:
+        {
+            wxString name;
+
+            field.GetString(FieldName, name);
+            wxLogError(_("Column '%s' has an unsupported Arrow type %u."), name, typeType);
+            return false;
+        }
+    }
+
+    vector<FlatTable> children;
+
+    // the field can have no children
+    field.GetTables(FieldChildren, children);
+    for ( const auto& child : children )
+    {
+        if ( !CountBuffers(child, nodeCount, bufferCount) )
+            return false;
+    }
+
+    return true;
+}
+
+bool ArrowReader::ReadDictionaryBatch(const FlatTable& batch, const char* body, const size_t bodySize)
+{
+    const auto it = m_dictionaries.find(batch.GetScalar<int64_t>(DictionaryBatchId, 0));
+
+    if ( it == m_dictionaries.end() )
+        return false;
+
+    Dictionary& dictionary = it->second;
+
+    if ( !dictionary.supported )
+        return true;
+
+    const FlatTable data = batch.GetTable(DictionaryBatchData);
+    const uint8_t* nodes = nullptr;
+    const uint8_t* buffers = nullptr;
+    size_t nodeCount = 0, bufferCount = 0;
+
+    if ( data.GetTable(RecordBatchCompression).IsValid() )
+    {
+        wxLogError(_("Compressed Arrow data are not supported."));
+        return false;
+    }
+
+    if ( !data.GetVector(RecordBatchNodes, FieldNodeSize, nodes, nodeCount)
+         || !data.GetVector(RecordBatchBuffers, BufferSize, buffers, bufferCount) )
+        return false;
+
+    const RecordBatchView view(nodes, nodeCount, buffers, bufferCount, body, bodySize);
+    size_t length = 0, nullCount = 0;
+
+    if ( !view.GetNode(0, length, nullCount) )
+        return false;
+
+    // a new dictionary replaces the previous one with the same id,
+    // a delta is appended to it
+    if ( batch.GetScalar<uint8_t>(DictionaryBatchIsDelta, 0) == 0 )
+        dictionary.values.clear();
+
+    return ReadUtf8Array(view, 0, length, nullCount, dictionary.largeOffsets,
+        [&dictionary](const char* str, const size_t strLength)
+        {
+            dictionary.values.push_back({str, strLength});
+        });
+}
+
+bool ArrowReader::ReadRecordBatch(const FlatTable& batch, const char* body, const size_t bodySize)
+{
+    const int64_t length = batch.GetScalar<int64_t>(RecordBatchLength, 0);
+    const uint8_t* nodes = nullptr;
+    const uint8_t* buffers = nullptr;
+    size_t nodeCount = 0, bufferCount = 0;
+
+    if ( batch.GetTable(RecordBatchCompression).IsValid() )
+    {
+        wxLogError(_("Compressed Arrow data are not supported."));
+        return false;
+    }
+
+    if ( length < 0
+         || !batch.GetVector(RecordBatchNodes, FieldNodeSize, nodes, nodeCount)
+         || !batch.GetVector(RecordBatchBuffers, BufferSize, buffers, bufferCount)
+         || nodeCount < m_nodeCount || bufferCount < m_bufferCount )
+        return false;
+
+    const RecordBatchView view(nodes, nodeCount, buffers, bufferCount, body, bodySize);
+    const size_t rowCount = static_cast<size_t>(length);
+
+    for ( size_t i = 0; i < m_columns.size(); ++i )
+    {
+        Column& column = m_columns[i];
+        const ColumnLayout& layout = m_layouts[i];
+        ColumnChunk chunk;
+
+        if ( !view.GetNode(layout.firstNode, chunk.length, chunk.nullCount) || chunk.length != rowCount )
+            return false;
+
+        if ( column.type == Unsupported )
+            continue;
+
+        if ( column.type == String && layout.dictionaryId < 0 )
+        {
+            if ( !ReadUtf8Array(view, layout.firstBuffer, rowCount, chunk.nullCount, layout.largeOffsets,
+                    [&column](const char* str, const size_t strLength)
+                    {
+                        column.strings.append(str, strLength);
+                        column.strings += '\0';
+                    }) )
+                return false;
+            continue;
+        }
+
+        const char* validity = nullptr;
+        const char* values = nullptr;
+        size_t validitySize = 0, valuesSize = 0;
+
+        if ( !view.GetBuffer(layout.firstBuffer, validity, validitySize)
+             || !view.GetBuffer(layout.firstBuffer + 1, values, valuesSize)
+             || (chunk.nullCount > 0 && validitySize < (rowCount + 7) / 8) )
+            return false;
+
+        if ( chunk.nullCount > 0 )
+            chunk.validity = reinterpret_cast<const uint8_t*>(validity);
+
+        if ( column.type == String )
+        {
+            const Dictionary& dictionary = m_dictionaries[layout.dictionaryId];
+
+            if ( valuesSize / (layout.indexBitWidth / 8) < rowCount )
+                return false;
+
+            for ( size_t row = 0; row < rowCount; ++row )
+            {
+                int64_t index = 0;
+
+                if ( IsValid(chunk, row) )
+                {
+                    if ( !ReadIndex(values, row, layout.indexBitWidth, layout.indexSigned, index)
+                         || index < 0 || static_cast<uint64_t>(index) >= dictionary.values.size() )
+                        return false;
+
+                    column.strings.append(dictionary.values[index].first, dictionary.values[index].second);
+                }
+                column.strings += '\0';
+            }
+            continue;
+        }
+
+        if ( valuesSize / (column.type == Float32 ? sizeof(float) : sizeof(int64_t)) < rowCount )
+            return false;
+
+        chunk.values = values;
+        column.chunks.push_back(chunk);
+    }
+
+    m_rowCount += rowCount;
+    return true;
+}
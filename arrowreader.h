@@ -0,0 +1,133 @@
+///////////////////////////////////////////////////////////////////////////////
+// Project:     wxECharts
+// Home:        https://github.com/PBfordev/wxecharts
+// File Name:   arrowreader.h
+// Purpose:     Declaration of Apache Arrow IPC data reader
+// Author:      PB
+// Created:     2026-10-18
+// Copyright:   (c) 2026 PB
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <wx/string.h>
+
+/*****************************************************************
+
+ArrowReader
+---------------
+reads data in the Apache Arrow IPC format, both the streaming
+and the file one (the latter is also Feather version 2),
+without any dependency on the Arrow library
+
+The data are expected to be in memory, usually a memory-mapped
+file. The values of the numeric columns are not copied, the
+reader just locates their buffers in each record batch, so that
+the caller can use them in place. The strings are the only data
+copied: the values of each string column, plain or dictionary-
+encoded, are decoded into one string.
+
+Only the top-level columns of the types float64, float32, int64,
+timestamp and UTF-8 string are read, the other columns are
+skipped and reported as Unsupported. Compressed record batches
+and big-endian data are not supported.
+
+******************************************************************/
+
+class ArrowReader final
+{
+public:
+    enum ColumnType
+    {
+        Float64,
+        Float32,
+        Int64,
+        Timestamp, // int64
+        String,
+        Unsupported,
+    };
+
+    // the values of a column in one record batch
+    struct ColumnChunk
+    {
+        size_t length{0};
+        size_t nullCount{0};
+        // the validity bitmap, nullptr when the chunk has no nulls
+        const uint8_t* validity{nullptr};
+        // the values in place, nullptr for String and Unsupported columns;
+        // the Arrow library aligns them but other writers may not
+        const char* values{nullptr};
+    };
+
+    struct Column
+    {
+        wxString name;
+        ColumnType type{Unsupported};
+        // for Timestamp: 1 for seconds, 1000 for milliseconds and so on
+        int64_t unitsPerSecond{0};
+        std::vector<ColumnChunk> chunks;
+        // for String: the values from all the chunks, each terminated
+        // with '\0', null values are empty
+        std::string strings;
+    };
+
+    // returns true if the data look like an Arrow IPC file or stream
+    static bool IsArrowData(const char* data, const size_t size);
+
+    // data must remain valid while the columns are used
+    bool Read(const char* data, const size_t size);
+
+    const std::vector<Column>& GetColumns() const;
+    size_t GetRowCount() const;
+
+    // returns false if the value at row is null
+    static bool IsValid(const ColumnChunk& chunk, const size_t row);
+private:
+    class FlatTable;
+
+    // the position of a top-level column in the record batch
+    struct ColumnLayout
+    {
+        size_t firstNode{0};
+        size_t firstBuffer{0};
+        // for dictionary-encoded columns
+        int64_t dictionaryId{-1};
+        int32_t indexBitWidth{0};
+        bool indexSigned{false};
+        // for String, 64-bit offsets
+        bool largeOffsets{false};
+    };
+
+    struct Dictionary
+    {
+        // only UTF-8 string dictionaries are read
+        bool supported{false};
+        bool largeOffsets{false};
+        // the values in place
+        std::vector<std::pair<const char*, size_t>> values;
+    };
+
+    std::vector<Column> m_columns;
+    std::vector<ColumnLayout> m_layouts;
+    // in each record batch
+    size_t m_nodeCount{0};
+    size_t m_bufferCount{0};
+    std::map<int64_t, Dictionary> m_dictionaries;
+    size_t m_rowCount{0};
+
+    bool ReadSchema(const FlatTable& schema);
+    bool ReadField(const FlatTable& field, Column& column, ColumnLayout& layout);
+    bool ReadDictionaryBatch(const FlatTable& batch, const char* body, const size_t bodySize);
+    bool ReadRecordBatch(const FlatTable& batch, const char* body, const size_t bodySize);
+
+    // adds the number of the nodes and buffers the field and its children
+    // take in a record batch, fails for unsupported layouts
+    static bool CountBuffers(const FlatTable& field, size_t& nodeCount, size_t& bufferCount);
+};
@@ -0,0 +1,459 @@
+///////////////////////////////////////////////////////////////////////////////
+// Project:     wxECharts
+// Home:        https://github.com/PBfordev/wxecharts
+// File Name:   benchmarks.cpp
+// Purpose:     Implementation of performance benchmarks
+// Author:      PB
+// Created:     2026-10-18
+// Copyright:   (c) 2026 PB
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#include <wx/wx.h>
+#include <wx/filename.h>
+#include <wx/stopwatch.h>
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __LINUX__
+    #include <dirent.h>
+    #include <unistd.h>
+#endif // #ifdef __LINUX__
+
+#include <json.hpp>
+
+#include "benchmarks.h"
+#include "chartdatafile.h"
+#include "jsonwriter.h"
+#include "taskpool.h"
+
+using namespace std;
+
+using json = nlohmann::ordered_json;
+
+namespace {
+
+#ifdef __LINUX__
+
+// in bytes, the proportional set size if available, otherwise the resident set size
+size_t GetProcessMemory(const pid_t pid)
+{
+    const string folder = "/proc/" + to_string(pid) + "/";
+    string line;
+
+    ifstream rollup(folder + "smaps_rollup");
+
+    while ( getline(rollup, line) )
+    {
+        // e.g., "Pss:               12345 kB"
+        if ( line.compare(0, 4, "Pss:") == 0 )
+            return strtoull(line.c_str() + 4, nullptr, 10) * 1024;
+    }
+
+    ifstream status(folder + "status");
+
+    while ( getline(status, line) )
+    {
+        if ( line.compare(0, 6, "VmRSS:") == 0 )
+            return strtoull(line.c_str() + 6, nullptr, 10) * 1024;
+    }
+
+    return 0;
+}
+
+#endif // #ifdef __LINUX__
+
+} // anonymous namespace
+
+wxString Benchmarks::RunJSONSerializers()
+{
+    static constexpr size_t seriesCount = 20;
+    static constexpr size_t valueCount = 100000;
+    static constexpr size_t runCount = 5;
+
+    // random walks, as the values of sensors usually are
+    mt19937 generator(0);
+    normal_distribution<double> distribution(0, 1);
+    vector<vector<double>> series(seriesCount);
+
+    for ( auto& values : series )
+    {
+        double value = 0;
+
+        values.reserve(valueCount);
+        for ( size_t i = 0; i < valueCount; ++i )
+        {
+            value += distribution(generator);
+            values.push_back(value);
+        }
+    }
+
+    JSONWriter::Precision precision;
+
+    precision.type = JSONWriter::Precision::SignificantDigits;
+    precision.digits = 5;
+
+    string nlohmannOut, writerOut, roundedOut;
+    long nlohmannTime = LONG_MAX, writerTime = LONG_MAX, roundedTime = LONG_MAX;
+
+    // the best of the runs, the first ones can be slowed down by allocating
+    for ( size_t run = 0; run < runCount; ++run )
+    {
+        wxStopWatch stopWatch;
+        json allSeriesJSON = json::array();
+
+        for ( size_t s = 0; s < seriesCount; ++s )
+        {
+            json oneSeriesJSON;
+
+            oneSeriesJSON["name"] = "Series " + to_string(s);
+            oneSeriesJSON["type"] = "line";
+            oneSeriesJSON["data"] = series[s];
+            allSeriesJSON.push_back(move(oneSeriesJSON));
+        }
+        nlohmannOut = allSeriesJSON.dump();
+        nlohmannTime = min(nlohmannTime, stopWatch.Time());
+
+        stopWatch.Start();
+        writerOut.clear();
+
+        JSONWriter writer(writerOut);
+
+        writer.BeginArray();
+        for ( size_t s = 0; s < seriesCount; ++s )
+        {
+            writer.BeginObject();
+            writer.Key("name");
+            writer.String("Series " + to_string(s));
+            writer.Key("type");
+            writer.String("line");
+            writer.Key("data");
+            writer.BeginArray();
+            writer.Doubles(series[s].data(), series[s].size());
+            writer.EndArray();
+            writer.EndObject();
+        }
+        writer.EndArray();
+        writerTime = min(writerTime, stopWatch.Time());
+
+        stopWatch.Start();
+        roundedOut.clear();
+
+        JSONWriter roundedWriter(roundedOut);
+
+        roundedWriter.BeginArray();
+        for ( size_t s = 0; s < seriesCount; ++s )
+        {
+            roundedWriter.BeginArray();
+            roundedWriter.Doubles(series[s].data(), series[s].size(), precision);
+            roundedWriter.EndArray();
+        }
+        roundedWriter.EndArray();
+        roundedTime = min(roundedTime, stopWatch.Time());
+    }
+
+    const double megabytes = writerOut.size() / (1024.0 * 1024.0);
+    wxString report;
+
+    report.Printf(_("JSON serializers, %zu series of %zu values (%.1f MB), best of %zu runs:"),
+                  seriesCount, valueCount, megabytes, runCount);
+    report += wxString::Format(_("\nnlohmann::json: %ld ms"), nlohmannTime);
+    report += wxString::Format(_("\nJSONWriter: %ld ms (%.1fx faster)"),
+                               writerTime, static_cast<double>(nlohmannTime) / max(writerTime, 1L));
+    report += wxString::Format(_("\nJSONWriter with %d significant digits: %ld ms, %.1f MB"),
+                               precision.digits, roundedTime, roundedOut.size() / (1024.0 * 1024.0));
+    if ( nlohmannOut != writerOut )
+        report += _("\nERROR: The results differ.");
+
+    // the values too small for scaling by the exact powers of ten are rounded too
+    JSONWriter::Precision threeDigits;
+    char number[JSONWriter::MaxNumberLength];
+
+    threeDigits.type = JSONWriter::Precision::SignificantDigits;
+    threeDigits.digits = 3;
+
+    const string tiny(number, JSONWriter::FormatDouble(number, 1.23456e-25, threeDigits));
+
+    if ( tiny != "1.23e-25" )
+        report += wxString::Format(_("\nERROR: 1.23456e-25 rounded to 3 significant digits is %s."), tiny);
+
+    return report;
+}
+
+wxString Benchmarks::RunDataFile()
+{
+    static constexpr size_t seriesCount = 10;
+    static constexpr size_t valueCount = 1000000;
+
+    mt19937 generator(0);
+    normal_distribution<double> distribution(0, 1);
+    vector<vector<double>> values(seriesCount);
+    vector<ChartDataFile::SeriesToSave> series;
+    vector<wxString> variableNames;
+
+    for ( size_t s = 0; s < seriesCount; ++s )
+    {
+        double value = 0;
+
+        values[s].reserve(valueCount);
+        for ( size_t i = 0; i < valueCount; ++i )
+        {
+            value += distribution(generator);
+            values[s].push_back(value);
+        }
+        series.push_back({wxString::Format("Series %zu", s), ChartHelper::Line, values[s].data()});
+    }
+
+    variableNames.reserve(valueCount);
+    for ( size_t i = 0; i < valueCount; ++i )
+        variableNames.push_back(wxString::Format("Variable %zu", i));
+
+    const wxString fileName = wxFileName::CreateTempFileName("wxecdata");
+
+    if ( fileName.empty() )
+        return _("Data file: Could not create a temporary file.");
+
+    wxString report;
+
+    report.Printf(_("Data file, %zu series of %zu values with names (%.1f MB of values):"),
+                  seriesCount, valueCount, seriesCount * valueCount * sizeof(double) / (1024.0 * 1024.0));
+
+    for ( const bool compress : {false, true} )
+    {
+        wxStopWatch stopWatch;
+
+        if ( !ChartDataFile::Save(fileName, valueCount, variableNames, nullptr, series, wxString(), compress) )
+        {
+            report += _("\nERROR: Could not save the file.");
+            break;
+        }
+
+        const long saveTime = stopWatch.Time();
+        const double megabytes = wxFileName::GetSize(fileName).ToDouble() / (1024.0 * 1024.0);
+        long openTime = 0, pyramidsTime = 0, reopenTime = 0;
+        bool success = true;
+
+        // the first time, the pyramids are built and the index file is saved
+        {
+            ChartDataFile dataFile;
+
+            stopWatch.Start();
+            success = dataFile.Open(fileName, nullptr);
+            openTime = stopWatch.Time();
+            while ( success && !dataFile.GetSeriesPyramid(seriesCount - 1) )
+                this_thread::sleep_for(chrono::milliseconds(1));
+            pyramidsTime = stopWatch.Time();
+        }
+
+        // then the index file is just mapped
+        if ( success )
+        {
+            ChartDataFile dataFile;
+
+            stopWatch.Start();
+            success = dataFile.Open(fileName, nullptr);
+            reopenTime = stopWatch.Time();
+        }
+
+        if ( !success )
+        {
+            report += _("\nERROR: Could not open the file.");
+            break;
+        }
+
+        report += wxString::Format(_("\n%s: %.1f MB, saved in %ld ms, opened in %ld ms, pyramids ready after %ld ms, reopened in %ld ms"),
+                                   compress ? _("Compressed") : _("Uncompressed"), megabytes,
+                                   saveTime, openTime, pyramidsTime, reopenTime);
+    }
+
+    wxRemoveFile(fileName);
+    wxRemoveFile(ChartDataFile::GetIndexFileName(fileName));
+
+    return report;
+}
+
+wxString Benchmarks::RunTaskPool()
+{
+    static constexpr size_t seriesCount = 200;
+    static constexpr size_t valueCount = 5000;
+    static constexpr size_t runCount = 5;
+
+    mt19937 generator(0);
+    normal_distribution<double> distribution(0, 1);
+    vector<vector<double>> series(seriesCount);
+
+    for ( auto& values : series )
+    {
+        double value = 0;
+
+        values.reserve(valueCount);
+        for ( size_t i = 0; i < valueCount; ++i )
+        {
+            value += distribution(generator);
+            values.push_back(value);
+        }
+    }
+
+    vector<string> outputs(seriesCount);
+    auto serializeSeries = [&series, &outputs](const size_t idx)
+    {
+        json seriesJSON;
+
+        seriesJSON["name"] = "Series " + to_string(idx);
+        seriesJSON["type"] = "line";
+        seriesJSON["data"] = series[idx];
+        outputs[idx] = seriesJSON.dump();
+    };
+
+    const size_t processorCount = max(thread::hardware_concurrency(), 1u);
+    vector<size_t> threadCounts;
+
+    // 1, 2, 4, ... and the number of processors
+    for ( size_t count = 1; count < processorCount; count *= 2 )
+        threadCounts.push_back(count);
+    threadCounts.push_back(processorCount);
+
+    wxString report;
+    long singleThreadTime = 0;
+    vector<string> expected;
+
+    report.Printf(_("TaskPool, serializing %zu series of %zu values, %zu processors, best of %zu runs:"),
+                  seriesCount, valueCount, processorCount, runCount);
+
+    for ( const size_t threadCount : threadCounts )
+    {
+        // the calling thread runs the iterations too, and as TaskPool(0)
+        // uses the default number of threads, one thread runs without a pool
+        unique_ptr<TaskPool> tasks;
+        long time = LONG_MAX;
+
+        if ( threadCount > 1 )
+            tasks.reset(new TaskPool(threadCount - 1));
+
+        for ( size_t run = 0; run < runCount; ++run )
+        {
+            wxStopWatch stopWatch;
+
+            if ( tasks )
+            {
+                tasks->ParallelFor(seriesCount, serializeSeries);
+            }
+            else
+            {
+                for ( size_t s = 0; s < seriesCount; ++s )
+                    serializeSeries(s);
+            }
+            time = min(time, stopWatch.Time());
+        }
+
+        if ( threadCount == 1 )
+        {
+            singleThreadTime = time;
+            expected = outputs;
+        }
+        else if ( outputs != expected )
+        {
+            report += _("\nERROR: The results differ.");
+        }
+
+        if ( threadCount == 1 )
+            report += wxString::Format(_("\nThreads: 1, %ld ms"), time);
+        else
+            report += wxString::Format(_("\nThreads: %zu, %ld ms (%.1fx faster)"),
+                                       threadCount, time, static_cast<double>(singleThreadTime) / max(time, 1L));
+    }
+
+    return report;
+}
+
+wxString Benchmarks::RunWebViewStartup(const wxString& profileName,
+                                       const long pageLoadedTime, const long chartRenderedTime)
+{
+    auto formatTime = [](const long time)
+    {
+        return time < 0 ? wxString(_("not yet")) : wxString::Format(_("%ld ms"), time);
+    };
+
+    const size_t footprint = GetMemoryFootprint();
+    wxString report;
+
+    report.Printf(_("WebView startup with WebKit profile '%s':"), profileName);
+    report += wxString::Format(_("\nPage loaded: %s"), formatTime(pageLoadedTime));
+    report += wxString::Format(_("\nChart first rendered: %s"), formatTime(chartRenderedTime));
+    if ( footprint > 0 )
+        report += wxString::Format(_("\nMemory footprint of the application and its web processes: %.1f MB"),
+                                   footprint / (1024.0 * 1024.0));
+    else
+        report += _("\nMemory footprint is not available on this platform.");
+
+    return report;
+}
+
+size_t Benchmarks::GetMemoryFootprint()
+{
+#ifdef __LINUX__
+    map<pid_t, vector<pid_t>> childProcesses;
+    DIR* dir = opendir("/proc");
+
+    if ( !dir )
+        return 0;
+
+    while ( const dirent* entry = readdir(dir) )
+    {
+        const pid_t pid = static_cast<pid_t>(atol(entry->d_name));
+
+        if ( pid <= 0 )
+            continue;
+
+        ifstream statFile(string("/proc/") + entry->d_name + "/stat");
+        string stat;
+
+        getline(statFile, stat);
+
+        // "pid (command) state ppid ...", the command can contain anything
+        const size_t commandEnd = stat.rfind(')');
+
+        if ( commandEnd == string::npos )
+            continue;
+
+        istringstream fields(stat.substr(commandEnd + 1));
+        char state;
+        pid_t parentPid;
+
+        if ( fields >> state >> parentPid )
+            childProcesses[parentPid].push_back(pid);
+    }
+    closedir(dir);
+
+    // the web processes can be started through a sandbox, i.e. be grandchildren
+    vector<pid_t> pids{getpid()};
+    size_t footprint = 0;
+
+    while ( !pids.empty() )
+    {
+        const pid_t pid = pids.back();
+
+        pids.pop_back();
+        footprint += GetProcessMemory(pid);
+
+        const auto it = childProcesses.find(pid);
+
+        if ( it != childProcesses.end() )
+            pids.insert(pids.end(), it->second.begin(), it->second.end());
+    }
+
+    return footprint;
+#else
+    return 0;
+#endif // #ifdef __LINUX__
+}
@@ -0,0 +1,52 @@
+///////////////////////////////////////////////////////////////////////////////
+// Project:     wxECharts
+// Home:        https://github.com/PBfordev/wxecharts
+// File Name:   benchmarks.h
+// Purpose:     Declaration of performance benchmarks
+// Author:      PB
+// Created:     2026-10-18
+// Copyright:   (c) 2026 PB
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <wx/string.h>
+
+/*****************************************************************
+
+Benchmarks
+---------------
+measures the performance of the parts of the application,
+each benchmark returns its report as text
+
+The benchmarks take up to a few seconds and can run in any thread.
+
+******************************************************************/
+
+class Benchmarks final
+{
+public:
+    // serializes the same series values with nlohmann::json
+    // and JSONWriter, checking that the results are the same,
+    // and with JSONWriter rounding them to a few digits
+    static wxString RunJSONSerializers();
+
+    // saves series with variable names to a temporary data file,
+    // uncompressed and compressed, and opens it
+    static wxString RunDataFile();
+
+    // serializes each series of a chart update to its own string, as the
+    // chart update does, with TaskPool using from one thread up to all
+    // the processors
+    static wxString RunTaskPool();
+
+    // reports the webview startup times measured by the caller (in
+    // milliseconds, negative if not reached yet) and the memory footprint
+    static wxString RunWebViewStartup(const wxString& profileName,
+                                      const long pageLoadedTime, const long chartRenderedTime);
+
+    // in bytes, the proportional set size of the application and all its
+    // child processes (e.g., the web processes), 0 where not available
+    static size_t GetMemoryFootprint();
+};
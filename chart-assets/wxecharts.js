@@ -12,6 +12,74 @@
 // the one and only Apache ECharts instance
 var wxEChartstheChart;
 
+// type of the x axis: 'category' (variable names),
+// 'index' (variable indices) or 'time' (timestamps)
+var wxEChartsXAxisType = 'category';
+
+// level of detail (LOD) mode, where the C++ code sends
+// only the data for the visible range
+var wxEChartsLOD =
+{
+  active: false,
+  minValue: 0,
+  maxValue: 1,
+  first: 0,
+  names: null,
+  reportPending: false,
+};
+
+// live mode, where the C++ code sends only the newly pushed values
+// and the number of the oldest values to evict. Each series keeps its
+// points as [timestamp, value] pairs flattened to a preallocated typed
+// array for twice the capacity: the points are written after the window
+// and the window is moved back to the start only when it reaches the end,
+// so that a push costs the same for any capacity and the chart gets
+// a view of the window, without copying or allocating the points
+var wxEChartsLive = null;
+
+// the large series payloads are decoded in a Web Worker, so that
+// JSON.parse() does not block the page; the worker converts the values
+// to typed arrays and transfers them back, only setOption() runs here.
+// The decoded updates are applied in the order they were sent, an update
+// replacing all the series drops the older updates not applied yet.
+var wxEChartsDecoder =
+{
+  worker: null,
+  failed: false, // Web Workers are not available, decode here
+  generation: 0, // increases with every update replacing all the series
+  pending: [],   // the messages sent to the worker, in order
+  minWorkerLength: 64 * 1024, // shorter payloads are decoded here
+};
+
+// how the chart is rendered, chosen by the C++ code,
+// see wxEChartsSetRenderingOptions()
+var wxEChartsRendering =
+{
+  renderer: 'canvas',
+  devicePixelRatio: 0, // 0 for the pixel ratio of the display
+  animation: false,
+  large: false,
+  largeThreshold: 2000,
+  sampling: false,
+  progressive: 0,
+  seriesCount: 0,
+  // the render times are reported at most once per the interval
+  lastReportTime: -Infinity,
+  reportInterval: 250,
+};
+
+// resizing the chart renders it anew, so the resizes are coalesced to one
+// per animation frame; in the settle mode, the chart is only scaled while
+// it is being resized (e.g., by dragging a splitter) and rendered anew once
+// it has not been resized for settleDelay milliseconds
+var wxEChartsResize =
+{
+  pending: false,
+  settleMode: false,
+  settleDelay: 150,
+  settleTimer: null,
+};
+
 var wxEChartsSizingOptions =
 {
   widthToHeightRatio: 1,
@@ -31,12 +99,12 @@ function wxEChartsSendErrorMessage(error, where)
 
 function wxEChartsCreateChart(divId) {
   try {
-    wxEChartstheChart = echarts.init(document.getElementById(divId));
+    wxEChartsInitChart(document.getElementById(divId));
 
     let option = {
       legend: { selectedMode: false },
       tooltip: {},
-      animation: false,
+      animation: wxEChartsRendering.animation,
       grid: { left: '10%', top: '10%', bottom: '10%', right: '10%' },
       textStyle: { fontFamily: "Calibri, Tahoma, Arial, sans-serif", 
                    fontSize: '1rem', color: 'black' },
@@ -59,7 +127,30 @@ function wxEChartsCreateChart(divId) {
   }
 
   wxEChartsResizeChart();
-  window.onresize = function () { wxEChartsResizeChart(); };
+  window.onresize = function () { wxEChartsOnWindowResize(); };
+
+  window.oncontextmenu = function (event) 
+    { 
+      let p = {};
+
+      p.clientX = event.clientX;
+      p.clientY = event.clientY;
+      wxEChartsSendMessage('contextmenu\tnochart', p);
+      event.preventDefault();
+    }
+}
+
+// creates the chart instance with the renderer and pixel ratio,
+// which cannot be changed later
+function wxEChartsInitChart(dom) {
+  let initOptions = { renderer: wxEChartsRendering.renderer };
+
+  if (wxEChartsRendering.devicePixelRatio > 0)
+    initOptions.devicePixelRatio = wxEChartsRendering.devicePixelRatio;
+
+  wxEChartstheChart = echarts.init(dom, null, initOptions);
+
+  wxEChartstheChart.on('datazoom', function () { wxEChartsReportVisibleRange(); });
 
   wxEChartstheChart.on('dblclick', 'yAxis', function (params) {
     let p = {};
@@ -81,7 +172,11 @@ function wxEChartsCreateChart(divId) {
     p.seriesName = params.seriesName;
     p.seriesType = params.seriesType;
     p.color = params.color;
-    p.value = params.value;
+    // a data item is [x, value], on the category axis
+    // x is the same as the data index
+    p.value = params.value[1];
+    if (wxEChartsXAxisType !== 'category')
+      p.x = params.value[0];
     wxEChartsSendMessage('dblclick\tseries', p);
   });
 
@@ -94,82 +189,611 @@ function wxEChartsCreateChart(divId) {
     wxEChartsSendMessage('contextmenu\tchart', p);
     params.event.stop();
   });  
+}
 
-  window.oncontextmenu = function (event) 
-    { 
-      let p = {};
+function wxEChartsSetRenderingOptions(optionsJSON) {
+  try {
+    const o = JSON.parse(optionsJSON);
+    const r = wxEChartsRendering;
+    const recreate = o.renderer !== r.renderer || o.devicePixelRatio !== r.devicePixelRatio;
 
-      p.clientX = event.clientX;
-      p.clientY = event.clientY;
-      wxEChartsSendMessage('contextmenu\tnochart', p);
-      event.preventDefault();
+    r.renderer = o.renderer;
+    r.devicePixelRatio = o.devicePixelRatio;
+    r.animation = o.animation;
+    r.large = o.large;
+    r.largeThreshold = o.largeThreshold;
+    r.sampling = o.sampling;
+    r.progressive = o.progressive;
+
+    // the options are used when the chart is created
+    if (!wxEChartstheChart)
+      return;
+
+    if (recreate) {
+      const dom = wxEChartstheChart.getDom();
+      const option = wxEChartstheChart.getOption();
+
+      wxEChartstheChart.dispose();
+      wxEChartsInitChart(dom);
+      wxEChartstheChart.setOption(option);
+      wxEChartsResizeChart();
     }
+
+    let series = [];
+
+    for (let i = 0; i < r.seriesCount; ++i)
+      series.push({});
+    wxEChartsApplySeriesRendering(series);
+    wxEChartstheChart.setOption({ animation: r.animation, series: series });
+  } catch (e) {
+    wxEChartsSendErrorMessage(e, arguments.callee.name);
+  }
+}
+
+// sets the rendering options of the series items of an option,
+// which must contain all the series
+function wxEChartsApplySeriesRendering(series) {
+  const r = wxEChartsRendering;
+
+  for (let s of series) {
+    s.large = r.large;
+    s.largeThreshold = r.largeThreshold;
+    // null turns the sampling off
+    s.sampling = r.sampling ? 'lttb' : null;
+    s.progressive = r.progressive;
+  }
+  r.seriesCount = series.length;
+}
+
+// sets the option with the series data and reports how long it took,
+// ECharts renders the chart before setOption() returns
+function wxEChartsSetSeriesOption(option, opts) {
+  const start = performance.now();
+
+  wxEChartstheChart.setOption(option, opts);
+
+  const end = performance.now();
+  const r = wxEChartsRendering;
+
+  if (end - r.lastReportTime < r.reportInterval)
+    return;
+
+  let p = {};
+
+  p.time = end - start;
+  p.devicePixelRatio = window.devicePixelRatio;
+  wxEChartsSendMessage('rendered\tchart', p);
+  r.lastReportTime = end;
+}
+
+function wxEChartsOnWindowResize() {
+  const resize = wxEChartsResize;
+
+  if (!resize.settleMode) {
+    wxEChartsScheduleResize();
+    return;
+  }
+
+  wxEChartsScaleChart();
+  clearTimeout(resize.settleTimer);
+  resize.settleTimer = setTimeout(function () {
+    resize.settleTimer = null;
+    wxEChartsScheduleResize();
+  }, resize.settleDelay);
+}
+
+function wxEChartsScheduleResize() {
+  if (wxEChartsResize.pending)
+    return;
+
+  wxEChartsResize.pending = true;
+  window.requestAnimationFrame(function () {
+    wxEChartsResize.pending = false;
+    wxEChartsResizeChart();
+  });
+}
+
+// the size of the chart fitting its div with the sizing options,
+// null when smaller than the minimum size
+function wxEChartsGetChartSize() {
+  const dom = wxEChartstheChart.getDom();
+  const divWidth = dom.clientWidth;
+  const divHeight = dom.clientHeight;
+  let chartWidth = divWidth;
+  let chartHeight = chartWidth / wxEChartsSizingOptions.widthToHeightRatio;
+
+  if (chartHeight >= divHeight) {
+    chartHeight = divHeight;
+    chartWidth = divHeight * wxEChartsSizingOptions.widthToHeightRatio;
+  }
+
+  if (chartWidth >= wxEChartsSizingOptions.minWidth && chartHeight >= wxEChartsSizingOptions.minHeight)
+    return { width: chartWidth, height: chartHeight };
+  return null;
+}
+
+// scales the chart as already rendered to the new size, without rendering it
+function wxEChartsScaleChart() {
+  try {
+    const size = wxEChartsGetChartSize();
+    const content = wxEChartstheChart.getDom().firstElementChild;
+
+    if (!size || !content)
+      return;
+
+    content.style.transformOrigin = '0 0';
+    content.style.transform = 'scale('.concat(size.width / wxEChartstheChart.getWidth(), ',',
+                                              size.height / wxEChartstheChart.getHeight(), ')');
+  } catch (e) {
+    wxEChartsSendErrorMessage(e, arguments.callee.name);
+  }
 }
 
 function wxEChartsResizeChart() {
   try {
-    const dom = wxEChartstheChart.getDom();
-    const divWidth = dom.clientWidth;
-    const divHeight = dom.clientHeight;
-    let chartWidth = divWidth;
-    let chartHeight = chartWidth / wxEChartsSizingOptions.widthToHeightRatio;
+    const size = wxEChartsGetChartSize();
+    const content = wxEChartstheChart.getDom().firstElementChild;
+
+    if (content)
+      content.style.transform = '';
+
+    if (size) {
+      wxEChartstheChart.resize(size);
+      // the resolution of LOD data depends on the chart width
+      wxEChartsReportVisibleRange();
+    }
+
+  } catch (e) {
+    wxEChartsSendErrorMessage(e, arguments.callee.name);
+  }
+}
+
+function wxEChartsSetResizeSettleMode(settleMode, settleDelay) {
+  const resize = wxEChartsResize;
+
+  resize.settleMode = settleMode;
+  resize.settleDelay = settleDelay;
+  // a resize waiting to settle is done now
+  if (!settleMode && resize.settleTimer !== null) {
+    clearTimeout(resize.settleTimer);
+    resize.settleTimer = null;
+    wxEChartsScheduleResize();
+  }
+}
+
+function wxEChartsSetXAxisType(type) {
+  if (type === wxEChartsXAxisType)
+    return;
+
+  let option;
+
+  if (type === 'category') {
+    option = {
+      xAxis: { type: 'category', min: null, max: null, axisLabel: { formatter: null } },
+      tooltip: { trigger: 'item', axisPointer: { label: { formatter: null } } },
+      dataZoom: []
+    };
+  } else {
+    const formatter = type === 'index' ? wxEChartsLODVariableName : null;
+
+    option = {
+      xAxis: { type: type === 'time' ? 'time' : 'value', data: null, axisLabel: { formatter: formatter } },
+      tooltip: { trigger: 'axis', axisPointer: { label: { formatter: formatter ? function (p) { return formatter(p.value); } : null } } },
+      dataZoom: [{ type: 'inside', filterMode: 'none' }, { type: 'slider', filterMode: 'none' }]
+    };
+  }
+
+  wxEChartstheChart.setOption(option, { replaceMerge: ['dataZoom'] });
+  wxEChartsXAxisType = type;
+}
+
+// decodes the payload of an update of the kind: 'category', 'time', 'lod',
+// 'liveInit' or 'livePush', returns the update and the buffers to transfer;
+// runs in the worker too, so it must not use anything outside itself
+function wxEChartsDecodePayload(kind, payloadJSON) {
+  // JSON has no NaN, the C++ code sends null instead
+  function toFloat64Array(values) {
+    let array = new Float64Array(values.length);
+
+    for (let i = 0; i < values.length; ++i)
+      array[i] = values[i] === null ? NaN : values[i];
+    return array;
+  }
+
+  const update = JSON.parse(payloadJSON);
+  let transfer = [];
+
+  if (kind === 'category') {
+    // ECharts takes the category indices as the x values, so the series
+    // are typed too; the omitted series are empty objects without data
+    for (let s of update.series) {
+      if (s.data === undefined)
+        continue;
+
+      let data = new Float64Array(2 * s.data.length);
+
+      for (let i = 0; i < s.data.length; ++i) {
+        data[2 * i] = i;
+        data[2 * i + 1] = s.data[i] === null ? NaN : s.data[i];
+      }
+      s.data = data;
+      transfer.push(data.buffer);
+    }
+  } else if (kind === 'time') {
+    // the timestamps are shared by all the series, ECharts takes
+    // typed data as [x, value] pairs flattened to one array
+    const timestamps = update.timestamps;
+
+    for (let s of update.series) {
+      let data = new Float64Array(2 * s.data.length);
+
+      for (let i = 0; i < s.data.length; ++i) {
+        data[2 * i] = timestamps[i];
+        data[2 * i + 1] = s.data[i] === null ? NaN : s.data[i];
+      }
+      s.data = data;
+      transfer.push(data.buffer);
+    }
+    delete update.timestamps;
+  } else if (kind === 'lod') {
+    for (let s of update.series) {
+      let data = new Float64Array(2 * s.data.length);
+
+      for (let i = 0; i < s.data.length; ++i) {
+        data[2 * i] = s.data[i][0];
+        data[2 * i + 1] = s.data[i][1] === null ? NaN : s.data[i][1];
+      }
+      s.data = data;
+      transfer.push(data.buffer);
+    }
+  } else if (kind === 'liveInit') {
+    update.timestamps = toFloat64Array(update.timestamps);
+    transfer.push(update.timestamps.buffer);
+    for (let s of update.series) {
+      s.data = toFloat64Array(s.data);
+      transfer.push(s.data.buffer);
+    }
+  } else if (kind === 'livePush') {
+    update.timestamps = toFloat64Array(update.timestamps);
+    transfer.push(update.timestamps.buffer);
+    update.values = update.values.map(function (values) {
+      const array = toFloat64Array(values);
+
+      transfer.push(array.buffer);
+      return array;
+    });
+  }
+
+  return { update: update, transfer: transfer };
+}
+
+// the message handler of the worker
+function wxEChartsDecoderWorkerMain(event) {
+  const message = event.data;
+
+  try {
+    const decoded = wxEChartsDecodePayload(message.kind, message.payload);
+
+    postMessage({ update: decoded.update }, decoded.transfer);
+  } catch (e) {
+    postMessage({ error: { name: e.name, message: e.message } });
+  }
+}
+
+// returns null when Web Workers are not available
+function wxEChartsGetDecoderWorker() {
+  const decoder = wxEChartsDecoder;
+
+  if (decoder.worker || decoder.failed)
+    return decoder.worker;
+
+  try {
+    // the page is loaded from a file, where a worker script cannot be
+    // loaded from its URL, so it is created from the functions above
+    const source = wxEChartsDecodePayload.toString().concat(
+                     '\nonmessage = ', wxEChartsDecoderWorkerMain.toString(), ';');
 
-    if (chartHeight >= divHeight) {
-      chartHeight = divHeight;
-      chartWidth = divHeight * wxEChartsSizingOptions.widthToHeightRatio;
+    decoder.worker = new Worker(URL.createObjectURL(new Blob([source], { type: 'text/javascript' })));
+    decoder.worker.onmessage = wxEChartsOnPayloadDecoded;
+    decoder.worker.onerror = function (event) {
+      // the worker failed, decode the payloads it did not decode here
+      const pending = decoder.pending;
+
+      event.preventDefault();
+      decoder.worker.terminate();
+      decoder.worker = null;
+      decoder.failed = true;
+      decoder.pending = [];
+      for (let message of pending) {
+        if (message.generation === decoder.generation)
+          wxEChartsDecodeAndApply(message.kind, message.payload);
+      }
+    };
+  } catch (e) {
+    decoder.worker = null;
+    decoder.failed = true;
+  }
+
+  return decoder.worker;
+}
+
+function wxEChartsDecodePayloadAsync(kind, payloadJSON, replacesSeries) {
+  const decoder = wxEChartsDecoder;
+
+  if (replacesSeries)
+    ++decoder.generation;
+
+  // the updates not replacing the series must wait for those being decoded
+  if (payloadJSON.length >= decoder.minWorkerLength || (!replacesSeries && decoder.pending.length > 0)) {
+    const worker = wxEChartsGetDecoderWorker();
+
+    if (worker) {
+      const message = { kind: kind, generation: decoder.generation, payload: payloadJSON };
+
+      decoder.pending.push(message);
+      worker.postMessage({ kind: kind, payload: payloadJSON });
+      return;
     }
+  }
 
-    if (chartWidth >= wxEChartsSizingOptions.minWidth && chartHeight >= wxEChartsSizingOptions.minHeight)
-      wxEChartstheChart.resize({ width: chartWidth, height: chartHeight });
-  
+  wxEChartsDecodeAndApply(kind, payloadJSON);
+}
+
+function wxEChartsDecodeAndApply(kind, payloadJSON) {
+  let update;
+
+  try {
+    update = wxEChartsDecodePayload(kind, payloadJSON).update;
   } catch (e) {
     wxEChartsSendErrorMessage(e, arguments.callee.name);
+    return;
   }
+  wxEChartsApplyDecodedPayload(kind, update);
+}
+
+function wxEChartsOnPayloadDecoded(event) {
+  const message = wxEChartsDecoder.pending.shift();
+
+  // replaced by a newer update
+  if (message.generation !== wxEChartsDecoder.generation)
+    return;
+
+  if (event.data.error)
+    wxEChartsSendErrorMessage(event.data.error, 'wxEChartsDecodePayload');
+  else
+    wxEChartsApplyDecodedPayload(message.kind, event.data.update);
+}
+
+function wxEChartsApplyDecodedPayload(kind, update) {
+  if (kind === 'category')
+    wxEChartsApplyUpdateSeries(update);
+  else if (kind === 'time')
+    wxEChartsApplyUpdateSeriesTime(update);
+  else if (kind === 'lod')
+    wxEChartsApplyUpdateSeriesLOD(update);
+  else if (kind === 'liveInit')
+    wxEChartsApplyLiveInit(update);
+  else if (kind === 'livePush')
+    wxEChartsApplyLivePush(update);
 }
 
 function wxEChartsUpdateSeries(seriesJSON) {
+  wxEChartsDecodePayloadAsync('category', seriesJSON, true);
+}
+
+function wxEChartsApplyUpdateSeries(option) {
   try {
-    wxEChartstheChart.setOption(JSON.parse(seriesJSON));
+    wxEChartsLOD.active = false;
+    wxEChartsLive = null;
+    wxEChartsSetXAxisType('category');
+    wxEChartsApplySeriesRendering(option.series);
+    wxEChartsSetSeriesOption(option);
   } catch (e) {
     wxEChartsSendErrorMessage(e, arguments.callee.name);
   }
 }
 
-function wxEChartsUpdateVariableNames(variableNamesJSON) {
+function wxEChartsUpdateSeriesTime(seriesJSON) {
+  wxEChartsDecodePayloadAsync('time', seriesJSON, true);
+}
+
+function wxEChartsApplyUpdateSeriesTime(update) {
   try {
-    wxEChartstheChart.setOption({ xAxis : { data: JSON.parse(variableNamesJSON) } });
+    wxEChartsLOD.active = false;
+    wxEChartsLive = null;
+    wxEChartsSetXAxisType('time');
+    wxEChartsApplySeriesRendering(update.series);
+    wxEChartsSetSeriesOption({ xAxis: { min: null, max: null }, series: update.series });
   } catch (e) {
     wxEChartsSendErrorMessage(e, arguments.callee.name);
   }
 }
 
-function wxEChartsSaveChartAsImage(width) {
+function wxEChartsLODVariableName(value) {
+  const idx = value - wxEChartsLOD.first;
+
+  if (wxEChartsLOD.names && Number.isInteger(idx) && idx >= 0 && idx < wxEChartsLOD.names.length)
+    return wxEChartsLOD.names[idx];
+  return String(Math.round(value));
+}
+
+function wxEChartsUpdateSeriesLOD(lodJSON) {
+  wxEChartsDecodePayloadAsync('lod', lodJSON, true);
+}
+
+function wxEChartsApplyUpdateSeriesLOD(lod) {
   try {
-    return wxEChartstheChart.getDataURL({ type: 'png', pixelRatio: width / wxEChartstheChart.getWidth(), backgroundColor: 'white' });
+    let option = {
+      xAxis: { min: lod.min, max: Math.max(lod.max, lod.min + 1) },
+      series: lod.series
+    };
+
+    for (let s of option.series) {
+      s.showSymbol = false;
+      s.animation = false;
+    }
+    wxEChartsApplySeriesRendering(option.series);
+
+    wxEChartsSetXAxisType(lod.xType);
+
+    if (lod.windowStart !== undefined) {
+      const zoomWindow = { startValue: lod.windowStart, endValue: lod.windowEnd };
+
+      option.dataZoom = [zoomWindow, zoomWindow];
+    }
+
+    wxEChartsLOD.active = true;
+    wxEChartsLive = null;
+    wxEChartsLOD.minValue = option.xAxis.min;
+    wxEChartsLOD.maxValue = option.xAxis.max;
+    wxEChartsLOD.first = lod.first;
+    wxEChartsLOD.names = lod.names ? lod.names : null;
+
+    wxEChartsSetSeriesOption(option);
   } catch (e) {
     wxEChartsSendErrorMessage(e, arguments.callee.name);
   }
 }
 
-function wxEChartsGetChartColors() {
+function wxEChartsLiveInit(liveJSON) {
+  wxEChartsDecodePayloadAsync('liveInit', liveJSON, true);
+}
+
+function wxEChartsApplyLiveInit(live) {
   try {
-    return JSON.stringify(wxEChartstheChart.getOption().color);
+    wxEChartsLive = {
+      capacity: live.capacity,
+      first: 0, // in points
+      size: 0,
+      data: live.series.map(function () { return new Float64Array(4 * live.capacity); })
+    };
+    wxEChartsLivePushValues(live.timestamps, live.series.map(function (s) { return s.data; }));
+
+    for (let s of live.series) {
+      s.showSymbol = false;
+      s.data = [];
+    }
+    wxEChartsApplySeriesRendering(live.series);
+
+    wxEChartsLOD.active = false;
+    wxEChartsSetXAxisType('time');
+    wxEChartstheChart.setOption({ xAxis: { min: null, max: null }, series: live.series },
+                                { replaceMerge: ['series'] });
+    wxEChartsLiveRender();
   } catch (e) {
     wxEChartsSendErrorMessage(e, arguments.callee.name);
   }
 }
 
-function wxEChartsSetChartColors(colorsJSON) {  
+function wxEChartsLivePush(pushJSON) {
+  wxEChartsDecodePayloadAsync('livePush', pushJSON, false);
+}
+
+function wxEChartsApplyLivePush(push) {
   try {
-    wxEChartstheChart.setOption({color: JSON.parse(colorsJSON)});
+    const live = wxEChartsLive;
+
+    if (!live)
+      return;
+
+    const evict = Math.min(push.evict, live.size);
+
+    live.first += evict;
+    live.size -= evict;
+    wxEChartsLivePushValues(push.timestamps, push.values);
+    wxEChartsLiveRender();
   } catch (e) {
     wxEChartsSendErrorMessage(e, arguments.callee.name);
   }
 }
 
-function wxEChartsGetChartSizingOptions() {
+// values[s][i] is the value of series s for timestamps[i],
+// both decoded to typed arrays, with NaN for missing values
+function wxEChartsLivePushValues(timestamps, values) {
+  const live = wxEChartsLive;
+  // the older ones would be evicted by the newer ones anyway
+  const skip = Math.max(0, timestamps.length - live.capacity);
+
+  for (let i = skip; i < timestamps.length; ++i) {
+    if (live.size === live.capacity) {
+      ++live.first;
+      --live.size;
+    }
+    // once per capacity points at most
+    if (live.first + live.size === 2 * live.capacity) {
+      for (let data of live.data)
+        data.copyWithin(0, 2 * live.first, 2 * (live.first + live.size));
+      live.first = 0;
+    }
+
+    const idx = 2 * (live.first + live.size);
+
+    for (let s = 0; s < live.data.length; ++s) {
+      live.data[s][idx] = timestamps[i];
+      live.data[s][idx + 1] = values[s][i];
+    }
+    ++live.size;
+  }
+}
+
+// ECharts takes the views as [x, value] pairs flattened to one array,
+// NaN being a missing value; it still renders the whole window
+function wxEChartsLiveRender() {
+  const live = wxEChartsLive;
+  const series = live.data.map(function (data) {
+    return { data: data.subarray(2 * live.first, 2 * (live.first + live.size)) };
+  });
+
+  wxEChartsSetSeriesOption({ series: series });
+}
+
+// sends the visible range and its width in pixels to the C++ code,
+// at most once per animation frame
+function wxEChartsReportVisibleRange() {
+  if (!wxEChartsLOD.active || wxEChartsLOD.reportPending)
+    return;
+
+  wxEChartsLOD.reportPending = true;
+  window.requestAnimationFrame(function () {
+    wxEChartsLOD.reportPending = false;
+    try {
+      const zoom = wxEChartstheChart.getOption().dataZoom[0];
+      const range = wxEChartsLOD.maxValue - wxEChartsLOD.minValue;
+      const startValue = wxEChartsLOD.minValue + range * zoom.start / 100;
+      const endValue = wxEChartsLOD.minValue + range * zoom.end / 100;
+      const width = wxEChartstheChart.convertToPixel({ xAxisIndex: 0 }, endValue)
+                    - wxEChartstheChart.convertToPixel({ xAxisIndex: 0 }, startValue);
+      let p = {};
+
+      p.startValue = startValue;
+      p.endValue = endValue;
+      p.width = Math.round(width);
+      wxEChartsSendMessage('datazoom\tx', p);
+    } catch (e) {
+      wxEChartsSendErrorMessage(e, 'wxEChartsReportVisibleRange');
+    }
+  });
+}
+
+function wxEChartsUpdateVariableNames(variableNamesJSON) {
   try {
-    return JSON.stringify(wxEChartsSizingOptions);
+    wxEChartstheChart.setOption({ xAxis : { data: JSON.parse(variableNamesJSON) } });
+  } catch (e) {
+    wxEChartsSendErrorMessage(e, arguments.callee.name);
+  }
+}
+
+function wxEChartsSaveChartAsImage(width) {
+  try {
+    return wxEChartstheChart.getDataURL({ type: 'png', pixelRatio: width / wxEChartstheChart.getWidth(), backgroundColor: 'white' });
+  } catch (e) {
+    wxEChartsSendErrorMessage(e, arguments.callee.name);
+  }
+}
+
+function wxEChartsSetChartColors(colorsJSON) {  
+  try {
+    wxEChartstheChart.setOption({color: JSON.parse(colorsJSON)});
   } catch (e) {
     wxEChartsSendErrorMessage(e, arguments.callee.name);
   }
@@ -189,6 +813,34 @@ function wxEChartsSetChartSizingOptions(optionsJSON) {
   }
 }
 
+// the colors and sizing options together, obtained once after the chart
+// is created, the C++ code then keeps them
+function wxEChartsGetChartOptions() {
+  try {
+    return JSON.stringify({ colors: wxEChartstheChart.getOption().color, sizingOptions: wxEChartsSizingOptions });
+  } catch (e) {
+    wxEChartsSendErrorMessage(e, arguments.callee.name);
+  }
+}
+
+function wxEChartsSetChartOptions(optionsJSON) {
+  try {
+    const o = JSON.parse(optionsJSON);
+
+    if (o.colors)
+      wxEChartstheChart.setOption({ color: o.colors });
+
+    if (o.sizingOptions) {
+      wxEChartsSizingOptions.widthToHeightRatio = o.sizingOptions.widthToHeightRatio;
+      wxEChartsSizingOptions.minWidth = o.sizingOptions.minWidth;
+      wxEChartsSizingOptions.minHeight = o.sizingOptions.minHeight;
+      wxEChartsResizeChart();
+    }
+  } catch (e) {
+    wxEChartsSendErrorMessage(e, arguments.callee.name);
+  }
+}
+
 function wxEChartsGetEChartsVersion() {
   try {
     return echarts.version;
@@ -0,0 +1,834 @@
+///////////////////////////////////////////////////////////////////////////////
+// Project:     wxECharts
+// Home:        https://github.com/PBfordev/wxecharts
+// File Name:   chartdatafile.cpp
+// Purpose:     Implementation of memory-mapped chart data file
+// Author:      PB
+// Created:     2026-10-18
+// Copyright:   (c) 2026 PB
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#include <wx/wx.h>
+#include <wx/ffile.h>
+#include <wx/filefn.h>
+#include <wx/mstream.h>
+#include <wx/zstream.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#include "chartdatafile.h"
+
+using namespace std;
+
+namespace {
+
+// the supported platforms (Windows x64, Linux on x64 or Arm64) are little-endian,
+// so the numbers in the files can be read and written directly
+template <typename T>
+T ReadNumber(const char* data, const size_t offset)
+{
+    T value;
+
+    memcpy(&value, data + offset, sizeof(T));
+    return value;
+}
+
+template <typename T>
+void WriteNumber(char* data, const size_t offset, const T value)
+{
+    memcpy(data + offset, &value, sizeof(T));
+}
+
+// the reserved bytes in [first, last) must be 0, so that they
+// can be used by the later format versions
+bool AreReservedBytesZero(const char* data, const size_t first, const size_t last)
+{
+    return all_of(data + first, data + last, [](const char c) { return c == 0; });
+}
+
+constexpr size_t HeaderSize = 64;
+constexpr size_t SeriesEntrySize = 32;
+constexpr size_t BlockHeaderSize = 32;
+// cache line
+constexpr size_t BlockAlignment = 64;
+
+constexpr char DataFileMagic[] = "wxECDATA";
+constexpr uint32_t DataFileVersion = 2;
+constexpr uint32_t ValueTypeFloat64 = 0;
+
+constexpr uint32_t CompressionNone = 0;
+constexpr uint32_t CompressionZlib = 1;
+
+// writes the block at the current file position, which must be aligned
+bool WriteBlock(wxFFile& file, const void* data, const size_t size, const bool compress)
+{
+    const void* storedData = data;
+    size_t storedSize = size;
+    uint32_t compression = CompressionNone;
+    wxMemoryOutputStream compressed;
+
+    if ( compress && size > 0 )
+    {
+        {
+            // the fastest level, so that saving stays fast
+            wxZlibOutputStream zlib(compressed, wxZ_BEST_SPEED, wxZLIB_ZLIB);
+
+            zlib.Write(data, size);
+            zlib.Close();
+        }
+
+        if ( compressed.GetSize() < size )
+        {
+            compression = CompressionZlib;
+            storedData = compressed.GetOutputStreamBuffer()->GetBufferStart();
+            storedSize = compressed.GetSize();
+        }
+    }
+
+    char header[BlockHeaderSize] = {0};
+
+    WriteNumber<uint32_t>(header, 0, compression);
+    WriteNumber<uint64_t>(header, 8, storedSize);
+    WriteNumber<uint64_t>(header, 16, size);
+
+    if ( file.Write(header, BlockHeaderSize) != BlockHeaderSize
+         || file.Write(storedData, storedSize) != storedSize )
+        return false;
+
+    const size_t padding = (BlockAlignment - (BlockHeaderSize + storedSize) % BlockAlignment) % BlockAlignment;
+    const char zeros[BlockAlignment] = {0};
+
+    return file.Write(zeros, padding) == padding;
+}
+
+constexpr char IndexFileMagic[] = "wxECLODX";
+constexpr uint32_t IndexFileVersion = 1;
+
+// values processed at once when building the pyramids,
+// their pages are then dropped from the working set
+constexpr size_t BuildChunkSize = ChartDataFile::PyramidBaseItemSize * 2048;
+
+} // anonymous namespace
+
+ChartDataFile::ChartDataFile()
+{}
+
+ChartDataFile::~ChartDataFile()
+{
+    m_cancelBuild = true;
+    if ( m_buildThread.joinable() )
+        m_buildThread.join();
+}
+
+bool ChartDataFile::Open(const wxString& fileName, const std::function<void()>& onPyramidsBuilt)
+{
+    wxCHECK_MSG(!m_file.IsOpened(), false, "Data file already opened");
+
+    m_fileName = fileName;
+    m_fileModificationTime = wxFileModificationTime(fileName);
+
+    if ( !m_file.Open(fileName) )
+        return false;
+
+    if ( !(ArrowReader::IsArrowData(m_file.GetData(), m_file.GetSize()) ? ReadArrow() : ReadHeader()) )
+    {
+        wxLogError(_("'%s' is not a valid chart data file."), fileName);
+        m_file.Close();
+        return false;
+    }
+
+    // e.g., an Arrow stream with only the schema, the chart needs values
+    if ( m_valueCount == 0 )
+    {
+        wxLogError(_("The data file '%s' contains no values."), fileName);
+        m_file.Close();
+        return false;
+    }
+
+    if ( LoadIndexFile() )
+    {
+        m_pyramidsReady = true;
+        return true;
+    }
+
+    m_pyramids.assign(m_seriesValues.size(), SeriesPyramid(PyramidBaseItemSize));
+    m_buildThread = thread(&ChartDataFile::BuildPyramids, this, onPyramidsBuilt);
+    return true;
+}
+
+const wxString& ChartDataFile::GetFileName() const
+{
+    return m_fileName;
+}
+
+size_t ChartDataFile::GetSeriesCount() const
+{
+    return m_seriesValues.size();
+}
+
+size_t ChartDataFile::GetValueCount() const
+{
+    return m_valueCount;
+}
+
+wxString ChartDataFile::GetSeriesName(const size_t seriesIdx) const
+{
+    wxCHECK(seriesIdx < m_seriesNames.size(), wxString());
+    return m_seriesNames[seriesIdx];
+}
+
+ChartHelper::SeriesType ChartDataFile::GetSeriesType(const size_t seriesIdx) const
+{
+    wxCHECK(seriesIdx < m_seriesTypes.size(), ChartHelper::Line);
+    return m_seriesTypes[seriesIdx];
+}
+
+const double* ChartDataFile::GetSeriesValues(const size_t seriesIdx) const
+{
+    wxCHECK(seriesIdx < m_seriesValues.size(), nullptr);
+    return m_seriesValues[seriesIdx];
+}
+
+ChartDataFile::VariablesType ChartDataFile::GetVariablesType() const
+{
+    return m_variablesType;
+}
+
+wxString ChartDataFile::GetVariableName(const size_t valueIdx) const
+{
+    wxCHECK(m_variablesType == VariableNames, wxString());
+    wxCHECK(valueIdx < m_valueCount, wxString());
+
+    const char* name = m_variableNames[valueIdx];
+
+    // without the terminating '\0'
+    return wxString::FromUTF8(name, m_variableNames[valueIdx + 1] - name - 1);
+}
+
+const int64_t* ChartDataFile::GetTimestamps() const
+{
+    return m_timestamps;
+}
+
+const wxString& ChartDataFile::GetOptions() const
+{
+    return m_options;
+}
+
+const SeriesPyramid* ChartDataFile::GetSeriesPyramid(const size_t seriesIdx) const
+{
+    wxCHECK(seriesIdx < m_pyramids.size(), nullptr);
+
+    if ( !m_pyramidsReady.load(memory_order_acquire) )
+        return nullptr;
+    return &m_pyramids[seriesIdx];
+}
+
+wxString ChartDataFile::GetIndexFileName(const wxString& fileName)
+{
+    return fileName + ".lod";
+}
+
+bool ChartDataFile::ReadHeader()
+{
+    const char* data = m_file.GetData();
+    const size_t fileSize = m_file.GetSize();
+
+    if ( fileSize < HeaderSize || memcmp(data, DataFileMagic, 8) != 0 )
+        return false;
+
+    const uint32_t version = ReadNumber<uint32_t>(data, 8);
+
+    if ( version < 1 || version > DataFileVersion )
+    {
+        wxLogError(_("Unsupported chart data file version %u."), version);
+        return false;
+    }
+
+    const uint32_t seriesCount = ReadNumber<uint32_t>(data, 12);
+    const uint64_t valueCount = ReadNumber<uint64_t>(data, 16);
+    const uint64_t stringTableOffset = ReadNumber<uint64_t>(data, 24);
+    const uint64_t stringTableSize = ReadNumber<uint64_t>(data, 32);
+
+    if ( seriesCount == 0
+         || !AreReservedBytesZero(data, version == 1 ? 40 : 52, version == 1 ? HeaderSize : 56)
+         || HeaderSize + seriesCount * SeriesEntrySize > fileSize
+         || stringTableOffset > fileSize || stringTableSize > fileSize - stringTableOffset
+         // compressed values can take less than 8 bytes
+         || valueCount > (version == 1 ? fileSize : SIZE_MAX) / sizeof(double) )
+        return false;
+
+    for ( uint32_t i = 0; i < seriesCount; ++i )
+    {
+        const char* entry = data + HeaderSize + i * SeriesEntrySize;
+        const uint64_t valuesOffset = ReadNumber<uint64_t>(entry, 0);
+        const uint32_t nameOffset = ReadNumber<uint32_t>(entry, 8);
+        const uint32_t nameLength = ReadNumber<uint32_t>(entry, 12);
+        const uint32_t valueType = ReadNumber<uint32_t>(entry, 16);
+        const uint32_t seriesType = version > 1 ? ReadNumber<uint32_t>(entry, 20) : static_cast<uint32_t>(ChartHelper::Line);
+        const char* values = data + valuesOffset;
+
+        if ( valueType != ValueTypeFloat64
+             || !AreReservedBytesZero(entry, version == 1 ? 20 : 24, SeriesEntrySize)
+             || (seriesType != ChartHelper::Bar && seriesType != ChartHelper::Line)
+             || valuesOffset % sizeof(double) != 0
+             || valuesOffset > fileSize
+             || static_cast<uint64_t>(nameOffset) + nameLength > stringTableSize )
+            return false;
+
+        if ( version > 1 )
+        {
+            uint64_t valuesSize = 0;
+
+            if ( !ReadBlock(valuesOffset, values, valuesSize) || valuesSize != valueCount * sizeof(double) )
+                return false;
+        }
+        else if ( valueCount > (fileSize - valuesOffset) / sizeof(double) )
+        {
+            return false;
+        }
+
+        m_seriesNames.push_back(wxString::FromUTF8(data + stringTableOffset + nameOffset, nameLength));
+        m_seriesTypes.push_back(static_cast<ChartHelper::SeriesType>(seriesType));
+        m_seriesValues.push_back(reinterpret_cast<const double*>(values));
+    }
+
+    m_valueCount = static_cast<size_t>(valueCount);
+
+    if ( version == 1 )
+        return true;
+
+    const uint32_t optionsOffset = ReadNumber<uint32_t>(data, 56);
+    const uint32_t optionsLength = ReadNumber<uint32_t>(data, 60);
+
+    if ( static_cast<uint64_t>(optionsOffset) + optionsLength > stringTableSize )
+        return false;
+    m_options = wxString::FromUTF8(data + stringTableOffset + optionsOffset, optionsLength);
+
+    return ReadVariables(ReadNumber<uint64_t>(data, 40), ReadNumber<uint32_t>(data, 48));
+}
+
+bool ChartDataFile::ReadVariables(const uint64_t blockOffset, const uint32_t type)
+{
+    if ( blockOffset == 0 )
+        return true;
+
+    const char* variables = nullptr;
+    uint64_t size = 0;
+
+    if ( !ReadBlock(blockOffset, variables, size) )
+        return false;
+
+    if ( type == VariableTimestamps )
+    {
+        const int64_t* timestamps = reinterpret_cast<const int64_t*>(variables);
+
+        if ( size != m_valueCount * sizeof(int64_t) || !is_sorted(timestamps, timestamps + m_valueCount) )
+            return false;
+
+        m_variablesType = VariableTimestamps;
+        m_timestamps = timestamps;
+        return true;
+    }
+
+    if ( type != VariableNames )
+        return false;
+
+    return SetVariableNames(variables, size);
+}
+
+bool ChartDataFile::SetVariableNames(const char* names, const size_t size)
+{
+    // the names are not converted to wxString, which would
+    // take long and a lot of memory for many variables
+    const char* const end = names + size;
+
+    m_variableNames.reserve(m_valueCount + 1);
+    for ( const char* name = names; name < end; )
+    {
+        const char* nameEnd = static_cast<const char*>(memchr(name, '\0', end - name));
+
+        if ( !nameEnd || m_variableNames.size() == m_valueCount )
+            return false;
+
+        m_variableNames.push_back(name);
+        name = nameEnd + 1;
+    }
+
+    if ( m_variableNames.size() != m_valueCount )
+        return false;
+
+    m_variableNames.push_back(end);
+    m_variablesType = VariableNames;
+    return true;
+}
+
+bool ChartDataFile::ReadBlock(const uint64_t offset, const char*& blockData, uint64_t& blockSize)
+{
+    const char* data = m_file.GetData();
+    const size_t fileSize = m_file.GetSize();
+
+    if ( offset % BlockAlignment != 0 || offset > fileSize || fileSize - offset < BlockHeaderSize )
+        return false;
+
+    const uint32_t compression = ReadNumber<uint32_t>(data, offset);
+    const uint64_t storedSize = ReadNumber<uint64_t>(data, offset + 8);
+    const uint64_t size = ReadNumber<uint64_t>(data, offset + 16);
+    const char* storedData = data + offset + BlockHeaderSize;
+
+    if ( storedSize > fileSize - offset - BlockHeaderSize
+         || !AreReservedBytesZero(data + offset, 4, 8)
+         || !AreReservedBytesZero(data + offset, 24, BlockHeaderSize) )
+        return false;
+
+    if ( compression == CompressionNone )
+    {
+        if ( storedSize != size )
+            return false;
+
+        blockData = storedData;
+        blockSize = size;
+        return true;
+    }
+
+    if ( compression != CompressionZlib )
+        return false;
+
+    vector<char> decompressed;
+
+    try
+    {
+        decompressed.resize(size);
+    }
+    catch ( const exception& )
+    {
+        wxLogError(_("Not enough memory to decompress %llu bytes."), static_cast<unsigned long long>(size));
+        return false;
+    }
+
+    wxMemoryInputStream compressed(storedData, storedSize);
+    wxZlibInputStream zlib(compressed, wxZLIB_ZLIB);
+
+    if ( size > 0 && !zlib.ReadAll(decompressed.data(), size) )
+        return false;
+
+    // the vector data are suitably aligned for any number type
+    m_memoryBlocks.push_back(move(decompressed));
+    blockData = m_memoryBlocks.back().data();
+    blockSize = size;
+    return true;
+}
+
+bool ChartDataFile::ReadArrow()
+{
+    ArrowReader reader;
+
+    if ( !reader.Read(m_file.GetData(), m_file.GetSize()) )
+        return false;
+
+    const vector<ArrowReader::Column>& columns = reader.GetColumns();
+
+    m_valueCount = reader.GetRowCount();
+    for ( size_t i = 0; i < columns.size(); ++i )
+    {
+        const ArrowReader::Column& column = columns[i];
+
+        switch ( column.type )
+        {
+            case ArrowReader::Float64:
+            case ArrowReader::Float32:
+            case ArrowReader::Int64:
+            {
+                const double* values = nullptr;
+
+                if ( !ReadArrowValues(column, values) )
+                    return false;
+
+                m_seriesNames.push_back(column.name.empty() ? wxString::Format(_("Column %zu"), i + 1) : column.name);
+                m_seriesTypes.push_back(ChartHelper::Line);
+                m_seriesValues.push_back(values);
+                break;
+            }
+            // the first timestamp or string column identifies the variables
+            case ArrowReader::Timestamp:
+                if ( m_variablesType == VariableIndices && !ReadArrowTimestamps(column) )
+                    return false;
+                break;
+            case ArrowReader::String:
+                if ( m_variablesType == VariableIndices )
+                {
+                    // the names were already copied from the file by the reader
+                    m_memoryBlocks.emplace_back(column.strings.begin(), column.strings.end());
+                    if ( !SetVariableNames(m_memoryBlocks.back().data(), m_memoryBlocks.back().size()) )
+                        return false;
+                }
+                break;
+            case ArrowReader::Unsupported:
+                break;
+        }
+    }
+
+    if ( m_seriesValues.empty() )
+    {
+        wxLogError(_("The Arrow data contain no float64, float32 or int64 column."));
+        return false;
+    }
+
+    return true;
+}
+
+bool ChartDataFile::ReadArrowValues(const ArrowReader::Column& column, const double*& values)
+{
+    // float64 values from a single record batch are used in place
+    if ( column.type == ArrowReader::Float64 && column.chunks.size() == 1
+         && column.chunks[0].nullCount == 0
+         && reinterpret_cast<uintptr_t>(column.chunks[0].values) % sizeof(double) == 0 )
+    {
+        values = reinterpret_cast<const double*>(column.chunks[0].values);
+        return true;
+    }
+
+    vector<char> block;
+
+    try
+    {
+        block.resize(m_valueCount * sizeof(double));
+    }
+    catch ( const exception& )
+    {
+        wxLogError(_("Not enough memory to convert column '%s'."), column.name);
+        return false;
+    }
+
+    double* converted = reinterpret_cast<double*>(block.data());
+
+    for ( const auto& chunk : column.chunks )
+    {
+        for ( size_t i = 0; i < chunk.length; ++i, ++converted )
+        {
+            if ( !ArrowReader::IsValid(chunk, i) )
+                *converted = numeric_limits<double>::quiet_NaN();
+            else if ( column.type == ArrowReader::Float64 )
+                *converted = ReadNumber<double>(chunk.values, i * sizeof(double));
+            else if ( column.type == ArrowReader::Float32 )
+                *converted = ReadNumber<float>(chunk.values, i * sizeof(float));
+            else
+                *converted = static_cast<double>(ReadNumber<int64_t>(chunk.values, i * sizeof(int64_t)));
+        }
+    }
+
+    m_memoryBlocks.push_back(move(block));
+    values = reinterpret_cast<const double*>(m_memoryBlocks.back().data());
+    return true;
+}
+
+bool ChartDataFile::ReadArrowTimestamps(const ArrowReader::Column& column)
+{
+    const int64_t* timestamps = nullptr;
+
+    // milliseconds from a single record batch are used in place
+    if ( column.unitsPerSecond == 1000 && column.chunks.size() == 1
+         && column.chunks[0].nullCount == 0
+         && reinterpret_cast<uintptr_t>(column.chunks[0].values) % sizeof(int64_t) == 0 )
+    {
+        timestamps = reinterpret_cast<const int64_t*>(column.chunks[0].values);
+    }
+    else
+    {
+        vector<char> block;
+
+        try
+        {
+            block.resize(m_valueCount * sizeof(int64_t));
+        }
+        catch ( const exception& )
+        {
+            wxLogError(_("Not enough memory to convert column '%s'."), column.name);
+            return false;
+        }
+
+        int64_t* converted = reinterpret_cast<int64_t*>(block.data());
+
+        for ( const auto& chunk : column.chunks )
+        {
+            if ( chunk.nullCount > 0 )
+            {
+                wxLogError(_("Timestamp column '%s' contains null values."), column.name);
+                return false;
+            }
+
+            for ( size_t i = 0; i < chunk.length; ++i, ++converted )
+            {
+                const int64_t value = ReadNumber<int64_t>(chunk.values, i * sizeof(int64_t));
+
+                *converted = column.unitsPerSecond < 1000 ? value * (1000 / column.unitsPerSecond)
+                                                          : value / (column.unitsPerSecond / 1000);
+            }
+        }
+
+        m_memoryBlocks.push_back(move(block));
+        timestamps = reinterpret_cast<const int64_t*>(m_memoryBlocks.back().data());
+    }
+
+    if ( !is_sorted(timestamps, timestamps + m_valueCount) )
+    {
+        wxLogError(_("Timestamp column '%s' is not in ascending order."), column.name);
+        return false;
+    }
+
+    m_variablesType = VariableTimestamps;
+    m_timestamps = timestamps;
+    return true;
+}
+
+bool ChartDataFile::Save(const wxString& fileName, const size_t valueCount,
+                         const std::vector<wxString>& variableNames, const int64_t* timestamps,
+                         const std::vector<SeriesToSave>& series, const wxString& options,
+                         const bool compress)
+{
+    wxCHECK(!series.empty(), false);
+    wxCHECK_MSG(valueCount > 0, false, "Data files without values cannot be opened");
+    wxCHECK(timestamps || variableNames.empty() || variableNames.size() == valueCount, false);
+
+    string stringTable;
+    vector<pair<uint32_t, uint32_t>> seriesNames; // offset and length
+
+    for ( const auto& s : series )
+    {
+        wxCHECK(s.values, false);
+
+        const string name = s.name.utf8_string();
+
+        seriesNames.push_back({static_cast<uint32_t>(stringTable.size()), static_cast<uint32_t>(name.size())});
+        stringTable += name;
+    }
+
+    const string optionsUTF8 = options.utf8_string();
+    const uint32_t optionsOffset = static_cast<uint32_t>(stringTable.size());
+
+    stringTable += optionsUTF8;
+
+    const size_t stringTableOffset = HeaderSize + series.size() * SeriesEntrySize;
+    const size_t firstBlockOffset = (stringTableOffset + stringTable.size() + BlockAlignment - 1)
+                                    / BlockAlignment * BlockAlignment;
+
+    // an existing file is replaced only when the new one is complete
+    const wxString tempFileName = fileName + ".tmp";
+    wxFFile file(tempFileName, "wb");
+
+    if ( !file.IsOpened() )
+        return false;
+
+    vector<char> header(firstBlockOffset, 0);
+    uint64_t variablesOffset = 0;
+    VariablesType variablesType = VariableIndices;
+    bool success = file.Write(header.data(), header.size()) == header.size();
+
+    if ( success && timestamps )
+    {
+        variablesOffset = file.Tell();
+        variablesType = VariableTimestamps;
+        success = WriteBlock(file, timestamps, valueCount * sizeof(int64_t), compress);
+    }
+    else if ( success && !variableNames.empty() )
+    {
+        string names;
+
+        names.reserve(variableNames.size() * 16);
+        for ( const auto& n : variableNames )
+        {
+            const wxScopedCharBuffer name = n.utf8_str();
+
+            names.append(name.data(), name.length());
+            names += '\0';
+        }
+
+        variablesOffset = file.Tell();
+        variablesType = VariableNames;
+        success = WriteBlock(file, names.data(), names.size(), compress);
+    }
+
+    memcpy(header.data(), DataFileMagic, 8);
+    WriteNumber<uint32_t>(header.data(), 8, DataFileVersion);
+    WriteNumber<uint32_t>(header.data(), 12, static_cast<uint32_t>(series.size()));
+    WriteNumber<uint64_t>(header.data(), 16, valueCount);
+    WriteNumber<uint64_t>(header.data(), 24, stringTableOffset);
+    WriteNumber<uint64_t>(header.data(), 32, stringTable.size());
+    WriteNumber<uint64_t>(header.data(), 40, variablesOffset);
+    WriteNumber<uint32_t>(header.data(), 48, variablesType);
+    WriteNumber<uint32_t>(header.data(), 56, optionsOffset);
+    WriteNumber<uint32_t>(header.data(), 60, static_cast<uint32_t>(optionsUTF8.size()));
+
+    for ( size_t i = 0; success && i < series.size(); ++i )
+    {
+        char* entry = header.data() + HeaderSize + i * SeriesEntrySize;
+
+        WriteNumber<uint64_t>(entry, 0, file.Tell());
+        WriteNumber<uint32_t>(entry, 8, seriesNames[i].first);
+        WriteNumber<uint32_t>(entry, 12, seriesNames[i].second);
+        WriteNumber<uint32_t>(entry, 16, ValueTypeFloat64);
+        WriteNumber<uint32_t>(entry, 20, series[i].type);
+        success = WriteBlock(file, series[i].values, valueCount * sizeof(double), compress);
+    }
+
+    memcpy(header.data() + stringTableOffset, stringTable.data(), stringTable.size());
+
+    success = success && file.Seek(0) && file.Write(header.data(), header.size()) == header.size();
+
+    if ( !file.Close() || !success )
+    {
+        wxLogError(_("Could not write file '%s'."), tempFileName);
+        wxRemoveFile(tempFileName);
+        return false;
+    }
+
+    // the index file for the previous data would be rejected anyway
+    if ( wxFileExists(GetIndexFileName(fileName)) )
+        wxRemoveFile(GetIndexFileName(fileName));
+
+    if ( !wxRenameFile(tempFileName, fileName, true) )
+    {
+        wxLogError(_("Could not replace file '%s'."), fileName);
+        wxRemoveFile(tempFileName);
+        return false;
+    }
+
+    return true;
+}
+
+bool ChartDataFile::IsMapped(const void* data) const
+{
+    const char* p = static_cast<const char*>(data);
+
+    return p >= m_file.GetData() && p < m_file.GetData() + m_file.GetSize();
+}
+
+bool ChartDataFile::LoadIndexFile()
+{
+    const wxString indexFileName = GetIndexFileName(m_fileName);
+
+    if ( !wxFileExists(indexFileName) || !m_indexFile.Open(indexFileName) )
+        return false;
+
+    const char* data = m_indexFile.GetData();
+    const size_t fileSize = m_indexFile.GetSize();
+    const vector<size_t> levelSizes = SeriesPyramid::GetLevelSizes(m_valueCount, PyramidBaseItemSize);
+    size_t itemCount = 0;
+
+    for ( const auto s : levelSizes )
+        itemCount += s;
+
+    // the index file is for another version of the data file
+    if ( fileSize != HeaderSize + m_seriesValues.size() * itemCount * sizeof(SeriesPyramid::MinMax)
+         || memcmp(data, IndexFileMagic, 8) != 0
+         || ReadNumber<uint32_t>(data, 8) != IndexFileVersion
+         || ReadNumber<uint32_t>(data, 12) != m_seriesValues.size()
+         || ReadNumber<uint64_t>(data, 16) != m_valueCount
+         || ReadNumber<uint64_t>(data, 24) != m_file.GetSize()
+         || ReadNumber<int64_t>(data, 32) != static_cast<int64_t>(m_fileModificationTime)
+         || ReadNumber<uint32_t>(data, 40) != PyramidBaseItemSize
+         || ReadNumber<uint32_t>(data, 44) != SeriesPyramid::Fanout
+         || !AreReservedBytesZero(data, 48, HeaderSize) )
+    {
+        m_indexFile.Close();
+        return false;
+    }
+
+    const SeriesPyramid::MinMax* items = reinterpret_cast<const SeriesPyramid::MinMax*>(data + HeaderSize);
+
+    m_pyramids.assign(m_seriesValues.size(), SeriesPyramid(PyramidBaseItemSize));
+    for ( auto& p : m_pyramids )
+    {
+        p.Attach(items, itemCount, m_valueCount);
+        items += itemCount;
+    }
+
+    // the pyramid levels are accessed as the chart is zoomed
+    m_indexFile.Advise(MappedFile::Random);
+    return true;
+}
+
+void ChartDataFile::BuildPyramids(std::function<void()> onPyramidsBuilt)
+{
+    m_file.Advise(MappedFile::Sequential);
+
+    for ( size_t i = 0; i < m_seriesValues.size(); ++i )
+    {
+        const double* values = m_seriesValues[i];
+        const bool mapped = IsMapped(values);
+        const size_t valuesOffset = mapped ? reinterpret_cast<const char*>(values) - m_file.GetData() : 0;
+
+        for ( size_t first = 0; first < m_valueCount; first += BuildChunkSize )
+        {
+            if ( m_cancelBuild )
+                return;
+
+            const size_t last = min(first + BuildChunkSize, m_valueCount);
+
+            m_pyramids[i].Update(values, last, first, last);
+            // keep the resident memory bounded, the pages are not needed anymore
+            if ( mapped )
+                m_file.DiscardPages(valuesOffset + first * sizeof(double), (last - first) * sizeof(double));
+        }
+    }
+
+    m_file.Advise(MappedFile::Random);
+
+    if ( !SaveIndexFile() )
+        wxLogWarning(_("Could not save the index file for '%s', it will have to be built again."), m_fileName);
+
+    m_pyramidsReady.store(true, memory_order_release);
+
+    if ( onPyramidsBuilt )
+        onPyramidsBuilt();
+}
+
+bool ChartDataFile::SaveIndexFile() const
+{
+    const wxString indexFileName = GetIndexFileName(m_fileName);
+    // truncating an existing index file would invalidate its mappings,
+    // e.g., in another instance with the same data file opened
+    const wxString tempFileName = indexFileName + ".tmp";
+    wxFFile file(tempFileName, "wb");
+
+    if ( !file.IsOpened() )
+        return false;
+
+    char header[HeaderSize] = {0};
+
+    memcpy(header, IndexFileMagic, 8);
+    WriteNumber<uint32_t>(header, 8, IndexFileVersion);
+    WriteNumber<uint32_t>(header, 12, static_cast<uint32_t>(m_seriesValues.size()));
+    WriteNumber<uint64_t>(header, 16, m_valueCount);
+    WriteNumber<uint64_t>(header, 24, m_file.GetSize());
+    WriteNumber<int64_t>(header, 32, m_fileModificationTime);
+    WriteNumber<uint32_t>(header, 40, PyramidBaseItemSize);
+    WriteNumber<uint32_t>(header, 44, SeriesPyramid::Fanout);
+
+    bool success = file.Write(header, HeaderSize) == HeaderSize;
+
+    for ( const auto& p : m_pyramids )
+    {
+        for ( size_t level = 1; success && level <= p.GetLevelCount(); ++level )
+        {
+            size_t itemCount = 0;
+            const SeriesPyramid::MinMax* items = p.GetLevelItems(level, itemCount);
+            const size_t size = itemCount * sizeof(SeriesPyramid::MinMax);
+
+            success = file.Write(items, size) == size;
+        }
+    }
+
+    if ( !file.Close() || !success || !wxRenameFile(tempFileName, indexFileName, true) )
+    {
+        wxRemoveFile(tempFileName);
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,195 @@
+///////////////////////////////////////////////////////////////////////////////
+// Project:     wxECharts
+// Home:        https://github.com/PBfordev/wxecharts
+// File Name:   chartdatafile.h
+// Purpose:     Declaration of memory-mapped chart data file
+// Author:      PB
+// Created:     2026-10-18
+// Copyright:   (c) 2026 PB
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include <wx/string.h>
+
+#include "arrowreader.h"
+#include "charthelper.h"
+#include "mappedfile.h"
+#include "seriespyramid.h"
+
+/*****************************************************************
+
+ChartDataFile
+---------------
+read-only columnar data file, which can be much larger than
+the available memory, the values are accessed directly in
+the memory-mapped file
+
+All numbers are little-endian, offsets are from the file start.
+
+Header (64 bytes)
+  0  char[8]  magic "wxECDATA"
+  8  uint32   format version (1 or 2)
+  12 uint32   number of series
+  16 uint64   number of values in each series
+  24 uint64   offset of the string table
+  32 uint64   size of the string table in bytes
+  Version 1
+  40 -        reserved, must be 0
+  Version 2
+  40 uint64   offset of the variables block, 0 if the variables
+              are identified only by their indices
+  48 uint32   variables type (1 = UTF-8 names, each terminated
+              with '\0', 2 = int64 timestamps in ms since
+              the Unix epoch, in ascending order)
+  52 -        reserved, must be 0
+  56 uint32   offset of the chart options in the string table
+  60 uint32   length of the chart options in bytes
+
+Series table, following the header (32 bytes for each series)
+  0  uint64   offset of the values (version 1) or of the values
+              block (version 2), must be a multiple of 8
+  8  uint32   offset of the name in the string table
+  12 uint32   length of the name in bytes
+  16 uint32   value type (0 = float64)
+  Version 1
+  20 -        reserved, must be 0
+  Version 2
+  20 uint32   series type (0 = bar, 1 = line)
+  24 -        reserved, must be 0
+
+String table with UTF-8 series names and chart options (JSON).
+
+Series values, each series as one contiguous block. In version 2,
+the values and variables are stored in blocks, each starting
+at an offset which is a multiple of 64 with the block header
+(32 bytes)
+  0  uint32   compression (0 = none, 1 = zlib)
+  4  -        reserved, must be 0
+  8  uint64   size of the stored data following the block header
+  16 uint64   size of the data when decompressed
+  24 -        reserved, must be 0
+
+Uncompressed blocks are used in place in the memory-mapped file,
+compressed blocks are decompressed to memory when the file
+is opened.
+
+Apache Arrow IPC files and streams (see ArrowReader) can be
+opened as well: their float64, float32 and int64 columns are
+the series and the first timestamp or string column provides
+the variables. The float64 values stored in one record batch
+are used in place, the other columns are converted to memory.
+
+The min/max pyramids for the series are built on a worker
+thread when the file is opened for the first time and then
+saved to the index file next to the data file (see
+GetIndexFileName()). The next time, the index file is just
+memory-mapped, so opening the data file is instant.
+
+******************************************************************/
+
+class ChartDataFile final
+{
+public:
+    // values aggregated by an item at the pyramid level 1,
+    // so that the pyramids are a tiny fraction of the data size
+    static constexpr size_t PyramidBaseItemSize = 4096;
+
+    enum VariablesType
+    {
+        VariableIndices,
+        VariableNames,
+        VariableTimestamps,
+    };
+
+    struct SeriesToSave
+    {
+        wxString name;
+        ChartHelper::SeriesType type;
+        const double* values;
+    };
+
+    ChartDataFile();
+    ~ChartDataFile();
+
+    // onPyramidsBuilt is called from the worker thread after the pyramids were
+    // built, it is not called when the pyramids were loaded from the index file
+    bool Open(const wxString& fileName, const std::function<void()>& onPyramidsBuilt);
+
+    const wxString& GetFileName() const;
+    size_t GetSeriesCount() const;
+    size_t GetValueCount() const;
+
+    wxString GetSeriesName(const size_t seriesIdx) const;
+    ChartHelper::SeriesType GetSeriesType(const size_t seriesIdx) const;
+    const double* GetSeriesValues(const size_t seriesIdx) const;
+
+    VariablesType GetVariablesType() const;
+    // for VariableNames
+    wxString GetVariableName(const size_t valueIdx) const;
+    // for VariableTimestamps, otherwise nullptr
+    const int64_t* GetTimestamps() const;
+
+    // the chart options (JSON) stored with the data, can be empty
+    const wxString& GetOptions() const;
+
+    // returns nullptr until the pyramids are built or loaded
+    const SeriesPyramid* GetSeriesPyramid(const size_t seriesIdx) const;
+
+    static wxString GetIndexFileName(const wxString& fileName);
+
+    // saves the data in the latest format version, variableNames are
+    // ignored if timestamps are not nullptr, both can be empty; when the file
+    // is compressed, the blocks which did not get smaller are stored uncompressed
+    static bool Save(const wxString& fileName, const size_t valueCount,
+                     const std::vector<wxString>& variableNames, const int64_t* timestamps,
+                     const std::vector<SeriesToSave>& series, const wxString& options,
+                     const bool compress);
+private:
+    wxString m_fileName;
+    time_t m_fileModificationTime{0};
+    MappedFile m_file;
+    MappedFile m_indexFile;
+
+    std::vector<wxString> m_seriesNames;
+    std::vector<ChartHelper::SeriesType> m_seriesTypes;
+    std::vector<const double*> m_seriesValues;
+    size_t m_valueCount{0};
+
+    VariablesType m_variablesType{VariableIndices};
+    // the start of each name and the end of the last one
+    std::vector<const char*> m_variableNames;
+    const int64_t* m_timestamps{nullptr};
+    wxString m_options;
+
+    // decompressed blocks and converted Arrow columns
+    std::vector<std::vector<char>> m_memoryBlocks;
+
+    std::vector<SeriesPyramid> m_pyramids;
+    std::atomic<bool> m_pyramidsReady{false};
+    std::atomic<bool> m_cancelBuild{false};
+    std::thread m_buildThread;
+
+    bool ReadHeader();
+    bool ReadVariables(const uint64_t blockOffset, const uint32_t type);
+    // the names are each terminated with '\0' and must remain valid
+    bool SetVariableNames(const char* names, const size_t size);
+    // obtains the data of the block, decompressing them if needed
+    bool ReadBlock(const uint64_t offset, const char*& blockData, uint64_t& blockSize);
+    bool IsMapped(const void* data) const;
+    bool ReadArrow();
+    bool ReadArrowValues(const ArrowReader::Column& column, const double*& values);
+    bool ReadArrowTimestamps(const ArrowReader::Column& column);
+    bool LoadIndexFile();
+    // runs in the worker thread
+    void BuildPyramids(std::function<void()> onPyramidsBuilt);
+    bool SaveIndexFile() const;
+};
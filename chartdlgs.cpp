@@ -121,6 +121,108 @@ void ChartSizingOptionsDlg::GetSizingOptions(double& widthToHeightRatio,
 }
 
 
+/*****************************************************************
+
+ChartRenderingOptionsDlg
+
+******************************************************************/
+
+ChartRenderingOptionsDlg::ChartRenderingOptionsDlg(wxWindow* parent, const bool automatic,
+                                                   const ChartHelper::RenderingOptions& options)
+    : wxDialog(parent, wxID_ANY, _("Chart Rendering Options"))
+{
+    wxBoxSizer* mainSizer = new wxBoxSizer(wxVERTICAL);
+
+    m_automaticCtrl = new wxCheckBox(this, wxID_ANY, _("Choose Automatically"));
+    m_automaticCtrl->SetValue(automatic);
+    m_automaticCtrl->Bind(wxEVT_CHECKBOX, [this](wxCommandEvent&) { UpdateControls(); });
+    mainSizer->Add(m_automaticCtrl, wxSizerFlags().Border());
+
+    wxArrayString renderers{_("Canvas"), _("SVG")};
+    m_rendererCtrl = new wxRadioBox(this, wxID_ANY, _("Renderer"),
+                                    wxDefaultPosition, wxDefaultSize, renderers);
+    m_rendererCtrl->SetSelection(options.renderer == ChartHelper::RenderingOptions::SVG ? 1 : 0);
+    mainSizer->Add(m_rendererCtrl, wxSizerFlags().Expand().Border());
+
+    mainSizer->Add(new wxStaticText(this, wxID_ANY, _("Device Pixel Ratio (0 for the display's)")),
+                   wxSizerFlags().Border(wxALL & ~wxBOTTOM));
+    m_pixelRatioCtrl = new wxSpinCtrlDouble(this, wxID_ANY, "",
+                        wxDefaultPosition, wxDefaultSize,
+                        wxSP_ARROW_KEYS | wxALIGN_RIGHT,
+                        0, 4, options.devicePixelRatio, 0.25);
+    m_pixelRatioCtrl->SetDigits(2);
+    mainSizer->Add(m_pixelRatioCtrl, wxSizerFlags().Expand().Border());
+
+    m_animationCtrl = new wxCheckBox(this, wxID_ANY, _("Animation"));
+    m_animationCtrl->SetValue(options.animation);
+    mainSizer->Add(m_animationCtrl, wxSizerFlags().Border());
+
+    m_largeCtrl = new wxCheckBox(this, wxID_ANY, _("Large Mode for Bar Series"));
+    m_largeCtrl->SetValue(options.large);
+    mainSizer->Add(m_largeCtrl, wxSizerFlags().Border());
+
+    mainSizer->Add(new wxStaticText(this, wxID_ANY, _("Large Mode Threshold")),
+                   wxSizerFlags().Border(wxALL & ~wxBOTTOM));
+    m_largeThresholdCtrl = new wxSpinCtrl(this, wxID_ANY, "",
+                        wxDefaultPosition, wxDefaultSize,
+                        wxSP_ARROW_KEYS | wxALIGN_RIGHT,
+                        1, 10000000, static_cast<int>(options.largeThreshold));
+    m_largeThresholdCtrl->SetIncrement(1000);
+    mainSizer->Add(m_largeThresholdCtrl, wxSizerFlags().Expand().Border());
+
+    m_samplingCtrl = new wxCheckBox(this, wxID_ANY, _("LTTB Sampling of Line Series"));
+    m_samplingCtrl->SetValue(options.sampling);
+    mainSizer->Add(m_samplingCtrl, wxSizerFlags().Border());
+
+    mainSizer->Add(new wxStaticText(this, wxID_ANY, _("Values Drawn per Frame (0 for all)")),
+                   wxSizerFlags().Border(wxALL & ~wxBOTTOM));
+    m_progressiveCtrl = new wxSpinCtrl(this, wxID_ANY, "",
+                        wxDefaultPosition, wxDefaultSize,
+                        wxSP_ARROW_KEYS | wxALIGN_RIGHT,
+                        0, 10000000, static_cast<int>(options.progressive));
+    m_progressiveCtrl->SetIncrement(1000);
+    mainSizer->Add(m_progressiveCtrl, wxSizerFlags().Expand().Border());
+
+    mainSizer->AddSpacer(FromDIP(8));
+    mainSizer->Add(CreateStdDialogButtonSizer(wxOK | wxCANCEL), wxSizerFlags().Expand().Border());
+    SetSizerAndFit(mainSizer);
+
+    UpdateControls();
+}
+
+bool ChartRenderingOptionsDlg::IsAutomatic() const
+{
+    return m_automaticCtrl->GetValue();
+}
+
+ChartHelper::RenderingOptions ChartRenderingOptionsDlg::GetRenderingOptions() const
+{
+    ChartHelper::RenderingOptions options;
+
+    options.renderer = m_rendererCtrl->GetSelection() == 1 ? ChartHelper::RenderingOptions::SVG
+                                                           : ChartHelper::RenderingOptions::Canvas;
+    options.devicePixelRatio = m_pixelRatioCtrl->GetValue();
+    options.animation = m_animationCtrl->GetValue();
+    options.large = m_largeCtrl->GetValue();
+    options.largeThreshold = static_cast<size_t>(m_largeThresholdCtrl->GetValue());
+    options.sampling = m_samplingCtrl->GetValue();
+    options.progressive = static_cast<size_t>(m_progressiveCtrl->GetValue());
+    return options;
+}
+
+void ChartRenderingOptionsDlg::UpdateControls()
+{
+    const bool enable = !m_automaticCtrl->GetValue();
+
+    m_rendererCtrl->Enable(enable);
+    m_pixelRatioCtrl->Enable(enable);
+    m_animationCtrl->Enable(enable);
+    m_largeCtrl->Enable(enable);
+    m_largeThresholdCtrl->Enable(enable);
+    m_samplingCtrl->Enable(enable);
+    m_progressiveCtrl->Enable(enable);
+}
+
 /*****************************************************************
 
 ChartDataPropertiesDlg
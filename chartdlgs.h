@@ -15,8 +15,12 @@
 
 #include <vector>
 
+#include "charthelper.h"
+
+class wxCheckBox;
 class wxColour;
 class wxColourPickerCtrl;
+class wxRadioBox;
 class wxSpinCtrl;
 class wxSpinCtrlDouble;
 
@@ -60,6 +64,34 @@ private:
 
 /*****************************************************************
 
+ChartRenderingOptionsDlg
+------------------------
+show/change how the chart is rendered or let it be chosen automatically
+
+******************************************************************/
+class ChartRenderingOptionsDlg : public wxDialog
+{
+public:
+    ChartRenderingOptionsDlg(wxWindow* parent, const bool automatic,
+                             const ChartHelper::RenderingOptions& options);
+
+    bool IsAutomatic() const;
+    ChartHelper::RenderingOptions GetRenderingOptions() const;
+private:
+    wxCheckBox* m_automaticCtrl{nullptr};
+    wxRadioBox* m_rendererCtrl{nullptr};
+    wxSpinCtrlDouble* m_pixelRatioCtrl{nullptr};
+    wxCheckBox* m_animationCtrl{nullptr};
+    wxCheckBox* m_largeCtrl{nullptr};
+    wxSpinCtrl* m_largeThresholdCtrl{nullptr};
+    wxCheckBox* m_samplingCtrl{nullptr};
+    wxSpinCtrl* m_progressiveCtrl{nullptr};
+
+    void UpdateControls();
+};
+
+/*****************************************************************
+
 ChartDataPropertiesDlg
 ----------------------
 show/change the series and variable names and series type
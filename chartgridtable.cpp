@@ -0,0 +1,120 @@
+///////////////////////////////////////////////////////////////////////////////
+// Project:     wxECharts
+// Home:        https://github.com/PBfordev/wxecharts
+// File Name:   chartgridtable.cpp
+// Purpose:     Implementation of grid table showing the chart data
+// Author:      PB
+// Created:     2026-10-18
+// Copyright:   (c) 2026 PB
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#include <wx/wx.h>
+#include <wx/grid.h>
+
+#include <algorithm>
+#include <climits>
+
+#include "charthelper.h"
+#include "chartgridtable.h"
+
+ChartGridTable::ChartGridTable(ChartHelper& chartHelper)
+    : m_chartHelper(chartHelper)
+{}
+
+int ChartGridTable::GetNumberRows()
+{
+    // a data file can have more variables than wxGrid can show
+    return static_cast<int>(std::min<size_t>(m_chartHelper.GetVariableNamesCount(), INT_MAX));
+}
+
+int ChartGridTable::GetNumberCols()
+{
+    return static_cast<int>(m_chartHelper.GetSeriesCount());
+}
+
+wxString ChartGridTable::GetValue(int row, int col)
+{
+    double value;
+
+    if ( m_chartHelper.GetSeriesValue(col, row, value) )
+        return wxString::FromDouble(value);
+    return wxString();
+}
+
+void ChartGridTable::SetValue(int row, int col, const wxString& value)
+{
+    double d;
+
+    if ( value.ToDouble(&d) )
+        m_chartHelper.SetSeriesValue(col, row, d);
+}
+
+wxString ChartGridTable::GetRowLabelValue(int row)
+{
+    wxString name;
+
+    m_chartHelper.GetVariableName(row, name);
+    return name;
+}
+
+wxString ChartGridTable::GetColLabelValue(int col)
+{
+    wxString name;
+
+    m_chartHelper.GetSeriesName(col, name);
+    return name;
+}
+
+void ChartGridTable::NotifyRowsAppended(const size_t count)
+{
+    if ( !GetView() )
+        return;
+
+    wxGridTableMessage msg(this, wxGRIDTABLE_NOTIFY_ROWS_APPENDED, static_cast<int>(count));
+
+    GetView()->ProcessTableMessage(msg);
+}
+
+void ChartGridTable::NotifyLiveValuesPushed()
+{
+    wxGrid* grid = GetView();
+
+    if ( !grid )
+        return;
+
+    const int rowCount = GetNumberRows();
+
+    if ( rowCount > grid->GetNumberRows() )
+    {
+        wxGridTableMessage msg(this, wxGRIDTABLE_NOTIFY_ROWS_APPENDED, rowCount - grid->GetNumberRows());
+        grid->ProcessTableMessage(msg);
+    }
+
+    grid->ForceRefresh();
+}
+
+void ChartGridTable::NotifyDataReplaced()
+{
+    wxGrid* grid = GetView();
+
+    if ( !grid )
+        return;
+
+    if ( grid->GetNumberRows() > 0 )
+    {
+        wxGridTableMessage msg(this, wxGRIDTABLE_NOTIFY_ROWS_DELETED, 0, grid->GetNumberRows());
+        grid->ProcessTableMessage(msg);
+    }
+    if ( grid->GetNumberCols() > 0 )
+    {
+        wxGridTableMessage msg(this, wxGRIDTABLE_NOTIFY_COLS_DELETED, 0, grid->GetNumberCols());
+        grid->ProcessTableMessage(msg);
+    }
+
+    wxGridTableMessage rowsMsg(this, wxGRIDTABLE_NOTIFY_ROWS_APPENDED, GetNumberRows());
+    grid->ProcessTableMessage(rowsMsg);
+
+    wxGridTableMessage colsMsg(this, wxGRIDTABLE_NOTIFY_COLS_APPENDED, GetNumberCols());
+    grid->ProcessTableMessage(colsMsg);
+}
@@ -0,0 +1,51 @@
+///////////////////////////////////////////////////////////////////////////////
+// Project:     wxECharts
+// Home:        https://github.com/PBfordev/wxecharts
+// File Name:   chartgridtable.h
+// Purpose:     Declaration of grid table showing the chart data
+// Author:      PB
+// Created:     2026-10-18
+// Copyright:   (c) 2026 PB
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <wx/grid.h>
+
+class ChartHelper;
+
+/*****************************************************************
+
+ChartGridTable
+---------------
+virtual grid table with rows being the chart variables and
+columns the chart series, obtaining the values directly from
+ChartHelper, so that the grid does not store a copy of the data
+
+******************************************************************/
+
+class ChartGridTable : public wxGridTableBase
+{
+public:
+    ChartGridTable(ChartHelper& chartHelper);
+
+    int GetNumberRows() override;
+    int GetNumberCols() override;
+
+    wxString GetValue(int row, int col) override;
+    void SetValue(int row, int col, const wxString& value) override;
+
+    wxString GetRowLabelValue(int row) override;
+    wxString GetColLabelValue(int col) override;
+
+    // must be called after rows were appended to the chart helper
+    void NotifyRowsAppended(const size_t count);
+    // must be called after all the chart helper data were replaced
+    void NotifyDataReplaced();
+    // must be called after the values were pushed to the live series,
+    // which changes the values in all rows once the capacity is reached
+    void NotifyLiveValuesPushed();
+private:
+    ChartHelper& m_chartHelper;
+};
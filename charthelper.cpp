@@ -11,19 +11,74 @@
 
 
 #include <wx/wx.h>
+#include <wx/datetime.h>
+#include <wx/filename.h>
 #include <wx/webview.h>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <mutex>
+#include <string>
 #include <utility>
 
 #include <json.hpp>
 
+#include "chartdatafile.h"
 #include "charthelper.h"
+#include "chartsnapshot.h"
+#include "contenthash.h"
+#include "jsonwriter.h"
+#include "sharedringbuffer.h"
+#include "taskpool.h"
+#include "updatepipeline.h"
 
 using namespace std;
 
 using json = nlohmann::ordered_json;
 
+// the buffers for serializing one chart update
+struct ChartHelper::SerializeBuffers
+{
+    // the serialized series and then the timestamps
+    vector<string> items;
+    // the script
+    string payload;
+};
+
+// shared by the threads serializing the series updates
+struct ChartHelper::SerializeContext
+{
+    mutex buffersMutex;
+    // the buffers not in use keep their capacity for the next updates
+    vector<unique_ptr<SerializeBuffers>> freeBuffers;
+
+    unique_ptr<SerializeBuffers> AcquireBuffers()
+    {
+        lock_guard<mutex> lock(buffersMutex);
+
+        if ( freeBuffers.empty() )
+            return unique_ptr<SerializeBuffers>(new SerializeBuffers);
+
+        unique_ptr<SerializeBuffers> buffers(move(freeBuffers.back()));
+
+        freeBuffers.pop_back();
+        return buffers;
+    }
+
+    void ReleaseBuffers(unique_ptr<SerializeBuffers>&& buffers)
+    {
+        lock_guard<mutex> lock(buffersMutex);
+
+        freeBuffers.push_back(move(buffers));
+    }
+};
+
 ChartHelper::ChartHelper()
+    : m_serializeContext(new SerializeContext)
+{}
+
+ChartHelper::~ChartHelper()
 {}
 
 void ChartHelper::SetWebView(wxWebView* webView)
@@ -32,15 +87,116 @@ void ChartHelper::SetWebView(wxWebView* webView)
     m_webView = webView;
 }
 
+bool ChartHelper::OpenDataFile(const wxString& fileName, const std::function<void()>& onLODReady)
+{
+    unique_ptr<ChartDataFile> dataFile(new ChartDataFile);
+
+    if ( !dataFile->Open(fileName, onLODReady) )
+        return false;
+
+    Clear();
+
+    for ( size_t i = 0; i < dataFile->GetSeriesCount(); ++i )
+    {
+        ValueSeries s;
+
+        s.name = dataFile->GetSeriesName(i);
+        s.type = dataFile->GetSeriesType(i);
+        m_series.push_back(move(s));
+    }
+
+    m_dataFile = move(dataFile);
+    return true;
+}
+
+bool ChartHelper::HasDataFile() const
+{
+    return m_dataFile != nullptr;
+}
+
+bool ChartHelper::SaveDataFile(const wxString& fileName, const wxString& options, const bool compress) const
+{
+    wxCHECK_MSG(!m_live, false, "Live data cannot be saved");
+    wxCHECK_MSG(!m_series.empty(), false, "No data to save");
+
+    // the values are saved from the file, which cannot be replaced while it is
+    // mapped on MSW; it could be replaced elsewhere but the chart would then
+    // show the data of a deleted file
+    if ( m_dataFile && wxFileName(fileName).SameAs(wxFileName(m_dataFile->GetFileName())) )
+    {
+        wxLogError(_("The data file '%s' is opened, the data cannot be saved over it."), fileName);
+        return false;
+    }
+
+    vector<ChartDataFile::SeriesToSave> series;
+    vector<wxString> dataFileVariableNames;
+    const vector<wxString>* variableNames = &m_variableNames;
+
+    for ( size_t i = 0; i < m_series.size(); ++i )
+        series.push_back({m_series[i].name, m_series[i].type, GetValues(i)});
+
+    // the names in a data file are not stored as wxString
+    if ( m_dataFile && HasVariableNames() )
+    {
+        dataFileVariableNames.resize(GetVariableNamesCount());
+        for ( size_t i = 0; i < dataFileVariableNames.size(); ++i )
+            GetVariableName(i, dataFileVariableNames[i]);
+        variableNames = &dataFileVariableNames;
+    }
+
+    return ChartDataFile::Save(fileName, GetVariableNamesCount(), *variableNames,
+                               IsTimeMode() ? GetTimestamps() : nullptr, series, options, compress);
+}
+
+wxString ChartHelper::GetDataFileOptions() const
+{
+    wxCHECK(m_dataFile, wxString());
+    return m_dataFile->GetOptions();
+}
+
+void ChartHelper::Clear()
+{
+    m_variableNames.clear();
+    m_timestamps.clear();
+    m_series.clear();
+    m_pyramids.clear();
+    m_dataFile.reset();
+    m_live.reset();
+    CancelSeriesUpdates();
+    m_LODLast = 0;
+    m_snapshotChanged = true;
+    m_snapshotDataReplaced = true;
+}
+
 size_t ChartHelper::GetVariableNamesCount() const
 {
+    if ( m_dataFile )
+        return m_dataFile->GetValueCount();
+    if ( m_live )
+        return m_live->timestamps.GetSize();
+    if ( IsTimeMode() )
+        return m_timestamps.size();
     return m_variableNames.size();
 }
 
 bool ChartHelper::GetVariableName(const size_t nameIdx, wxString& name) const
 {
-    wxCHECK(nameIdx < m_variableNames.size(), false);
-    name = m_variableNames[nameIdx];
+    wxCHECK(nameIdx < GetVariableNamesCount(), false);
+
+    if ( m_dataFile && m_dataFile->GetVariablesType() == ChartDataFile::VariableNames )
+        name = m_dataFile->GetVariableName(nameIdx);
+    else if ( IsTimeMode() || m_live )
+    {
+        int64_t timestamp = 0;
+
+        GetTimestamp(nameIdx, timestamp);
+        name = FormatTimestamp(timestamp);
+    }
+    // variables in a data file can be identified only by their index
+    else if ( m_dataFile )
+        name.Printf("%zu", nameIdx);
+    else
+        name = m_variableNames[nameIdx];
     return true;
 }
 
@@ -51,18 +207,23 @@ vector<wxString> ChartHelper::GetVariableNames() const
 
 bool ChartHelper::AddVariableName(const wxString& name)
 {
+    wxCHECK_MSG(!m_dataFile, false, "Data file cannot be modified");
+    wxCHECK_MSG(!IsTimeMode(), false, "Variables in time mode have no names");
     wxCHECK_MSG(!m_series.empty(), false, "Adding variable name after adding a series");
 
     for ( const auto& n : m_variableNames)
         wxCHECK_MSG(!n.IsSameAs(name, true), false, "Variable name already used");
 
     m_variableNames.push_back(name);
+    SetSnapshotChanged();
     return true;
 }
 
 bool  ChartHelper::AddVariableNames(const std::vector<wxString>& names)
 {
     wxCHECK(!names.empty(), false);
+    wxCHECK_MSG(!m_dataFile, false, "Data file cannot be modified");
+    wxCHECK_MSG(!IsTimeMode(), false, "Variables in time mode have no names");
     wxCHECK_MSG(m_series.empty(), false, "Adding variable name after adding a series");
 
     for ( const auto& vn : m_variableNames)
@@ -72,12 +233,14 @@ bool  ChartHelper::AddVariableNames(const std::vector<wxString>& names)
     }
 
     m_variableNames.insert(m_variableNames.end(), names.begin(), names.end());
+    SetSnapshotChanged();
     return true;
 }
 
 bool ChartHelper::SetVariableName(const size_t nameIdx, const wxString& name)
 {
     wxCHECK(!name.empty(), false);
+    wxCHECK_MSG(!m_dataFile, false, "Data file cannot be modified");
     wxCHECK(nameIdx < m_variableNames.size(), false);
 
     for ( size_t i = 0; i < m_variableNames.size(); ++i )
@@ -88,9 +251,277 @@ bool ChartHelper::SetVariableName(const size_t nameIdx, const wxString& name)
     }
 
     m_variableNames[nameIdx] = name;
+    m_snapshotChangedNames.Add(nameIdx, nameIdx + 1);
+    SetSnapshotChanged();
+    return true;
+}
+
+bool ChartHelper::HasVariableNames() const
+{
+    if ( m_dataFile )
+        return m_dataFile->GetVariablesType() == ChartDataFile::VariableNames;
+    return !m_live && !IsTimeMode();
+}
+
+bool ChartHelper::AddTimestamps(const std::vector<int64_t>& timestamps)
+{
+    wxCHECK(!timestamps.empty(), false);
+    wxCHECK_MSG(!m_dataFile, false, "Data file cannot be modified");
+    wxCHECK_MSG(!m_live, false, "Live series can only be pushed to");
+    wxCHECK_MSG(m_variableNames.empty(), false, "Adding timestamps after adding variable names");
+    wxCHECK_MSG(m_series.empty(), false, "Adding timestamps after adding a series");
+    wxCHECK_MSG(is_sorted(timestamps.begin(), timestamps.end()), false, "Timestamps are not sorted");
+    wxCHECK_MSG(m_timestamps.empty() || m_timestamps.back() <= timestamps.front(), false, "Timestamps are not sorted");
+
+    m_timestamps.insert(m_timestamps.end(), timestamps.begin(), timestamps.end());
+    SetSnapshotChanged();
+    return true;
+}
+
+bool ChartHelper::IsTimeMode() const
+{
+    if ( m_dataFile )
+        return m_dataFile->GetVariablesType() == ChartDataFile::VariableTimestamps;
+    return !m_timestamps.empty();
+}
+
+const int64_t* ChartHelper::GetTimestamps() const
+{
+    if ( m_dataFile )
+        return m_dataFile->GetTimestamps();
+    return m_timestamps.data();
+}
+
+bool ChartHelper::GetTimestamp(const size_t idx, int64_t& timestamp) const
+{
+    if ( m_live )
+    {
+        wxCHECK(idx < m_live->timestamps.GetSize(), false);
+        timestamp = m_live->timestamps[idx];
+        return true;
+    }
+
+    wxCHECK(IsTimeMode(), false);
+    wxCHECK(idx < GetVariableNamesCount(), false);
+    timestamp = GetTimestamps()[idx];
+    return true;
+}
+
+void ChartHelper::FindTimeRange(const int64_t start, const int64_t end, size_t& first, size_t& last) const
+{
+    const int64_t* timestamps = GetTimestamps();
+    const size_t count = IsTimeMode() ? GetVariableNamesCount() : 0;
+
+    first = lower_bound(timestamps, timestamps + count, start) - timestamps;
+    last = upper_bound(timestamps + first, timestamps + count, end) - timestamps;
+}
+
+bool ChartHelper::StartLiveMode(const size_t capacity, const std::vector<wxString>& seriesNames,
+                                const SeriesType type)
+{
+    wxCHECK(capacity > 0, false);
+    wxCHECK(!seriesNames.empty(), false);
+
+    for ( size_t i = 0; i < seriesNames.size(); ++i )
+    {
+        wxCHECK(!seriesNames[i].empty(), false);
+        for ( size_t j = i + 1; j < seriesNames.size(); ++j )
+            wxCHECK_MSG(!seriesNames[i].IsSameAs(seriesNames[j], true), false, "Series name already used");
+    }
+
+    Clear();
+
+    unique_ptr<LiveData> live(new LiveData);
+
+    live->timestamps = RingBuffer<int64_t>(capacity);
+    for ( const auto& n : seriesNames )
+    {
+        ValueSeries s;
+
+        s.name = n;
+        s.type = type;
+        m_series.push_back(move(s));
+        m_pyramids.emplace_back();
+        live->values.emplace_back(capacity);
+    }
+
+    m_live = move(live);
+    return true;
+}
+
+void ChartHelper::StopLiveMode()
+{
+    if ( !m_live )
+        return;
+
+    const unique_ptr<LiveData> live = move(m_live);
+    vector<ValueSeries> series = move(m_series);
+    const size_t count = live->timestamps.GetSize();
+
+    Clear();
+    if ( count == 0 )
+        return;
+
+    m_timestamps.reserve(count);
+    for ( size_t i = 0; i < count; ++i )
+        m_timestamps.push_back(live->timestamps[i]);
+
+    m_series = move(series);
+    m_pyramids.resize(m_series.size());
+    for ( size_t s = 0; s < m_series.size(); ++s )
+    {
+        vector<double>& data = m_series[s].data;
+
+        data.clear();
+        data.reserve(count);
+        for ( size_t i = 0; i < count; ++i )
+            data.push_back(live->values[s][i]);
+        m_pyramids[s].Build(data.data(), data.size());
+    }
+}
+
+bool ChartHelper::IsLiveMode() const
+{
+    return m_live != nullptr;
+}
+
+size_t ChartHelper::GetLiveCapacity() const
+{
+    wxCHECK(m_live, 0);
+    return m_live->timestamps.GetCapacity();
+}
+
+bool ChartHelper::PushLiveValues(const int64_t timestamp, const std::vector<double>& values)
+{
+    wxCHECK_MSG(m_live, false, "Values can be pushed only in live mode");
+    wxCHECK_MSG(values.size() == m_series.size(), false, "Values must be pushed to all series");
+    wxCHECK_MSG(m_live->timestamps.IsEmpty() || m_live->timestamps.GetNewest() <= timestamp,
+                false, "Timestamps are not sorted");
+
+    PushLiveRow(timestamp, values.data());
+    return true;
+}
+
+void ChartHelper::PushLiveRow(const int64_t timestamp, const double* values)
+{
+    m_live->timestamps.Push(timestamp);
+    for ( size_t i = 0; i < m_live->values.size(); ++i )
+        m_live->values[i].Push(values[i]);
+
+    // older values pushed since the last update were already evicted
+    m_live->pushedCount = min(m_live->pushedCount + 1, m_live->timestamps.GetCapacity());
+    SetSnapshotChanged();
+}
+
+bool ChartHelper::AddLiveSeries(const wxString& name, const SeriesType type)
+{
+    wxCHECK_MSG(m_live, false, "Live series can be added only in live mode");
+    wxCHECK(!name.empty(), false);
+
+    for ( const auto& s : m_series )
+        wxCHECK_MSG(!s.name.IsSameAs(name, true), false, "Series name already used");
+
+    RingBuffer<double> values(m_live->timestamps.GetCapacity());
+
+    for ( size_t i = 0; i < m_live->timestamps.GetSize(); ++i )
+        values.Push(numeric_limits<double>::quiet_NaN());
+
+    ValueSeries s;
+
+    s.name = name;
+    s.type = type;
+    m_series.push_back(move(s));
+    m_pyramids.emplace_back();
+    m_live->values.push_back(move(values));
+    // the chart must get all the series again
+    m_live->chartInitialized = false;
+    SetSnapshotChanged();
+    return true;
+}
+
+bool ChartHelper::AttachSharedRingBuffer(const wxString& name, const size_t capacity)
+{
+    unique_ptr<SharedRingBuffer> buffer(new SharedRingBuffer);
+
+    if ( !buffer->Attach(name) )
+        return false;
+
+    if ( !StartLiveMode(capacity > 0 ? capacity : buffer->GetCapacity(), buffer->GetSeriesNames()) )
+        return false;
+
+    m_live->sharedRingBuffer = move(buffer);
     return true;
 }
 
+void ChartHelper::DetachSharedRingBuffer()
+{
+    if ( m_live )
+        m_live->sharedRingBuffer.reset();
+}
+
+const SharedRingBuffer* ChartHelper::GetSharedRingBuffer() const
+{
+    return m_live ? m_live->sharedRingBuffer.get() : nullptr;
+}
+
+size_t ChartHelper::ReadSharedRingBuffer()
+{
+    wxCHECK(m_live && m_live->sharedRingBuffer, 0);
+
+    LiveData& live = *m_live;
+    size_t pushedCount = 0;
+
+    // the values are pushed from the copy of each row the reader made
+    // and checked that it was not overwritten meanwhile, and only
+    // as many as can fit into the live series are read at all
+    live.sharedRingBuffer->ReadNewRows(live.timestamps.GetCapacity(),
+        [&live, &pushedCount, this](const int64_t timestamp, const double* values)
+        {
+            if ( !live.timestamps.IsEmpty() && timestamp < live.timestamps.GetNewest() )
+                return;
+            PushLiveRow(timestamp, values);
+            ++pushedCount;
+        });
+
+    return pushedCount;
+}
+
+size_t ChartHelper::GetNearestVariableIdx(const double xValue) const
+{
+    const size_t count = GetVariableNamesCount();
+
+    if ( count == 0 )
+        return 0;
+
+    // a variable index, timestamps can be negative
+    if ( !IsTimeMode() && !m_live )
+        return xValue <= 0 ? 0 : min(static_cast<size_t>(llround(xValue)), count - 1);
+
+    // the live ring buffer has no iterators, so the search is done by index
+    const int64_t* timestamps = GetTimestamps();
+    auto TimestampAt = [this, timestamps](const size_t idx) -> int64_t
+        { return m_live ? m_live->timestamps[idx] : timestamps[idx]; };
+    const int64_t timestamp = llround(xValue);
+    size_t idx = 0;
+    size_t last = count;
+
+    while ( idx < last )
+    {
+        const size_t middle = idx + (last - idx) / 2;
+
+        if ( TimestampAt(middle) < timestamp )
+            idx = middle + 1;
+        else
+            last = middle;
+    }
+
+    if ( idx == count )
+        return count - 1;
+    if ( idx > 0 && timestamp - TimestampAt(idx - 1) < TimestampAt(idx) - timestamp )
+        return idx - 1;
+    return idx;
+}
+
 size_t ChartHelper::GetSeriesCount() const
 {
     return m_series.size();
@@ -98,14 +529,20 @@ size_t ChartHelper::GetSeriesCount() const
 
 bool ChartHelper::AddSeries(const ValueSeries& series)
 {
-    wxCHECK_MSG(!m_variableNames.empty(), false, "Adding series before adding variable names");
+    wxCHECK_MSG(!m_dataFile, false, "Data file cannot be modified");
+    wxCHECK_MSG(!m_live, false, "Live series can only be pushed to");
+    wxCHECK_MSG(GetVariableNamesCount() > 0, false, "Adding series before adding variable names or timestamps");
     wxCHECK(!series.name.empty(), false);
-    wxCHECK(series.data.size() == m_variableNames.size(), false);
+    wxCHECK(series.data.size() == GetVariableNamesCount(), false);
+    wxCHECK(series.precision.IsValid(), false);
 
     for ( const auto& s : m_series )
         wxCHECK_MSG(!s.name.IsSameAs(series.name, true), false, "Series name already used");
 
     m_series.push_back(series);
+    m_pyramids.emplace_back();
+    m_pyramids.back().Build(m_series.back().data.data(), m_series.back().data.size());
+    SetSnapshotChanged();
     return true;
 }
 
@@ -140,6 +577,9 @@ bool ChartHelper::SetSeriesName(const size_t seriesIdx, const wxString& name)
     }
 
     m_series[seriesIdx].name = name;
+    if ( m_live )
+        m_live->chartInitialized = false;
+    SetSnapshotChanged();
     return true;
 }
 
@@ -154,12 +594,46 @@ bool ChartHelper::SetSeriesType(const size_t seriesIdx, const SeriesType& type)
 {
     wxCHECK(seriesIdx < m_series.size(), false);
     m_series[seriesIdx].type = type;
+    if ( m_live )
+        m_live->chartInitialized = false;
+    SetSnapshotChanged();
+    return true;
+}
+
+bool ChartHelper::GetSeriesPrecision(const size_t seriesIdx, ValuePrecision& precision) const
+{
+    wxCHECK(seriesIdx < m_series.size(), false);
+    precision = m_series[seriesIdx].precision;
+    return true;
+}
+
+bool ChartHelper::SetSeriesPrecision(const size_t seriesIdx, const ValuePrecision& precision)
+{
+    wxCHECK(seriesIdx < m_series.size(), false);
+    wxCHECK(precision.IsValid(), false);
+    m_series[seriesIdx].precision = precision;
+    // the live chart gets all the values again with the new precision
+    if ( m_live )
+        m_live->chartInitialized = false;
+    SetSnapshotChanged();
     return true;
 }
 
 bool ChartHelper::GetSeriesData(const size_t seriesIdx, std::vector<double>& data) const
 {
     wxCHECK(seriesIdx < m_series.size(),false);
+    wxCHECK_MSG(!m_dataFile, false, "Data file is too large to be copied");
+
+    if ( m_live )
+    {
+        const RingBuffer<double>& values = m_live->values[seriesIdx];
+
+        data.resize(values.GetSize());
+        for ( size_t i = 0; i < values.GetSize(); ++i )
+            data[i] = values[i];
+        return true;
+    }
+
     data = m_series[seriesIdx].data;
     return true;
 }
@@ -167,143 +641,1131 @@ bool ChartHelper::GetSeriesData(const size_t seriesIdx, std::vector<double>& dat
 bool ChartHelper::SetSeriesData(const size_t seriesIdx, const std::vector<double>& data)
 {
     wxCHECK(seriesIdx < m_series.size(), false);
-    wxCHECK(data.size() == m_variableNames.size(), false);
-    m_series[seriesIdx].data = data;
+    wxCHECK_MSG(!m_dataFile, false, "Data file cannot be modified");
+    wxCHECK_MSG(!m_live, false, "Live series can only be pushed to");
+    wxCHECK(data.size() == GetVariableNamesCount(), false);
+
+    vector<double>& seriesData = m_series[seriesIdx].data;
+    const auto firstDiff = mismatch(seriesData.begin(), seriesData.end(), data.begin());
+
+    if ( firstDiff.first == seriesData.end() )
+        return true;
+
+    const size_t first = firstDiff.first - seriesData.begin();
+    const auto lastDiff = mismatch(seriesData.rbegin(), seriesData.rend(), data.rbegin());
+    const size_t last = seriesData.rend() - lastDiff.first;
+
+    seriesData = data;
+    m_pyramids[seriesIdx].Update(seriesData.data(), seriesData.size(), first, last);
+    SetSnapshotValuesChanged(seriesIdx, first, last);
     return true;
 }
 
-void ChartHelper::RunChartCreate()
+bool ChartHelper::GetSeriesValue(const size_t seriesIdx, const size_t valueIdx, double& value) const
 {
-    wxCHECK_RET(m_webView, "m_webView is null");
-    m_webView->RunScriptAsync("wxEChartsCreateChart('chart');", (void*)CreateChart);
+    wxCHECK(seriesIdx < m_series.size(), false);
+    wxCHECK(valueIdx < GetVariableNamesCount(), false);
+
+    if ( m_live )
+        value = m_live->values[seriesIdx][valueIdx];
+    else
+        value = GetValues(seriesIdx)[valueIdx];
+    return true;
 }
 
-void ChartHelper::RunChartUpdateSeries()
+bool ChartHelper::SetSeriesValue(const size_t seriesIdx, const size_t valueIdx, const double value)
 {
-    wxCHECK_RET(m_webView, "m_webView is null");
-    wxCHECK_RET(!m_series.empty(), "m_series is empty");
+    wxCHECK(seriesIdx < m_series.size(), false);
+    wxCHECK_MSG(!m_dataFile, false, "Data file cannot be modified");
+    wxCHECK_MSG(!m_live, false, "Live series can only be pushed to");
 
-    wxString script;
+    vector<double>& seriesData = m_series[seriesIdx].data;
 
-    try
-    {
-        vector<json> allSeriesJSON;
+    wxCHECK(valueIdx < seriesData.size(), false);
+    seriesData[valueIdx] = value;
+    m_pyramids[seriesIdx].Update(seriesData.data(), seriesData.size(), valueIdx, valueIdx + 1);
+    SetSnapshotValuesChanged(seriesIdx, valueIdx, valueIdx + 1);
+    return true;
+}
 
-        for ( const auto& s : m_series )
-        {
-            json oneSeriesJSON;
-
-            oneSeriesJSON["name"] = s.name.utf8_string();
-            if ( s.type == Bar )
-                oneSeriesJSON["type"] = "bar";
-            else
-                oneSeriesJSON["type"] = "line";
-            oneSeriesJSON["data"] = s.data;
-            allSeriesJSON.push_back(oneSeriesJSON);
-        }
+bool ChartHelper::AppendData(const std::vector<wxString>& variableNames,
+                             const std::vector<std::vector<double>>& seriesData)
+{
+    wxCHECK(!variableNames.empty(), false);
+    wxCHECK_MSG(!m_dataFile, false, "Data file cannot be modified");
+    wxCHECK_MSG(!m_live, false, "Live series can only be pushed to");
+    wxCHECK_MSG(!IsTimeMode(), false, "Variables in time mode have no names");
 
-        json j;
+    const size_t oldCount = m_variableNames.size();
 
-        j["series"] = allSeriesJSON;
-        script.Printf("wxEChartsUpdateSeries('%s');", wxString::FromUTF8(j.dump()));
-    }
-    catch (const json::exception& e)
+    if ( !AppendSeriesData(variableNames.size(), seriesData) )
+        return false;
+
+    // checking the names for uniqueness would be too expensive
+    // with the number of variables requiring level of detail
+    m_variableNames.insert(m_variableNames.end(), variableNames.begin(), variableNames.end());
+
+    // keep showing the newest data if the visible range included them
+    if ( m_LODLast == oldCount )
     {
-        wxLogError(_("JSON error in %s (%s)."), __FUNCTION__, e.what());
-        return;
+        m_LODLast = m_variableNames.size();
+        m_LODWindowSynced = false;
     }
 
-    m_webView->RunScriptAsync(script, (void*)UpdateSeries);
+    return true;
 }
 
-void ChartHelper::RunChartUpdateVariableNames()
+bool ChartHelper::AppendData(const std::vector<int64_t>& timestamps,
+                             const std::vector<std::vector<double>>& seriesData)
 {
-    wxCHECK_RET(m_webView, "m_webView is null");
-    wxCHECK_RET(!m_variableNames.empty(), "m_variableNames is empty");
+    wxCHECK(!timestamps.empty(), false);
+    wxCHECK_MSG(!m_dataFile, false, "Data file cannot be modified");
+    wxCHECK_MSG(!m_live, false, "Live series can only be pushed to");
+    wxCHECK_MSG(IsTimeMode(), false, "Appending timestamps when not in time mode");
+    wxCHECK_MSG(is_sorted(timestamps.begin(), timestamps.end()), false, "Timestamps are not sorted");
+    wxCHECK_MSG(m_timestamps.empty() || m_timestamps.back() <= timestamps.front(), false, "Timestamps are not sorted");
 
-    wxString script;
+    const size_t oldCount = m_timestamps.size();
 
-    try
-    {
-        json j;
+    if ( !AppendSeriesData(timestamps.size(), seriesData) )
+        return false;
 
-        for ( const auto& n : m_variableNames )
-            j.push_back(n.utf8_string());
-        script.Printf("wxEChartsUpdateVariableNames('%s');", wxString::FromUTF8(j.dump()));
-    }
-    catch (const json::exception& e)
+    m_timestamps.insert(m_timestamps.end(), timestamps.begin(), timestamps.end());
+
+    if ( m_LODLast == oldCount )
     {
-        wxLogError(_("JSON error in %s (%s)."), __FUNCTION__, e.what());
-        return;
+        m_LODLast = m_timestamps.size();
+        m_LODWindowSynced = false;
     }
 
-    m_webView->RunScriptAsync(script, (void*)UpdateVariableNames);
+    return true;
 }
 
-void ChartHelper::RunChartGetColors()
+bool ChartHelper::SetData(std::vector<wxString>&& variableNames, std::vector<ValueSeries>&& series)
 {
-    wxCHECK_RET(m_webView, "m_webView is null");    
-    m_webView->RunScriptAsync("wxEChartsGetChartColors();", (void*)GetColors);
+    wxCHECK(!variableNames.empty(), false);
+    wxCHECK(!series.empty(), false);
+
+    for ( size_t i = 0; i < series.size(); ++i )
+    {
+        wxCHECK(!series[i].name.empty(), false);
+        wxCHECK(series[i].data.size() == variableNames.size(), false);
+        wxCHECK(series[i].precision.IsValid(), false);
+        for ( size_t j = i + 1; j < series.size(); ++j )
+            wxCHECK_MSG(!series[i].name.IsSameAs(series[j].name, true), false, "Series name already used");
+    }
+
+    Clear();
+
+    m_variableNames = move(variableNames);
+    m_series = move(series);
+    m_pyramids.resize(m_series.size());
+    for ( size_t i = 0; i < m_series.size(); ++i )
+        m_pyramids[i].Build(m_series[i].data.data(), m_series[i].data.size());
+
+    return true;
 }
 
-void ChartHelper::RunChartSetColors(const std::vector<wxColour>& colors)
+bool ChartHelper::AppendSeriesData(const size_t count, const std::vector<std::vector<double>>& seriesData)
 {
-    wxCHECK_RET(m_webView, "m_webView is null");
+    wxCHECK_MSG(seriesData.size() == m_series.size(), false, "Data must be appended to all series");
 
-    wxString script;
+    for ( const auto& d : seriesData )
+        wxCHECK(d.size() == count, false);
 
-    try
+    for ( size_t i = 0; i < m_series.size(); ++i )
     {
-        json j = json::array();
+        vector<double>& data = m_series[i].data;
+        const size_t oldCount = data.size();
 
-        for ( const auto& c : colors )
-        {
-            j.push_back(c.GetAsString(wxC2S_HTML_SYNTAX).utf8_string());
-        }
-        script.Printf("wxEChartsSetChartColors('%s')", j.dump());
-    }
-    catch (const json::exception& e)
-    {
-        wxLogError(_("JSON error in %s (%s)."), __FUNCTION__, e.what());
-        return;
+        data.insert(data.end(), seriesData[i].begin(), seriesData[i].end());
+        m_pyramids[i].Update(data.data(), data.size(), oldCount, data.size());
     }
 
-    m_webView->RunScriptAsync(script, (void*)SetColors);
+    SetSnapshotChanged();
+    return true;
 }
 
-void ChartHelper::RunChartGetSizingOptions()
+size_t ChartHelper::GetLODThreshold() const
 {
-    wxCHECK_RET(m_webView, "m_webView is null");
-    wxString script;
+    return m_LODThreshold;
+}
 
-    m_webView->RunScriptAsync("wxEChartsGetChartSizingOptions();", (void*)GetSizingOptions);
+void ChartHelper::SetLODThreshold(const size_t threshold)
+{
+    m_LODThreshold = threshold;
 }
 
+bool ChartHelper::IsLODActive() const
+{
+    // the live windows are small and sent incrementally
+    return !m_live && (m_dataFile || GetVariableNamesCount() > m_LODThreshold);
+}
 
-void ChartHelper::RunChartSetSizingOptions(const double widthToHeightRatio, const int minWidth, const int minHeight)
+void ChartHelper::RunChartCreate()
 {
     wxCHECK_RET(m_webView, "m_webView is null");
 
-    wxString script;
+    if ( m_live )
+        m_live->chartInitialized = false;
+    m_chartHasVariableNames = false;
+    ResetSentContent();
+    // sent first, so that the chart is created with them
+    m_chartHasRenderingOptions = false;
+    UpdateRenderingOptions(GetChartValueCount());
+    m_webView->RunScriptAsync("wxEChartsCreateChart('chart');", (void*)CreateChart);
+
+    // the new chart has the default options, restore those set before
+    // and obtain the others once
+    const wxString optionsJSON = GetChartOptions();
+
+    if ( !optionsJSON.empty() )
+        RunChartSetOptions(optionsJSON);
+    if ( m_chartColors.empty() || !m_hasChartSizingOptions )
+        m_webView->RunScriptAsync("wxEChartsGetChartOptions();", (void*)GetOptions);
+    if ( m_resizeSettleMode )
+        RunChartSetResizeSettleMode(m_resizeSettleMode, m_resizeSettleDelay);
+}
+
+void ChartHelper::SetChartShown(const bool shown)
+{
+    if ( shown == m_chartShown )
+        return;
+
+    m_chartShown = shown;
+    if ( !m_chartShown || !m_webView )
+        return;
+
+    // as when the chart is created, the names first
+    if ( m_variableNamesUpdateSuspended )
+        RunChartUpdateVariableNames();
+    if ( m_seriesUpdateSuspended && !m_series.empty() )
+        RunChartUpdateSeries();
+    m_variableNamesUpdateSuspended = false;
+    m_seriesUpdateSuspended = false;
+}
+
+bool ChartHelper::IsChartShown() const
+{
+    return m_chartShown;
+}
+
+void ChartHelper::RunChartUpdateSeries()
+{
+    wxCHECK_RET(m_webView, "m_webView is null");
+    wxCHECK_RET(!m_series.empty(), "m_series is empty");
+
+    // the update with the data as they are when shown replaces all those suspended
+    if ( !m_chartShown )
+    {
+        m_seriesUpdateSuspended = true;
+        m_sentUpdateStats.suspendedCount++;
+        return;
+    }
+
+    // the series sent next are drawn with the options for their size
+    UpdateRenderingOptions(GetChartValueCount());
+
+    if ( m_live )
+    {
+        CancelSeriesUpdates();
+        RunChartUpdateSeriesLive();
+        return;
+    }
+
+    SeriesUpdateFrame frame;
+
+    frame.snapshot = PublishSnapshot();
+    frame.sentSeriesHashes = m_sentSeriesHashes;
+    if ( IsLODActive() )
+        PrepareSeriesUpdateLOD(frame);
+    else
+        m_LODWasActive = false;
+
+    // the values in a data file may need to be read from the disk first
+    if ( m_updatePipeline && (m_dataFile || GetSeriesUpdateValueCount(frame) >= AsyncUpdateMinValueCount) )
+    {
+        m_updatePipeline->Submit(move(frame));
+        return;
+    }
+
+    // the update would be overwritten by an older one prepared in the background
+    CancelSeriesUpdates();
+
+    TransformSeriesUpdate(frame);
+    SerializeSeriesUpdate(frame, *m_serializeContext);
+    RunSeriesUpdate(frame);
+}
+
+void ChartHelper::SetChartUpdateReadyHandler(const std::function<void()>& onUpdateReady)
+{
+    m_onChartUpdateReady = onUpdateReady;
+    m_updatePipeline.reset();
+
+    if ( !m_onChartUpdateReady )
+        return;
+
+    SerializeContext* context = m_serializeContext.get();
+    auto process = [context](SeriesUpdateFrame& frame)
+    {
+        TransformSeriesUpdate(frame);
+        SerializeSeriesUpdate(frame, *context);
+    };
+
+    m_updatePipeline.reset(new UpdatePipeline<SeriesUpdateFrame>(UpdateWorkerCount, process, m_onChartUpdateReady));
+}
+
+void ChartHelper::RunReadyChartUpdate()
+{
+    wxCHECK_RET(m_webView, "m_webView is null");
+
+    SeriesUpdateFrame frame;
+
+    if ( m_updatePipeline && m_updatePipeline->TakeReadyFrame(frame) )
+        RunSeriesUpdate(frame);
+}
+
+void ChartHelper::PrepareSeriesUpdateLOD(SeriesUpdateFrame& frame)
+{
+    const size_t count = GetVariableNamesCount();
+
+    if ( !m_LODWasActive || m_LODLast == 0 || m_LODLast > count )
+    {
+        m_LODFirst = 0;
+        m_LODLast = count;
+        m_LODWindowSynced = false;
+    }
+    m_LODWasActive = true;
+
+    frame.LOD = true;
+    frame.LODFirst = m_LODFirst;
+    frame.LODLast = m_LODLast;
+    frame.maxBuckets = static_cast<size_t>(m_LODChartWidth);
+    // the range was not requested by the chart, so its zoom window must be changed
+    frame.sendWindow = !m_LODWindowSynced;
+    // full detail, send the names to be shown in the axis labels and tooltips
+    frame.sendNames = m_LODLast - m_LODFirst <= frame.maxBuckets && HasVariableNames();
+
+    if ( m_dataFile )
+        return;
+
+    frame.buckets.resize(m_series.size());
+    for ( size_t i = 0; i < m_series.size(); ++i )
+        m_pyramids[i].GetBuckets(GetValues(i), m_LODFirst, m_LODLast, frame.maxBuckets, frame.buckets[i]);
+}
+
+size_t ChartHelper::GetSeriesUpdateValueCount(const SeriesUpdateFrame& frame)
+{
+    const size_t seriesCount = frame.snapshot->GetSeriesCount();
+
+    // a line has two values for each bucket
+    if ( frame.LOD )
+        return min(frame.LODLast - frame.LODFirst, 2 * frame.maxBuckets) * seriesCount;
+    return frame.snapshot->GetVariableCount() * seriesCount;
+}
+
+void ChartHelper::TransformSeriesUpdate(SeriesUpdateFrame& frame)
+{
+    if ( !frame.LOD || !frame.buckets.empty() )
+        return;
+
+    const ChartSnapshot& snapshot = *frame.snapshot;
+
+    wxCHECK_RET(snapshot.m_dataFile, "LOD buckets must be obtained in the GUI thread");
+
+    frame.buckets.resize(snapshot.GetSeriesCount());
+    for ( size_t i = 0; i < snapshot.GetSeriesCount(); ++i )
+    {
+        const double* values = snapshot.m_dataFile->GetSeriesValues(i);
+        const SeriesPyramid* pyramid = snapshot.m_dataFile->GetSeriesPyramid(i);
+
+        // until the pyramids are built, the chart shows only the sampled values
+        if ( pyramid )
+            pyramid->GetBuckets(values, frame.LODFirst, frame.LODLast, frame.maxBuckets, frame.buckets[i]);
+        else
+            SeriesPyramid::GetSampledBuckets(values, frame.LODFirst, frame.LODLast, frame.maxBuckets, frame.buckets[i]);
+    }
+}
+
+void ChartHelper::SerializeSeriesUpdate(SeriesUpdateFrame& frame, SerializeContext& context)
+{
+    const ChartSnapshot& snapshot = *frame.snapshot;
+    const size_t seriesCount = snapshot.GetSeriesCount();
+    const bool timeMode = snapshot.IsTimeMode();
+    const bool sendTimestamps = timeMode && !frame.LOD;
+    // the chart keeps the series not sent only with variable names
+    const bool omitSameSeries = !timeMode && !frame.LOD;
+    const ChartSnapshot::Column<int64_t>& timestamps = snapshot.GetTimestamps();
+    // the x axis shows the variable indices or timestamps
+    auto GetX = [timeMode, &timestamps](const size_t idx) -> double
+        { return timeMode ? static_cast<double>(timestamps[idx]) : static_cast<double>(idx); };
+
+    unique_ptr<SerializeBuffers> buffers = context.AcquireBuffers();
+
+    // the timestamps are serialized in parallel with the series too
+    buffers->items.resize(seriesCount + (sendTimestamps ? 1 : 0));
+    frame.seriesHashes.assign(seriesCount, 0);
+    frame.seriesOmitted.assign(seriesCount, 0);
+
+    auto SerializeItem = [&](const size_t idx)
+    {
+        string& out = buffers->items[idx];
+        JSONWriter writer(out);
+
+        out.clear();
+
+        if ( idx == seriesCount )
+        {
+            writer.BeginArray();
+            timestamps.ForEachChunk(0, timestamps.GetSize(), [&writer](const int64_t* items, const size_t count)
+                { writer.Ints(items, count); });
+            writer.EndArray();
+            return;
+        }
+
+        const ChartSnapshot::Series& s = snapshot.GetSeries(idx);
+
+        writer.BeginObject();
+        writer.Key("name");
+        writer.String(s.name.utf8_string());
+        writer.Key("type");
+        writer.String(s.type == Bar ? "bar" : "line");
+        writer.Key("data");
+        writer.BeginArray();
+
+        if ( frame.LOD )
+        {
+            auto WritePoint = [&writer, &s](const double x, const double y)
+            {
+                writer.BeginArray();
+                writer.Double(x);
+                writer.Double(y, s.precision);
+                writer.EndArray();
+            };
+
+            for ( const auto& b : frame.buckets[idx] )
+            {
+                if ( b.last - b.first == 1 )
+                {
+                    WritePoint(GetX(b.first), b.value.min);
+                    continue;
+                }
+
+                // bucket with only NaN values
+                if ( b.value.min > b.value.max )
+                    continue;
+
+                const double x = (GetX(b.first) + GetX(b.last - 1)) / 2;
+
+                // a line needs both extremes, a bar can show only one
+                if ( s.type == Bar )
+                {
+                    WritePoint(x, fabs(b.value.min) > fabs(b.value.max) ? b.value.min : b.value.max);
+                }
+                else
+                {
+                    WritePoint(x, b.value.min);
+                    WritePoint(x, b.value.max);
+                }
+            }
+        }
+        else
+        {
+            s.values.ForEachChunk(0, s.values.GetSize(), [&writer, &s](const double* values, const size_t count)
+                { writer.Doubles(values, count, s.precision); });
+        }
+
+        writer.EndArray();
+        writer.EndObject();
+
+        frame.seriesHashes[idx] = ContentHash::Compute(out);
+        frame.seriesOmitted[idx] = omitSameSeries && idx < frame.sentSeriesHashes.size()
+                                   && frame.sentSeriesHashes[idx] == frame.seriesHashes[idx];
+    };
+
+    // one pool for all the charts, their threads would be mostly idle
+    TaskPool::GetShared().ParallelFor(buffers->items.size(), SerializeItem);
+
+    string& payload = buffers->payload;
+    JSONWriter writer(payload);
+
+    payload.clear();
+    if ( frame.LOD )
+        payload += "wxEChartsUpdateSeriesLOD('";
+    else if ( timeMode )
+        payload += "wxEChartsUpdateSeriesTime('";
+    else
+        payload += "wxEChartsUpdateSeries('";
+
+    writer.BeginObject();
+    if ( frame.LOD )
+    {
+        writer.Key("xType");
+        writer.String(timeMode ? "time" : "index");
+        writer.Key("min");
+        writer.Double(GetX(0));
+        writer.Key("max");
+        writer.Double(GetX(snapshot.GetVariableCount() - 1));
+        writer.Key("first");
+        writer.Int(static_cast<int64_t>(frame.LODFirst));
+        if ( frame.sendWindow )
+        {
+            writer.Key("windowStart");
+            writer.Double(GetX(frame.LODFirst));
+            writer.Key("windowEnd");
+            writer.Double(GetX(frame.LODLast - 1));
+        }
+        if ( frame.sendNames )
+        {
+            writer.Key("names");
+            writer.BeginArray();
+            for ( size_t i = frame.LODFirst; i < frame.LODLast; ++i )
+                writer.String(snapshot.GetVariableName(i).utf8_string());
+            writer.EndArray();
+        }
+    }
+    // the timestamps are sent only once, the chart pairs them with the values
+    if ( sendTimestamps )
+    {
+        writer.Key("timestamps");
+        writer.Raw(buffers->items[seriesCount]);
+    }
+    writer.Key("series");
+    writer.BeginArray();
+    frame.omittedBytes = 0;
+    for ( size_t i = 0; i < seriesCount; ++i )
+    {
+        if ( frame.seriesOmitted[i] )
+        {
+            // ECharts merges the empty object with the series, changing nothing
+            writer.BeginObject();
+            writer.EndObject();
+            frame.omittedBytes += buffers->items[i].size() - 2;
+        }
+        else
+        {
+            writer.Raw(buffers->items[i]);
+        }
+    }
+    writer.EndArray();
+    writer.EndObject();
+    payload += "');";
+
+    frame.script = wxString::FromUTF8(payload.data(), payload.size());
+    frame.scriptHash = ContentHash::Compute(payload);
+    frame.scriptBytes = payload.size();
+    context.ReleaseBuffers(move(buffers));
+}
+
+void ChartHelper::RunSeriesUpdate(SeriesUpdateFrame& frame)
+{
+    const bool anyOmitted = find(frame.seriesOmitted.begin(), frame.seriesOmitted.end(), 1) != frame.seriesOmitted.end();
+
+    // an update sent after this one was prepared could have changed the series not sent
+    if ( anyOmitted && frame.sentSeriesHashes != m_sentSeriesHashes )
+    {
+        frame.sentSeriesHashes = m_sentSeriesHashes;
+        SerializeSeriesUpdate(frame, *m_serializeContext);
+    }
+
+    const bool allOmitted = !frame.seriesOmitted.empty()
+                            && find(frame.seriesOmitted.begin(), frame.seriesOmitted.end(), 0) == frame.seriesOmitted.end();
+
+    if ( allOmitted || m_sentSeriesScript.IsSame(frame.scriptHash) )
+    {
+        m_sentUpdateStats.skippedCount++;
+        m_sentUpdateStats.savedBytes += frame.scriptBytes + frame.omittedBytes;
+    }
+    else
+    {
+        m_webView->RunScriptAsync(frame.script, (void*)UpdateSeries);
+
+        m_sentUpdateStats.sentCount++;
+        m_sentUpdateStats.sentBytes += frame.scriptBytes;
+        m_sentUpdateStats.savedBytes += frame.omittedBytes;
+        m_sentSeriesScript.sent = true;
+        m_sentSeriesScript.hash = frame.scriptHash;
+        if ( frame.LOD || frame.snapshot->IsTimeMode() )
+            m_sentSeriesHashes.clear();
+        else
+            m_sentSeriesHashes = frame.seriesHashes;
+    }
+
+    if ( frame.LOD || frame.snapshot->IsTimeMode() )
+    {
+        m_chartHasVariableNames = false;
+        if ( frame.sendWindow )
+            m_LODWindowSynced = true;
+        return;
+    }
+
+    // the chart dropped the variable names when it switched to another x axis type
+    if ( !m_chartHasVariableNames )
+        RunChartUpdateVariableNames();
+}
+
+void ChartHelper::CancelSeriesUpdates()
+{
+    if ( m_updatePipeline )
+        m_updatePipeline->Cancel();
+}
+
+bool ChartHelper::UpdateSentContent(SentContent& sentContent, const std::string& content)
+{
+    const uint64_t hash = ContentHash::Compute(content);
+
+    if ( sentContent.IsSame(hash) )
+    {
+        m_sentUpdateStats.skippedCount++;
+        m_sentUpdateStats.savedBytes += content.size();
+        return false;
+    }
+
+    sentContent.sent = true;
+    sentContent.hash = hash;
+    m_sentUpdateStats.sentCount++;
+    m_sentUpdateStats.sentBytes += content.size();
+    return true;
+}
+
+void ChartHelper::ResetSentContent()
+{
+    m_sentVariableNames.sent = false;
+    m_sentColors.sent = false;
+    m_sentSizingOptions.sent = false;
+    m_sentSeriesScript.sent = false;
+    m_sentSeriesHashes.clear();
+}
+
+void ChartHelper::RunChartUpdateSeriesLive()
+{
+    LiveData& live = *m_live;
+    const size_t count = live.timestamps.GetSize();
+    // the chart keeps the values it already has, except for the evicted ones
+    const size_t first = live.chartInitialized ? count - min(live.pushedCount, count) : 0;
+
+    if ( live.chartInitialized && first == count )
+        return;
+
+    m_LODWasActive = false;
+    m_chartHasVariableNames = false;
+    // the live series replace those sent before
+    m_sentSeriesScript.sent = false;
+    m_sentSeriesHashes.clear();
+
+    unique_ptr<SerializeBuffers> buffers = m_serializeContext->AcquireBuffers();
+    string& payload = buffers->payload;
+    JSONWriter writer(payload);
+
+    payload.clear();
+    payload += live.chartInitialized ? "wxEChartsLivePush('" : "wxEChartsLiveInit('";
+    writer.BeginObject();
+
+    if ( !live.chartInitialized )
+    {
+        writer.Key("capacity");
+        writer.Int(static_cast<int64_t>(live.timestamps.GetCapacity()));
+    }
+    else
+    {
+        // the chart values evicted from the ring buffers since the last update
+        writer.Key("evict");
+        writer.Int(static_cast<int64_t>(live.chartCount - first));
+    }
+
+    writer.Key("timestamps");
+    writer.BeginArray();
+    for ( size_t i = first; i < count; ++i )
+        writer.Int(live.timestamps[i]);
+    writer.EndArray();
+
+    if ( !live.chartInitialized )
+    {
+        writer.Key("series");
+        writer.BeginArray();
+        for ( size_t s = 0; s < m_series.size(); ++s )
+        {
+            writer.BeginObject();
+            writer.Key("name");
+            writer.String(m_series[s].name.utf8_string());
+            writer.Key("type");
+            writer.String(m_series[s].type == Bar ? "bar" : "line");
+            writer.Key("data");
+            writer.BeginArray();
+            for ( size_t i = 0; i < count; ++i )
+                writer.Double(live.values[s][i], m_series[s].precision);
+            writer.EndArray();
+            writer.EndObject();
+        }
+        writer.EndArray();
+    }
+    else
+    {
+        writer.Key("values");
+        writer.BeginArray();
+        for ( size_t s = 0; s < live.values.size(); ++s )
+        {
+            writer.BeginArray();
+            for ( size_t i = first; i < count; ++i )
+                writer.Double(live.values[s][i], m_series[s].precision);
+            writer.EndArray();
+        }
+        writer.EndArray();
+    }
+
+    writer.EndObject();
+    payload += "');";
+
+    m_webView->RunScriptAsync(wxString::FromUTF8(payload.data(), payload.size()), (void*)UpdateSeries);
+    m_serializeContext->ReleaseBuffers(move(buffers));
+
+    live.chartInitialized = true;
+    live.chartCount = count;
+    live.pushedCount = 0;
+}
+
+const double* ChartHelper::GetValues(const size_t seriesIdx) const
+{
+    if ( m_dataFile )
+        return m_dataFile->GetSeriesValues(seriesIdx);
+    return m_series[seriesIdx].data.data();
+}
+
+void ChartHelper::RunChartUpdateVariableNames()
+{
+    wxCHECK_RET(m_webView, "m_webView is null");
+
+    // in LOD mode, the names are sent with the series data
+    if ( IsLODActive() || !HasVariableNames() )
+        return;
+
+    wxCHECK_RET(!m_variableNames.empty(), "m_variableNames is empty");
+
+    if ( !m_chartShown )
+    {
+        m_variableNamesUpdateSuspended = true;
+        m_sentUpdateStats.suspendedCount++;
+        return;
+    }
+
+    unique_ptr<SerializeBuffers> buffers = m_serializeContext->AcquireBuffers();
+    string& payload = buffers->payload;
+    JSONWriter writer(payload);
+
+    payload.clear();
+    payload += "wxEChartsUpdateVariableNames('";
+    writer.BeginArray();
+    for ( const auto& n : m_variableNames )
+        writer.String(n.utf8_string());
+    writer.EndArray();
+    payload += "');";
+
+    // the chart drops the names when it switches to another x axis type
+    if ( !m_chartHasVariableNames )
+        m_sentVariableNames.sent = false;
+    if ( UpdateSentContent(m_sentVariableNames, payload) )
+        m_webView->RunScriptAsync(wxString::FromUTF8(payload.data(), payload.size()), (void*)UpdateVariableNames);
+    m_serializeContext->ReleaseBuffers(move(buffers));
+    m_chartHasVariableNames = true;
+}
+
+void ChartHelper::RunChartUpdateVisibleRange(const double startValue, const double endValue, const int chartWidth)
+{
+    static constexpr int minChartWidth = 50;
+    static constexpr int maxChartWidth = 10000;
+
+    // the chart reports zooming even when the data were just replaced
+    // with data not needing LOD, before it got them
+    if ( !IsLODActive() )
+        return;
+
+    if ( IsTimeMode() )
+    {
+        size_t first, last;
+
+        FindTimeRange(llround(min(startValue, endValue)), llround(max(startValue, endValue)), first, last);
+        // include the neighbouring values, so that the lines continue to the chart edges
+        m_LODFirst = first > 0 ? first - 1 : 0;
+        m_LODLast = min(last + 1, GetVariableNamesCount());
+    }
+    else
+    {
+        const double count = static_cast<double>(GetVariableNamesCount());
+        const double first = floor(max(0.0, min(startValue, endValue)));
+        const double last = min(count, floor(max(startValue, endValue)) + 1);
+
+        wxCHECK_RET(first < last, "Invalid visible range");
+
+        m_LODFirst = static_cast<size_t>(first);
+        m_LODLast = static_cast<size_t>(last);
+    }
+    m_LODChartWidth = max(minChartWidth, min(chartWidth, maxChartWidth));
+    m_LODWindowSynced = true;
+
+    RunChartUpdateSeries();
+}
+
+void ChartHelper::RunChartSetColors(const std::vector<wxColour>& colors)
+{
+    wxCHECK_RET(m_webView, "m_webView is null");
+    wxCHECK_RET(!colors.empty(), "no colors");
+
+    wxString script;
+
+    try
+    {
+        json j = json::array();
+
+        for ( const auto& c : colors )
+        {
+            j.push_back(c.GetAsString(wxC2S_HTML_SYNTAX).utf8_string());
+        }
+        script.Printf("wxEChartsSetChartColors('%s')", j.dump());
+    }
+    catch (const json::exception& e)
+    {
+        wxLogError(_("JSON error in %s (%s)."), __FUNCTION__, e.what());
+        return;
+    }
+
+    m_chartColors = colors;
+    if ( UpdateSentContent(m_sentColors, string(script.utf8_string())) )
+        m_webView->RunScriptAsync(script, (void*)SetColors);
+}
+
+void ChartHelper::RunChartSetSizingOptions(const double widthToHeightRatio, const int minWidth, const int minHeight)
+{
+    wxCHECK_RET(m_webView, "m_webView is null");
+
+    wxString script;
+
+    try
+    {
+        json j;
+
+        j["widthToHeightRatio"] = widthToHeightRatio;
+        j["minWidth"] = minWidth;
+        j["minHeight"] = minHeight;
+        script.Printf("wxEChartsSetChartSizingOptions('%s');", j.dump());
+    }
+    catch (const json::exception& e)
+    {
+        wxLogError(_("JSON error in %s (%s)."), __FUNCTION__, e.what());
+        return;
+    }
+
+    m_hasChartSizingOptions = true;
+    m_chartWidthToHeightRatio = widthToHeightRatio;
+    m_chartMinWidth = minWidth;
+    m_chartMinHeight = minHeight;
+    if ( UpdateSentContent(m_sentSizingOptions, string(script.utf8_string())) )
+        m_webView->RunScriptAsync(script, (void*)SetSizingOptions);
+}
+
+void ChartHelper::RunChartSetResizeSettleMode(const bool settleMode, const int settleDelay)
+{
+    wxCHECK_RET(m_webView, "m_webView is null");
+    wxCHECK_RET(settleDelay > 0, "invalid settleDelay");
+
+    wxString script;
+
+    script.Printf("wxEChartsSetResizeSettleMode(%s, %d);", settleMode ? "true" : "false", settleDelay);
+
+    m_resizeSettleMode = settleMode;
+    m_resizeSettleDelay = settleDelay;
+    m_webView->RunScriptAsync(script, (void*)SetResizeSettleMode);
+}
+
+bool ChartHelper::IsResizeSettleMode() const
+{
+    return m_resizeSettleMode;
+}
+
+void ChartHelper::RunChartSetOptions(const wxString& optionsJSON)
+{
+    wxCHECK_RET(m_webView, "m_webView is null");
+
+    vector<wxColour> colors;
+    bool hasSizingOptions = false;
+    double widthToHeightRatio = 1;
+    int minWidth = 0, minHeight = 0;
+    wxString script;
+
+    // the options can come from a file, so make sure they are valid
+    if ( !JSONToChartOptions(optionsJSON, colors, hasSizingOptions, widthToHeightRatio, minWidth, minHeight) )
+        return;
+
+    try
+    {
+        const json j = json::parse(string(optionsJSON.utf8_string()));
+
+        script.Printf("wxEChartsSetChartOptions('%s');", wxString::FromUTF8(j.dump()));
+    }
+    catch (const json::exception& e)
+    {
+        wxLogError(_("JSON parsing error in %s (%s)."), __FUNCTION__, e.what());
+        return;
+    }
+
+    if ( !colors.empty() )
+        m_chartColors = move(colors);
+    if ( hasSizingOptions )
+    {
+        m_hasChartSizingOptions = true;
+        m_chartWidthToHeightRatio = widthToHeightRatio;
+        m_chartMinWidth = minWidth;
+        m_chartMinHeight = minHeight;
+    }
+    // sent in another form than by RunChartSetColors() and RunChartSetSizingOptions()
+    m_sentColors.sent = false;
+    m_sentSizingOptions.sent = false;
+    m_webView->RunScriptAsync(script, (void*)SetOptions);
+}
+
+bool ChartHelper::GetChartColors(std::vector<wxColour>& colors) const
+{
+    if ( m_chartColors.empty() )
+        return false;
+
+    colors = m_chartColors;
+    return true;
+}
+
+bool ChartHelper::GetChartSizingOptions(double& widthToHeightRatio, int& minWidth, int& minHeight) const
+{
+    if ( !m_hasChartSizingOptions )
+        return false;
+
+    widthToHeightRatio = m_chartWidthToHeightRatio;
+    minWidth = m_chartMinWidth;
+    minHeight = m_chartMinHeight;
+    return true;
+}
+
+wxString ChartHelper::GetChartOptions() const
+{
+    if ( m_chartColors.empty() && !m_hasChartSizingOptions )
+        return wxString();
 
     try
     {
-        json j;
+        json j = json::object();
 
-        j["widthToHeightRatio"] = widthToHeightRatio;
-        j["minWidth"] = minWidth;
-        j["minHeight"] = minHeight;
-        script.Printf("wxEChartsSetChartSizingOptions('%s');", j.dump());
+        if ( !m_chartColors.empty() )
+        {
+            json colors = json::array();
+
+            for ( const auto& c : m_chartColors )
+                colors.push_back(c.GetAsString(wxC2S_HTML_SYNTAX).utf8_string());
+            j["colors"] = move(colors);
+        }
+        if ( m_hasChartSizingOptions )
+        {
+            j["sizingOptions"]["widthToHeightRatio"] = m_chartWidthToHeightRatio;
+            j["sizingOptions"]["minWidth"] = m_chartMinWidth;
+            j["sizingOptions"]["minHeight"] = m_chartMinHeight;
+        }
+        return wxString::FromUTF8(j.dump());
     }
     catch (const json::exception& e)
     {
         wxLogError(_("JSON error in %s (%s)."), __FUNCTION__, e.what());
+    }
+    return wxString();
+}
+
+bool ChartHelper::SyncChartOptions(const wxString& optionsJSON)
+{
+    vector<wxColour> colors;
+    bool hasSizingOptions = false;
+    double widthToHeightRatio = 1;
+    int minWidth = 0, minHeight = 0;
+
+    if ( !JSONToChartOptions(optionsJSON, colors, hasSizingOptions, widthToHeightRatio, minWidth, minHeight) )
+        return false;
+
+    // the options set since the script was run are newer
+    if ( m_chartColors.empty() )
+        m_chartColors = move(colors);
+    if ( !m_hasChartSizingOptions && hasSizingOptions )
+    {
+        m_hasChartSizingOptions = true;
+        m_chartWidthToHeightRatio = widthToHeightRatio;
+        m_chartMinWidth = minWidth;
+        m_chartMinHeight = minHeight;
+    }
+    return true;
+}
+
+bool ChartHelper::RenderingOptions::IsValid() const
+{
+    return devicePixelRatio >= 0 && largeThreshold > 0;
+}
+
+bool ChartHelper::RenderingOptions::operator==(const RenderingOptions& other) const
+{
+    return renderer == other.renderer
+           && devicePixelRatio == other.devicePixelRatio
+           && animation == other.animation
+           && large == other.large
+           && largeThreshold == other.largeThreshold
+           && sampling == other.sampling
+           && progressive == other.progressive;
+}
+
+void ChartHelper::RunChartSetRenderingOptions(const RenderingOptions& options)
+{
+    wxCHECK_RET(m_webView, "m_webView is null");
+    wxCHECK_RET(options.IsValid(), "invalid rendering options");
+
+    m_automaticRendering = false;
+    m_renderingOptions = options;
+    RunChartSendRenderingOptions();
+}
+
+void ChartHelper::RunChartSetAutomaticRenderingOptions()
+{
+    wxCHECK_RET(m_webView, "m_webView is null");
+
+    m_automaticRendering = true;
+    UpdateRenderingOptions(GetChartValueCount());
+}
+
+bool ChartHelper::HasAutomaticRenderingOptions() const
+{
+    return m_automaticRendering;
+}
+
+ChartHelper::RenderingOptions ChartHelper::GetRenderingOptions() const
+{
+    return m_renderingOptions;
+}
+
+void ChartHelper::OnChartRendered(const double renderTime, const double devicePixelRatio)
+{
+    if ( !(renderTime >= 0) )
         return;
+
+    if ( devicePixelRatio > 0 )
+        m_devicePixelRatio = devicePixelRatio;
+
+    // one slow frame, e.g., with a garbage collection, does not count much
+    m_renderTime = m_renderTime > 0 ? 0.75 * m_renderTime + 0.25 * renderTime : renderTime;
+
+    if ( m_renderTime > SlowRenderTime && m_renderingLoadLevel < MaxRenderingLoadLevel )
+    {
+        m_renderingLoadLevel++;
+        m_renderingLoadValueCount = m_chartValueCount;
+        // the time with the new options is measured anew
+        m_renderTime = 0;
+    }
+    // the chart would render fast with the options of the raised level,
+    // so the level is lowered only after the chart has much fewer values
+    else if ( m_renderTime < FastRenderTime && m_renderingLoadLevel > 0
+              && m_chartValueCount <= m_renderingLoadValueCount / 2 )
+    {
+        m_renderingLoadLevel--;
+        m_renderTime = 0;
     }
 
-    m_webView->RunScriptAsync(script, (void*)SetSizingOptions);
+    if ( m_webView )
+        UpdateRenderingOptions(m_chartValueCount);
 }
 
+ChartHelper::RenderingOptions ChartHelper::ChooseRenderingOptions(const size_t valueCount, const bool live,
+                                                                  const int loadLevel, const double devicePixelRatio,
+                                                                  const RenderingOptions::Renderer renderer)
+{
+    RenderingOptions options;
+
+    // a live chart is updated many times per second, animating or
+    // drawing it progressively would only delay it
+    if ( !live && loadLevel == 0 )
+    {
+        // SVG is sharp at any scale and draws a few elements faster,
+        // but it becomes slow with many of them; switching the renderer
+        // recreates the chart, so a chart with values added and removed
+        // around the limit keeps its renderer
+        if ( renderer == RenderingOptions::SVG ? valueCount <= SVGMaxValueCount
+                                               : valueCount <= SVGReturnValueCount )
+            options.renderer = RenderingOptions::SVG;
+        options.animation = valueCount <= AnimationMaxValueCount;
+    }
+    if ( !live && loadLevel > 0 )
+        options.progressive = ProgressiveValueCount;
+
+    if ( valueCount >= LargeMinValueCount || loadLevel > 0 )
+    {
+        options.large = true;
+        options.sampling = true;
+    }
+
+    // the number of pixels drawn grows with the square of the pixel ratio
+    const double maxDevicePixelRatio = loadLevel >= 2 ? 1 : MaxDevicePixelRatio;
+
+    if ( options.renderer == RenderingOptions::Canvas && devicePixelRatio > maxDevicePixelRatio )
+        options.devicePixelRatio = maxDevicePixelRatio;
+
+    return options;
+}
+
+size_t ChartHelper::GetChartValueCount() const
+{
+    if ( m_live )
+        return m_live->timestamps.GetSize() * m_series.size();
+
+    const size_t count = GetVariableNamesCount();
+
+    // a line has two values for each bucket
+    if ( IsLODActive() )
+        return min(count, 2 * static_cast<size_t>(m_LODChartWidth)) * m_series.size();
+    return count * m_series.size();
+}
+
+void ChartHelper::UpdateRenderingOptions(const size_t valueCount)
+{
+    m_chartValueCount = valueCount;
+    if ( m_automaticRendering )
+        m_renderingOptions = ChooseRenderingOptions(valueCount, m_live != nullptr,
+                                                    m_renderingLoadLevel, m_devicePixelRatio,
+                                                    m_chartHasRenderingOptions ? m_chartRenderingOptions.renderer
+                                                                               : RenderingOptions::SVG);
+    RunChartSendRenderingOptions();
+}
+
+void ChartHelper::RunChartSendRenderingOptions()
+{
+    wxCHECK_RET(m_webView, "m_webView is null");
+
+    if ( m_chartHasRenderingOptions && m_chartRenderingOptions == m_renderingOptions )
+        return;
+
+    const RenderingOptions& options = m_renderingOptions;
+    wxString script;
+
+    try
+    {
+        json j;
+
+        j["renderer"] = options.renderer == RenderingOptions::SVG ? "svg" : "canvas";
+        j["devicePixelRatio"] = options.devicePixelRatio;
+        j["animation"] = options.animation;
+        j["large"] = options.large;
+        j["largeThreshold"] = options.largeThreshold;
+        j["sampling"] = options.sampling;
+        j["progressive"] = options.progressive;
+        script.Printf("wxEChartsSetRenderingOptions('%s');", j.dump());
+    }
+    catch (const json::exception& e)
+    {
+        wxLogError(_("JSON error in %s (%s)."), __FUNCTION__, e.what());
+        return;
+    }
+
+    m_chartHasRenderingOptions = true;
+    m_chartRenderingOptions = options;
+    m_webView->RunScriptAsync(script, (void*)SetRenderingOptions);
+}
 
 void ChartHelper::RunChartGetPNG(const int imageWidth)
 {
@@ -323,6 +1785,341 @@ void ChartHelper::RunChartGetEChartsVersion()
     m_webView->RunScriptAsync("wxEChartsGetEChartsVersion();", (void*)GetEChartsVersion);
 }
 
+ChartHelper::SentUpdateStats ChartHelper::GetSentUpdateStats() const
+{
+    return m_sentUpdateStats;
+}
+
+void ChartHelper::SetPostedUpdatesHandler(const std::function<void()>& onUpdatesPosted)
+{
+    m_onUpdatesPosted = onUpdatesPosted;
+}
+
+void ChartHelper::PostSeriesData(const size_t seriesIdx, std::vector<double>&& data)
+{
+    PostedUpdate update;
+
+    update.type = PostedUpdate::SeriesData;
+    update.seriesIdx = seriesIdx;
+    update.values = move(data);
+    PostUpdate(move(update));
+}
+
+void ChartHelper::PostSeriesValue(const size_t seriesIdx, const size_t valueIdx, const double value)
+{
+    PostedUpdate update;
+
+    update.type = PostedUpdate::SeriesValue;
+    update.seriesIdx = seriesIdx;
+    update.valueIdx = valueIdx;
+    update.value = value;
+    PostUpdate(move(update));
+}
+
+void ChartHelper::PostAppendData(std::vector<wxString>&& variableNames, std::vector<std::vector<double>>&& seriesData)
+{
+    PostedUpdate update;
+
+    update.type = PostedUpdate::AppendedNames;
+    update.variableNames = move(variableNames);
+    update.seriesData = move(seriesData);
+    PostUpdate(move(update));
+}
+
+void ChartHelper::PostAppendData(std::vector<int64_t>&& timestamps, std::vector<std::vector<double>>&& seriesData)
+{
+    PostedUpdate update;
+
+    update.type = PostedUpdate::AppendedTimestamps;
+    update.timestamps = move(timestamps);
+    update.seriesData = move(seriesData);
+    PostUpdate(move(update));
+}
+
+void ChartHelper::PostLiveValues(const int64_t timestamp, std::vector<double>&& values)
+{
+    PostedUpdate update;
+
+    update.type = PostedUpdate::LiveValues;
+    update.timestamp = timestamp;
+    update.values = move(values);
+    PostUpdate(move(update));
+}
+
+void ChartHelper::PostUpdate(PostedUpdate&& update)
+{
+    m_postedUpdates.Push(move(update));
+    m_postedUpdateCount.fetch_add(1, memory_order_release);
+
+    // only the first update posted since the updates were last applied
+    // schedules applying them, the update is pushed before the flag is set,
+    // so that ApplyPostedUpdates() resetting it also sees the update
+    if ( !m_postedUpdatesScheduled.exchange(true, memory_order_acq_rel) && m_onUpdatesPosted )
+        m_onUpdatesPosted();
+}
+
+ChartHelper::AppliedUpdates ChartHelper::ApplyPostedUpdates()
+{
+    AppliedUpdates result;
+    vector<PostedUpdate> updates;
+
+    PopPostedUpdates(updates);
+
+    // going backwards, the series whose whole data are set by a later update,
+    // appending changes the number of values so it ends the coalescing
+    vector<bool> seriesDataSetLater(m_series.size(), false);
+    vector<bool> coalesced(updates.size(), false);
+
+    for ( size_t i = updates.size(); i-- > 0; )
+    {
+        const PostedUpdate& u = updates[i];
+
+        if ( u.type != PostedUpdate::SeriesData && u.type != PostedUpdate::SeriesValue )
+        {
+            seriesDataSetLater.assign(seriesDataSetLater.size(), false);
+            continue;
+        }
+
+        if ( u.seriesIdx >= seriesDataSetLater.size() )
+            continue;
+
+        if ( seriesDataSetLater[u.seriesIdx] )
+            coalesced[i] = true;
+        else if ( u.type == PostedUpdate::SeriesData )
+            seriesDataSetLater[u.seriesIdx] = true;
+    }
+
+    for ( size_t i = 0; i < updates.size(); ++i )
+    {
+        if ( coalesced[i] )
+            ++result.coalescedCount;
+        else if ( !CanApplyUpdate(updates[i]) )
+            ++result.rejectedCount;
+        else
+            ApplyUpdate(updates[i], result);
+    }
+
+    return result;
+}
+
+void ChartHelper::DiscardPostedUpdates()
+{
+    vector<PostedUpdate> updates;
+
+    PopPostedUpdates(updates);
+}
+
+void ChartHelper::PopPostedUpdates(std::vector<PostedUpdate>& updates)
+{
+    // the updates posted from now on will schedule another call
+    m_postedUpdatesScheduled.exchange(false, memory_order_acq_rel);
+
+    const size_t postedCount = m_postedUpdateCount.load(memory_order_acquire);
+    PostedUpdate update;
+
+    // an update being pushed can hold up the updates after it,
+    // they will be popped in the call scheduled by that push
+    while ( m_poppedUpdateCount != postedCount && m_postedUpdates.TryPop(update) )
+    {
+        updates.push_back(move(update));
+        ++m_poppedUpdateCount;
+    }
+}
+
+bool ChartHelper::CanApplyUpdate(const PostedUpdate& update) const
+{
+    const size_t count = GetVariableNamesCount();
+
+    if ( update.type == PostedUpdate::LiveValues )
+    {
+        return m_live && update.values.size() == m_series.size()
+               && (m_live->timestamps.IsEmpty() || m_live->timestamps.GetNewest() <= update.timestamp);
+    }
+
+    if ( m_live || m_dataFile )
+        return false;
+
+    switch ( update.type )
+    {
+        case PostedUpdate::SeriesData:
+            return update.seriesIdx < m_series.size() && update.values.size() == count;
+        case PostedUpdate::SeriesValue:
+            return update.seriesIdx < m_series.size() && update.valueIdx < count;
+        case PostedUpdate::AppendedNames:
+        case PostedUpdate::AppendedTimestamps:
+        {
+            const bool timeMode = update.type == PostedUpdate::AppendedTimestamps;
+            const size_t appendedCount = timeMode ? update.timestamps.size() : update.variableNames.size();
+
+            if ( timeMode != IsTimeMode() || appendedCount == 0 || update.seriesData.size() != m_series.size() )
+                return false;
+
+            for ( const auto& d : update.seriesData )
+            {
+                if ( d.size() != appendedCount )
+                    return false;
+            }
+
+            return !timeMode || (is_sorted(update.timestamps.begin(), update.timestamps.end())
+                                 && m_timestamps.back() <= update.timestamps.front());
+        }
+        default:
+            return false;
+    }
+}
+
+void ChartHelper::ApplyUpdate(PostedUpdate& update, AppliedUpdates& result)
+{
+    bool applied = false;
+
+    switch ( update.type )
+    {
+        case PostedUpdate::SeriesData:
+            applied = SetSeriesData(update.seriesIdx, update.values);
+            result.valuesChanged = result.valuesChanged || applied;
+            break;
+        case PostedUpdate::SeriesValue:
+            applied = SetSeriesValue(update.seriesIdx, update.valueIdx, update.value);
+            result.valuesChanged = result.valuesChanged || applied;
+            break;
+        case PostedUpdate::AppendedNames:
+            applied = AppendData(update.variableNames, update.seriesData);
+            if ( applied )
+                result.appendedCount += update.variableNames.size();
+            break;
+        case PostedUpdate::AppendedTimestamps:
+            applied = AppendData(update.timestamps, update.seriesData);
+            if ( applied )
+                result.appendedCount += update.timestamps.size();
+            break;
+        case PostedUpdate::LiveValues:
+            PushLiveRow(update.timestamp, update.values.data());
+            applied = true;
+            result.liveValuesPushed = true;
+            break;
+    }
+
+    if ( applied )
+        ++result.appliedCount;
+    else
+        ++result.rejectedCount;
+}
+
+std::shared_ptr<const ChartSnapshot> ChartHelper::PublishSnapshot()
+{
+    // only this thread modifies m_snapshot, so it can be read without atomic_load()
+    shared_ptr<const ChartSnapshot> previous = m_snapshot;
+
+    if ( previous && !m_snapshotChanged )
+        return previous;
+    if ( m_snapshotDataReplaced )
+        previous.reset();
+
+    shared_ptr<ChartSnapshot> snapshot(new ChartSnapshot);
+    const size_t count = GetVariableNamesCount();
+
+    snapshot->m_version = ++m_snapshotVersion;
+    snapshot->m_variableCount = count;
+    snapshot->m_timeMode = IsTimeMode() || m_live;
+    snapshot->m_series.resize(m_series.size());
+    m_snapshotChangedValues.resize(m_series.size());
+
+    for ( size_t s = 0; s < m_series.size(); ++s )
+    {
+        snapshot->m_series[s].name = m_series[s].name;
+        snapshot->m_series[s].type = m_series[s].type;
+        snapshot->m_series[s].precision = m_series[s].precision;
+    }
+
+    if ( m_dataFile )
+    {
+        // the mapped data never change
+        snapshot->m_dataFile = m_dataFile;
+        if ( IsTimeMode() )
+            snapshot->m_timestamps.AssignExternal(m_dataFile, GetTimestamps(), count);
+        for ( size_t s = 0; s < m_series.size(); ++s )
+            snapshot->m_series[s].values.AssignExternal(m_dataFile, GetValues(s), count);
+    }
+    else if ( m_live )
+    {
+        // the live values are few and most of them change with every push anyway
+        const LiveData& live = *m_live;
+
+        snapshot->m_timestamps.AssignCopy(count, [&live](const size_t idx) { return live.timestamps[idx]; });
+        for ( size_t s = 0; s < m_series.size(); ++s )
+        {
+            const RingBuffer<double>& values = live.values[s];
+
+            snapshot->m_series[s].values.AssignCopy(count, [&values](const size_t idx) { return values[idx]; });
+        }
+    }
+    else
+    {
+        if ( IsTimeMode() )
+        {
+            // the timestamps can be only appended
+            snapshot->m_timestamps.Assign(m_timestamps.data(), count,
+                                          previous ? &previous->m_timestamps : nullptr, 0, 0);
+        }
+        else
+        {
+            snapshot->m_variableNames.Assign(m_variableNames.data(), count,
+                                             previous ? &previous->m_variableNames : nullptr,
+                                             m_snapshotChangedNames.first, m_snapshotChangedNames.last);
+        }
+
+        for ( size_t s = 0; s < m_series.size(); ++s )
+        {
+            const ChangedRange& changed = m_snapshotChangedValues[s];
+            // the series are only added, they are never removed or reordered
+            const bool hasPrevious = previous && s < previous->m_series.size();
+
+            snapshot->m_series[s].values.Assign(m_series[s].data.data(), count,
+                                                hasPrevious ? &previous->m_series[s].values : nullptr,
+                                                changed.first, changed.last);
+        }
+    }
+
+    m_snapshotChanged = false;
+    m_snapshotDataReplaced = false;
+    m_snapshotChangedNames = ChangedRange();
+    m_snapshotChangedValues.assign(m_series.size(), ChangedRange());
+
+    shared_ptr<const ChartSnapshot> published(move(snapshot));
+
+    atomic_store(&m_snapshot, published);
+    return published;
+}
+
+std::shared_ptr<const ChartSnapshot> ChartHelper::GetSnapshot() const
+{
+    return atomic_load(&m_snapshot);
+}
+
+void ChartHelper::ChangedRange::Add(const size_t addFirst, const size_t addLast)
+{
+    first = min(first, addFirst);
+    last = max(last, addLast);
+}
+
+void ChartHelper::SetSnapshotChanged()
+{
+    m_snapshotChanged = true;
+}
+
+void ChartHelper::SetSnapshotValuesChanged(const size_t seriesIdx, const size_t first, const size_t last)
+{
+    if ( m_snapshotChangedValues.size() <= seriesIdx )
+        m_snapshotChangedValues.resize(seriesIdx + 1);
+    m_snapshotChangedValues[seriesIdx].Add(first, last);
+    m_snapshotChanged = true;
+}
+
+wxString ChartHelper::FormatTimestamp(const int64_t timestamp)
+{
+    return wxDateTime(wxLongLong(timestamp)).Format("%Y-%m-%d %H:%M:%S.%l", wxDateTime::UTC);
+}
+
 bool ChartHelper::JSONToColors(const wxString& JSONStr, std::vector<wxColour>& colors)
 {
     try
@@ -376,4 +2173,37 @@ bool ChartHelper::JSONToSizingOptions(const wxString& JSONStr, double& widthToHe
         return false;
     }
     return true;
+}
+
+bool ChartHelper::JSONToChartOptions(const wxString& JSONStr, std::vector<wxColour>& colors,
+                                     bool& hasSizingOptions, double& widthToHeightRatio,
+                                     int& minWidth, int& minHeight)
+{
+    try
+    {
+        const json j = json::parse(string(JSONStr.utf8_string()));
+
+        if ( !j.is_object() )
+        {
+            wxLogError(_("Invalid JSON chart options string in %s."), __FUNCTION__);
+            return false;
+        }
+
+        colors.clear();
+        if ( j.contains("colors") && !j["colors"].is_null()
+             && !JSONToColors(wxString::FromUTF8(j["colors"].dump()), colors) )
+            return false;
+
+        hasSizingOptions = j.contains("sizingOptions") && !j["sizingOptions"].is_null();
+        if ( hasSizingOptions
+             && !JSONToSizingOptions(wxString::FromUTF8(j["sizingOptions"].dump()),
+                                     widthToHeightRatio, minWidth, minHeight) )
+            return false;
+    }
+    catch (const json::exception& e)
+    {
+        wxLogError(_("JSON parsing error in %s (%s)."), __FUNCTION__, e.what());
+        return false;
+    }
+    return true;
 }
\ No newline at end of file
@@ -11,11 +11,24 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <vector>
 
+#include <wx/colour.h>
 #include <wx/string.h>
 
-class wxColour;
+#include "jsonwriter.h"
+#include "mpscqueue.h"
+#include "ringbuffer.h"
+#include "seriespyramid.h"
+
+class ChartDataFile;
+class ChartSnapshot;
+class SharedRingBuffer;
+template <typename Frame> class UpdatePipeline;
 class wxImage;
 class wxMemoryBuffer;
 class wxWebView;
@@ -37,6 +50,97 @@ After a variable name or series properties are modified, the
 appropriate ChartUpdate<X>() method must be called to reflect
 the changes in the chart itself.
 
+When the number of variables exceeds the level of detail (LOD)
+threshold, the chart x axis shows the variable indices and
+only the visible range aggregated to min/max buckets (one per
+chart pixel) is sent to the chart. The chart reports zooming
+with the "datazoom" message, which must be passed
+to RunChartUpdateVisibleRange().
+
+Instead of variable names, timestamps can be added (time mode).
+The timestamps are stored once for all series and the chart
+then uses a time x axis.
+
+Instead of adding variable names and series, a data file
+(see ChartDataFile) can be opened. Its data can be much larger
+than the available memory, so they are not loaded but accessed
+in the memory-mapped file, they cannot be modified and the chart
+is always in LOD mode. The variables in the file can have names,
+timestamps or be identified only by their indices. The data can
+be saved to a data file with SaveDataFile(). A saved file opens
+as a data file too, i.e., read-only and in LOD mode, even when
+the saved data could be modified; it cannot be saved over the data
+file currently opened, as its values are read from that file.
+
+For live data (e.g., showing only the last 10 minutes), start
+the live mode with the capacity of the series and then push
+timestamped values. Once the capacity is reached, pushing
+a value evicts the oldest one. Only the values pushed since
+the last ChartUpdateSeries() are sent to the chart, together
+with the number of the values to evict. The values can also
+be read from a ring buffer in shared memory written by another
+process, see AttachSharedRingBuffer().
+
+The chart colors and sizing options are mirrored in ChartHelper,
+so that they can be obtained without waiting for a script. Those
+not set with RunChartSet<X>() yet are obtained from the chart once
+after it is created (the default colors are the ECharts theme's),
+the result of that script must be passed to SyncChartOptions().
+
+How ECharts renders the chart (the renderer, animation, large mode,
+sampling...) is chosen automatically from the number of values the
+chart shows, see ChooseRenderingOptions(). The chart reports how
+long it took to render the updates with the "rendered" message,
+which must be passed to OnChartRendered(). When it renders too
+slowly, the options trading the quality for speed are chosen.
+The automatic choice can be overridden with
+RunChartSetRenderingOptions().
+
+While the chart is hidden (e.g., in another notebook page or in
+a minimized frame), updating the series or variable names only
+notes that the chart needs the update, nothing is serialized or
+sent. When the host calls SetChartShown(true), the chart is
+updated once with the data as they are then.
+
+ChartHelper keeps the hashes (see ContentHash) of the variable
+names, series, colors and sizing options it sent to the chart last
+and does not send them again when their content did not change.
+When the series are updated with variable names, those which did
+not change are sent as empty objects, leaving them as they are in
+the chart. The bytes not sent are counted, see GetSentUpdateStats().
+
+ChartHelper must be used only from the GUI thread, with the
+exception of the Post<X>() methods, which can be called from
+any thread. They only queue the update, which is applied later
+in the GUI thread with ApplyPostedUpdates(). The ordering
+guarantee is as follows:
+- The updates posted by one thread are applied in the order
+  they were posted.
+- The updates posted by different threads are applied in one
+  order consistent with the above, where of two posts not
+  ordered by other means either can be applied first.
+- After a Post<X>() returns, the update is applied by the
+  next ApplyPostedUpdates() call scheduled by the handler
+  set with SetPostedUpdatesHandler(), if not sooner.
+- The chart shows either all the updates applied by one
+  ApplyPostedUpdates() call or none of them, as the caller
+  updates the chart once after they are all applied.
+
+To let other threads read the data while the GUI thread keeps
+modifying them, publish an immutable snapshot of the data with
+PublishSnapshot(). The threads can read it without locking and
+obtain the snapshot published last with GetSnapshot().
+
+Preparing the update of a large chart (sampling the values and
+serializing them to JSON) can take long, so when the handler is
+set with SetChartUpdateReadyHandler(), RunChartUpdateSeries()
+only publishes the snapshot and the update is prepared from it
+in a worker thread. The GUI thread then only runs the script
+of the newest prepared update with RunReadyChartUpdate(), the
+older updates not yet run are dropped. Small updates and the
+live updates are still prepared right away in the GUI thread.
+Either way, the series are serialized in parallel.
+
 ******************************************************************/
 
 class ChartHelper final
@@ -49,11 +153,14 @@ public:
         UpdateSeries,
         UpdateVariableNames,
 
-        GetColors,
         SetColors,
-
-        GetSizingOptions,
         SetSizingOptions,
+        SetRenderingOptions,
+        SetResizeSettleMode,
+
+        // run by RunChartCreate(), see SyncChartOptions()
+        GetOptions,
+        SetOptions,
 
         GetPNG,
 
@@ -66,16 +173,34 @@ public:
         Line,
     };
 
+    // the values are sent to the chart rounded to the precision,
+    // measured values usually have only a few meaningful digits
+    using ValuePrecision = JSONWriter::Precision;
+
     struct ValueSeries
     {
         wxString name;
         SeriesType type{Bar};
         std::vector<double> data;
+        ValuePrecision precision;
     };
 
     ChartHelper();
+    ~ChartHelper();
     void SetWebView(wxWebView* webView);
 
+    // replaces the variables and series with those in the data file;
+    // onLODReady is called from a worker thread when the min/max pyramids
+    // were built, until then the chart shows only the sampled values
+    bool OpenDataFile(const wxString& fileName, const std::function<void()>& onLODReady);
+    bool HasDataFile() const;
+    // saves all the variables and series to the data file, options are the chart
+    // options as obtained with GetChartOptions() to be stored with the data;
+    // fails when fileName is the data file currently opened
+    bool SaveDataFile(const wxString& fileName, const wxString& options, const bool compress) const;
+    // the chart options stored in the opened data file, can be empty
+    wxString GetDataFileOptions() const;
+
     size_t GetVariableNamesCount() const;
 
     bool GetVariableName(const size_t nameIdx, wxString& name) const;
@@ -83,6 +208,49 @@ public:
     bool AddVariableName(const wxString& name);
     bool AddVariableNames(const std::vector<wxString>& names);
     bool SetVariableName(const size_t nameIdx, const wxString& name);
+    // false in time mode, live mode or with a data file without names
+    bool HasVariableNames() const;
+
+    // timestamps are milliseconds since the Unix epoch (UTC),
+    // they must be in ascending order
+    bool AddTimestamps(const std::vector<int64_t>& timestamps);
+    bool IsTimeMode() const;
+    bool GetTimestamp(const size_t idx, int64_t& timestamp) const;
+    // obtains the variables [first, last) with timestamps in [start, end]
+    void FindTimeRange(const int64_t start, const int64_t end, size_t& first, size_t& last) const;
+
+    // replaces the variables and series with the empty series of the given
+    // capacity; the values must then be pushed with PushLiveValues()
+    bool StartLiveMode(const size_t capacity, const std::vector<wxString>& seriesNames,
+                       const SeriesType type = Line);
+    // ends the live mode, the values pushed are kept as a time series
+    // (or cleared if there are none), so that the next live source
+    // starts with only its own series
+    void StopLiveMode();
+    bool IsLiveMode() const;
+    size_t GetLiveCapacity() const;
+    // values must contain a value for each series, timestamps
+    // are as in AddTimestamps() and must be in ascending order
+    bool PushLiveValues(const int64_t timestamp, const std::vector<double>& values);
+    // adds the series in live mode, its values for the timestamps
+    // already pushed are NaN
+    bool AddLiveSeries(const wxString& name, const SeriesType type = Line);
+
+    // attaches to the ring buffer in the named shared memory (see SharedRingBuffer)
+    // and starts the live mode with its series and the given capacity,
+    // or the capacity of the ring buffer if 0
+    bool AttachSharedRingBuffer(const wxString& name, const size_t capacity = 0);
+    // the live mode continues with the values already pushed
+    void DetachSharedRingBuffer();
+    // nullptr if not attached
+    const SharedRingBuffer* GetSharedRingBuffer() const;
+    // pushes the values written to the shared ring buffer since the last call,
+    // usually called on a timer at the display rate; returns the number of pushed
+    // values, the values with timestamps older than the last pushed are skipped
+    size_t ReadSharedRingBuffer();
+
+    // for the x axis value (variable index or timestamp) of a chart data item
+    size_t GetNearestVariableIdx(const double xValue) const;
 
     size_t GetSeriesCount() const;
 
@@ -95,29 +263,417 @@ public:
     bool GetSeriesType(const size_t seriesIdx, SeriesType& type) const;
     bool SetSeriesType(const size_t seriesIdx, const SeriesType& type);
 
+    bool GetSeriesPrecision(const size_t seriesIdx, ValuePrecision& precision) const;
+    bool SetSeriesPrecision(const size_t seriesIdx, const ValuePrecision& precision);
+
     bool GetSeriesData(const size_t seriesIdx, std::vector<double>& data) const;
     bool SetSeriesData(const size_t seriesIdx, const std::vector<double>& data);
 
+    bool GetSeriesValue(const size_t seriesIdx, const size_t valueIdx, double& value) const;
+    bool SetSeriesValue(const size_t seriesIdx, const size_t valueIdx, const double value);
+
+    // seriesData must contain data for all series, each with variableNames.size() values
+    bool AppendData(const std::vector<wxString>& variableNames,
+                    const std::vector<std::vector<double>>& seriesData);
+    // as above but in time mode
+    bool AppendData(const std::vector<int64_t>& timestamps,
+                    const std::vector<std::vector<double>>& seriesData);
+
+    // replaces all the variables and series, the data are moved and,
+    // as with AppendData(), the variable names are not checked for uniqueness;
+    // each series must have variableNames.size() values
+    bool SetData(std::vector<wxString>&& variableNames, std::vector<ValueSeries>&& series);
+
+    // removes all variables and series, closes the data file and ends the live mode
+    void Clear();
+
+    static constexpr size_t DefaultLODThreshold = 10000;
+
+    size_t GetLODThreshold() const;
+    void SetLODThreshold(const size_t threshold);
+    bool IsLODActive() const;
+
     void RunChartCreate();
 
+    // called by the host when the chart was hidden or shown,
+    // showing it runs the updates suspended while it was hidden
+    void SetChartShown(const bool shown);
+    bool IsChartShown() const;
+
     void RunChartUpdateSeries();
     void RunChartUpdateVariableNames();
+    // startValue and endValue are the variable indices, chartWidth is in pixels
+    void RunChartUpdateVisibleRange(const double startValue, const double endValue, const int chartWidth);
 
-    void RunChartGetColors();
     void RunChartSetColors(const std::vector<wxColour>& colors);
-
-    void RunChartGetSizingOptions();
     void RunChartSetSizingOptions(const double widthToHeightRatio, const int minWidth, const int minHeight);
 
+    // the chart is rendered anew at most once per frame when it is resized;
+    // in the settle mode, the chart is only scaled while it is being resized
+    // and rendered anew once it has not been resized for settleDelay ms
+    void RunChartSetResizeSettleMode(const bool settleMode, const int settleDelay = DefaultResizeSettleDelay);
+    bool IsResizeSettleMode() const;
+
+    static constexpr int DefaultResizeSettleDelay = 150;
+
+    // the chart options are the colors and sizing options as one JSON object
+    void RunChartSetOptions(const wxString& optionsJSON);
+
+    // the mirrored chart options, return false when not known yet
+    bool GetChartColors(std::vector<wxColour>& colors) const;
+    bool GetChartSizingOptions(double& widthToHeightRatio, int& minWidth, int& minHeight) const;
+    // the options known as JSON for RunChartSetOptions(), empty when none are
+    wxString GetChartOptions() const;
+    // called with the result of the GetOptions script, sets the options
+    // which were not set with RunChartSet<X>() since the chart was created
+    bool SyncChartOptions(const wxString& optionsJSON);
+
+    struct RenderingOptions
+    {
+        enum Renderer
+        {
+            Canvas,
+            SVG,
+        };
+
+        // changing the renderer or the pixel ratio recreates the chart instance
+        Renderer renderer{Canvas};
+        // 0 for the pixel ratio of the display
+        double devicePixelRatio{0};
+        bool animation{false};
+        // the bar series with more than largeThreshold values are drawn
+        // in one batch, without the styles of individual items
+        bool large{false};
+        size_t largeThreshold{2000};
+        // the line series with more values than pixels are downsampled
+        // with the largest-triangle-three-buckets (LTTB) algorithm
+        bool sampling{false};
+        // the number of values drawn in one animation frame, 0 to draw all at once
+        size_t progressive{0};
+
+        bool IsValid() const;
+
+        bool operator==(const RenderingOptions& other) const;
+        bool operator!=(const RenderingOptions& other) const { return !(*this == other); }
+    };
+
+    // stops choosing the rendering options automatically
+    void RunChartSetRenderingOptions(const RenderingOptions& options);
+    void RunChartSetAutomaticRenderingOptions();
+    bool HasAutomaticRenderingOptions() const;
+    // the options set or chosen last
+    RenderingOptions GetRenderingOptions() const;
+    // called with the time the chart took to render an update in milliseconds
+    // and the pixel ratio of the display, as reported by the "rendered" message
+    void OnChartRendered(const double renderTime, const double devicePixelRatio);
+
+    // the load level is raised when the chart renders too slowly
+    static constexpr int MaxRenderingLoadLevel = 2;
+
+    // the options for the chart showing valueCount values in all the series,
+    // at level 1 the values are drawn progressively and sampled, at level 2
+    // also with the pixel ratio 1; the renderer is the one the chart uses,
+    // SVG for a new chart, so that it does not switch back and forth
+    static RenderingOptions ChooseRenderingOptions(const size_t valueCount, const bool live,
+                                                   const int loadLevel, const double devicePixelRatio,
+                                                   const RenderingOptions::Renderer renderer);
+
     void RunChartGetPNG(const int imageWidth);
 
     void RunChartGetEChartsVersion();
 
+    // the chart updates subject to skipping the content already sent,
+    // i.e., all but the live updates
+    struct SentUpdateStats
+    {
+        size_t sentCount{0};
+        // not sent, the chart already had the same content
+        size_t skippedCount{0};
+        // not sent while the chart was hidden
+        size_t suspendedCount{0};
+        uint64_t sentBytes{0};
+        // of the updates skipped and the series not sent again
+        uint64_t savedBytes{0};
+    };
+
+    SentUpdateStats GetSentUpdateStats() const;
+
+    // called from a worker thread when a series update prepared in the
+    // background is ready, it must call RunReadyChartUpdate() in the GUI
+    // thread later, e.g., with CallAfter(); when not set, the series
+    // updates are always prepared in the GUI thread
+    void SetChartUpdateReadyHandler(const std::function<void()>& onUpdateReady);
+    // runs the script of the newest series update prepared in the background
+    void RunReadyChartUpdate();
+
+    // called from the thread posting an update when the updates must be
+    // applied, it must call ApplyPostedUpdates() in the GUI thread later,
+    // e.g., with CallAfter(); must be set before any update is posted
+    void SetPostedUpdatesHandler(const std::function<void()>& onUpdatesPosted);
+
+    // thread-safe versions of SetSeriesData(), SetSeriesValue(),
+    // AppendData() and PushLiveValues(), the data are moved
+    void PostSeriesData(const size_t seriesIdx, std::vector<double>&& data);
+    void PostSeriesValue(const size_t seriesIdx, const size_t valueIdx, const double value);
+    void PostAppendData(std::vector<wxString>&& variableNames, std::vector<std::vector<double>>&& seriesData);
+    void PostAppendData(std::vector<int64_t>&& timestamps, std::vector<std::vector<double>>&& seriesData);
+    void PostLiveValues(const int64_t timestamp, std::vector<double>&& values);
+
+    struct AppliedUpdates
+    {
+        size_t appliedCount{0};
+        // superseded by a later update of the whole series data
+        size_t coalescedCount{0};
+        // not valid for the data when applied, e.g., posted before they
+        // were replaced, or live values with an older timestamp
+        size_t rejectedCount{0};
+        // the number of variables appended
+        size_t appendedCount{0};
+        bool valuesChanged{false};
+        bool liveValuesPushed{false};
+    };
+
+    // applies all the updates posted so far, called only from the GUI thread;
+    // the caller then updates the chart with RunChartUpdateSeries() once
+    // and the grid according to the result
+    AppliedUpdates ApplyPostedUpdates();
+    // the updates not applied yet are discarded
+    void DiscardPostedUpdates();
+
+    // publishes the snapshot of the current data (see ChartSnapshot), called only
+    // from the GUI thread; returns the previous snapshot if nothing changed
+    std::shared_ptr<const ChartSnapshot> PublishSnapshot();
+    // the snapshot published last or nullptr, can be called from any thread
+    std::shared_ptr<const ChartSnapshot> GetSnapshot() const;
+
+    // as shown for a variable in time mode
+    static wxString FormatTimestamp(const int64_t timestamp);
+
     static bool JSONToColors(const wxString& JSONStr, std::vector<wxColour>& colors);
     static bool JSONToSizingOptions(const wxString& JSONStr, double& widthToHeightRatio,
                                     int& minWidth, int& minHeight);
+    // the colors or sizing options can be missing, colors are then empty
+    static bool JSONToChartOptions(const wxString& JSONStr, std::vector<wxColour>& colors,
+                                   bool& hasSizingOptions, double& widthToHeightRatio,
+                                   int& minWidth, int& minHeight);
 private:
     wxWebView* m_webView{nullptr};
     std::vector<wxString> m_variableNames;
+    std::vector<int64_t> m_timestamps; // in time mode instead of m_variableNames
     std::vector<ValueSeries> m_series;
+    std::vector<SeriesPyramid> m_pyramids; // one for each item in m_series
+    // shared with the snapshots
+    std::shared_ptr<ChartDataFile> m_dataFile;
+
+    // live mode, m_series contain only names and types
+    struct LiveData
+    {
+        RingBuffer<int64_t> timestamps;
+        std::vector<RingBuffer<double>> values; // one for each item in m_series
+        size_t pushedCount{0}; // values pushed since the last chart update
+        size_t chartCount{0};  // values in the chart
+        bool chartInitialized{false};
+        std::unique_ptr<SharedRingBuffer> sharedRingBuffer;
+    };
+    std::unique_ptr<LiveData> m_live;
+
+    // mirror of the chart options, see GetChartColors()
+    std::vector<wxColour> m_chartColors; // empty when not known
+    bool m_hasChartSizingOptions{false};
+    double m_chartWidthToHeightRatio{1};
+    int m_chartMinWidth{0};
+    int m_chartMinHeight{0};
+
+    bool m_resizeSettleMode{false};
+    int m_resizeSettleDelay{DefaultResizeSettleDelay};
+
+    // the automatic rendering options
+    static constexpr size_t SVGMaxValueCount = 5000;
+    // the canvas is switched back to SVG only with this many values or fewer
+    static constexpr size_t SVGReturnValueCount = 2500;
+    static constexpr size_t AnimationMaxValueCount = 2000;
+    static constexpr size_t LargeMinValueCount = 50000;
+    static constexpr size_t ProgressiveValueCount = 5000;
+    static constexpr double MaxDevicePixelRatio = 2;
+    // in milliseconds, the load level is raised above the slow time
+    // and can be lowered below the fast one
+    static constexpr double SlowRenderTime = 50;
+    static constexpr double FastRenderTime = 16;
+
+    bool m_automaticRendering{true};
+    RenderingOptions m_renderingOptions;
+    int m_renderingLoadLevel{0};
+    // the number of values in the chart when the load level was raised
+    size_t m_renderingLoadValueCount{0};
+    size_t m_chartValueCount{0};
+    // the moving average in milliseconds, 0 when not measured yet
+    double m_renderTime{0};
+    double m_devicePixelRatio{1};
+    // the options sent to the chart last
+    bool m_chartHasRenderingOptions{false};
+    RenderingOptions m_chartRenderingOptions;
+
+    // the number of values the chart shows with the current data
+    size_t GetChartValueCount() const;
+    // chooses the automatic options for the number of values, if they
+    // are not overridden, and sends the options if they changed
+    void UpdateRenderingOptions(const size_t valueCount);
+    void RunChartSendRenderingOptions();
+
+    bool m_chartShown{true};
+    // the updates not sent while the chart was hidden
+    bool m_seriesUpdateSuspended{false};
+    bool m_variableNamesUpdateSuspended{false};
+
+    size_t m_LODThreshold{DefaultLODThreshold};
+    bool m_chartHasVariableNames{false};
+    bool m_LODWasActive{false};
+    // visible range of variables [m_LODFirst, m_LODLast) in LOD mode
+    size_t m_LODFirst{0};
+    size_t m_LODLast{0};
+    bool m_LODWindowSynced{false}; // the chart zoom window shows the visible range
+    int m_LODChartWidth{1000};
+
+    struct PostedUpdate
+    {
+        enum Type
+        {
+            SeriesData,
+            SeriesValue,
+            AppendedNames,
+            AppendedTimestamps,
+            LiveValues,
+        };
+
+        Type type{SeriesData};
+        size_t seriesIdx{0};
+        size_t valueIdx{0};
+        double value{0};
+        int64_t timestamp{0};
+        std::vector<double> values; // SeriesData and LiveValues
+        std::vector<wxString> variableNames;
+        std::vector<int64_t> timestamps;
+        std::vector<std::vector<double>> seriesData;
+    };
+
+    MPSCQueue<PostedUpdate> m_postedUpdates;
+    // incremented after an update is pushed, so that applying the updates
+    // does not go on forever while the workers keep posting
+    std::atomic<size_t> m_postedUpdateCount{0};
+    size_t m_poppedUpdateCount{0};
+    // set when the posted updates handler was called, until the updates are applied
+    std::atomic<bool> m_postedUpdatesScheduled{false};
+    std::function<void()> m_onUpdatesPosted;
+
+    // accessed atomically
+    std::shared_ptr<const ChartSnapshot> m_snapshot;
+    uint64_t m_snapshotVersion{0};
+    // the changes since the last published snapshot: the chunks not
+    // changed are shared with it, changes of the sizes need no tracking
+    bool m_snapshotChanged{true};
+    bool m_snapshotDataReplaced{true};
+    // [first, last) changed in place, first > last if none
+    struct ChangedRange
+    {
+        size_t first{SIZE_MAX};
+        size_t last{0};
+
+        void Add(const size_t addFirst, const size_t addLast);
+    };
+    ChangedRange m_snapshotChangedNames;
+    std::vector<ChangedRange> m_snapshotChangedValues; // for each series
+
+    void SetSnapshotChanged();
+    void SetSnapshotValuesChanged(const size_t seriesIdx, const size_t first, const size_t last);
+
+    void PostUpdate(PostedUpdate&& update);
+    // pops the updates posted before the call
+    void PopPostedUpdates(std::vector<PostedUpdate>& updates);
+    // the preconditions of the corresponding setters, checked without asserting
+    bool CanApplyUpdate(const PostedUpdate& update) const;
+    void ApplyUpdate(PostedUpdate& update, AppliedUpdates& result);
+
+    // the timestamps are either in m_timestamps or m_dataFile
+    const int64_t* GetTimestamps() const;
+    // the values are either in m_series or m_dataFile
+    const double* GetValues(const size_t seriesIdx) const;
+
+    bool AppendSeriesData(const size_t count, const std::vector<std::vector<double>>& seriesData);
+    // values must contain a value for each series
+    void PushLiveRow(const int64_t timestamp, const double* values);
+
+    void RunChartUpdateSeriesLive();
+
+    // one series update, prepared from the snapshot either in the GUI thread
+    // or in a worker thread of the update pipeline; the stages after
+    // PrepareSeriesUpdateLOD() use only the frame and can run in any thread
+    struct SeriesUpdateFrame
+    {
+        std::shared_ptr<const ChartSnapshot> snapshot;
+        bool LOD{false};
+        // the visible range of variables [LODFirst, LODLast) in LOD mode
+        size_t LODFirst{0};
+        size_t LODLast{0};
+        size_t maxBuckets{0};
+        bool sendWindow{false};
+        bool sendNames{false};
+        // the LOD buckets for each series, those of the data in memory are
+        // obtained in the GUI thread, as their pyramids are updated there
+        std::vector<std::vector<SeriesPyramid::Bucket>> buckets;
+        // the hashes of the series sent last, the series serialized with
+        // the same hash are not sent again (only with variable names)
+        std::vector<uint64_t> sentSeriesHashes;
+        std::vector<uint64_t> seriesHashes;
+        std::vector<char> seriesOmitted;
+        size_t omittedBytes{0};
+        wxString script;
+        uint64_t scriptHash{0};
+        size_t scriptBytes{0};
+    };
+
+    // the updates with fewer values are not worth sending to a worker thread
+    static constexpr size_t AsyncUpdateMinValueCount = 100000;
+    // one worker prepares the next update while another one is still preparing
+    // the previous update or the chart shows it
+    static constexpr size_t UpdateWorkerCount = 2;
+
+    // the series are serialized in parallel, each into its own buffer
+    struct SerializeBuffers;
+    struct SerializeContext;
+
+    std::unique_ptr<SerializeContext> m_serializeContext;
+    std::function<void()> m_onChartUpdateReady;
+    std::unique_ptr<UpdatePipeline<SeriesUpdateFrame>> m_updatePipeline;
+
+    void PrepareSeriesUpdateLOD(SeriesUpdateFrame& frame);
+    static size_t GetSeriesUpdateValueCount(const SeriesUpdateFrame& frame);
+    // the transform stage, obtains the LOD buckets of the data file
+    static void TransformSeriesUpdate(SeriesUpdateFrame& frame);
+    // the serialize stage, creates the script
+    static void SerializeSeriesUpdate(SeriesUpdateFrame& frame, SerializeContext& context);
+    void RunSeriesUpdate(SeriesUpdateFrame& frame);
+    void CancelSeriesUpdates();
+
+    // the hash of the content sent to the chart last
+    struct SentContent
+    {
+        bool sent{false};
+        uint64_t hash{0};
+
+        bool IsSame(const uint64_t contentHash) const { return sent && hash == contentHash; }
+    };
+
+    SentContent m_sentVariableNames;
+    SentContent m_sentColors;
+    SentContent m_sentSizingOptions;
+    SentContent m_sentSeriesScript;
+    // of each series sent last with variable names, empty after other updates
+    std::vector<uint64_t> m_sentSeriesHashes;
+    SentUpdateStats m_sentUpdateStats;
+
+    // returns false when the content is the same as sent last,
+    // otherwise remembers its hash; counts the bytes either way
+    bool UpdateSentContent(SentContent& sentContent, const std::string& content);
+    // after the chart was created or changed in other ways
+    void ResetSentContent();
 };
\ No newline at end of file
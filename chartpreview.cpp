@@ -0,0 +1,493 @@
+///////////////////////////////////////////////////////////////////////////////
+// Project:     wxECharts
+// Home:        https://github.com/PBfordev/wxecharts
+// File Name:   chartpreview.cpp
+// Purpose:     Implementation of native chart preview renderer
+// Author:      PB
+// Created:     2026-10-18
+// Copyright:   (c) 2026 PB
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#include <wx/wx.h>
+#include <wx/graphics.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+
+#include "chartpreview.h"
+#include "chartsnapshot.h"
+
+using namespace std;
+
+namespace {
+
+// in pixels
+constexpr double Margin = 8;
+constexpr double TickLength = 4;
+constexpr double LegendMarkerSize = 10;
+constexpr int YTickCount = 5;
+// of the slot of one variable
+constexpr double BarGroupWidth = 0.8;
+
+// the minimum, maximum and the first and last value of the values
+// falling into one pixel column
+struct ColumnValues
+{
+    double min{numeric_limits<double>::infinity()};
+    double max{-numeric_limits<double>::infinity()};
+    double first{0};
+    double last{0};
+
+    bool IsEmpty() const { return min > max; }
+
+    void Add(const double value)
+    {
+        if ( IsEmpty() )
+            first = value;
+        last = value;
+        min = std::min(min, value);
+        max = std::max(max, value);
+    }
+};
+
+// about range / count rounded to 1, 2 or 5 times a power of ten
+double GetNiceStep(const double range, const int count)
+{
+    const double roughStep = range / count;
+    const double magnitude = pow(10, floor(log10(roughStep)));
+    const double fraction = roughStep / magnitude;
+
+    if ( fraction <= 1 )
+        return magnitude;
+    if ( fraction <= 2 )
+        return 2 * magnitude;
+    if ( fraction <= 5 )
+        return 5 * magnitude;
+    return 10 * magnitude;
+}
+
+// maps the chart values and variables to the pixels of the plot area
+class PlotMapping
+{
+public:
+    PlotMapping(const ChartSnapshot& snapshot, const wxRect2DDouble& plot,
+                const double minValue, const double maxValue)
+        : m_snapshot(snapshot), m_plot(plot), m_minValue(minValue), m_maxValue(maxValue)
+    {
+        const size_t count = snapshot.GetVariableCount();
+
+        m_timeMode = snapshot.IsTimeMode() && count > 1
+                     && snapshot.GetTimestamps()[count - 1] > snapshot.GetTimestamps()[0];
+        if ( m_timeMode )
+        {
+            m_firstTimestamp = snapshot.GetTimestamps()[0];
+            m_timeRange = static_cast<double>(snapshot.GetTimestamps()[count - 1] - m_firstTimestamp);
+        }
+        m_slotWidth = count > 0 ? plot.m_width / count : plot.m_width;
+    }
+
+    // the width of one variable in category mode
+    double GetSlotWidth() const { return m_slotWidth; }
+
+    // the centers of the variable slots, or by the timestamps
+    double GetX(const size_t idx) const
+    {
+        if ( m_timeMode )
+            return m_plot.m_x + (m_snapshot.GetTimestamps()[idx] - m_firstTimestamp) / m_timeRange * m_plot.m_width;
+        return m_plot.m_x + (idx + 0.5) * m_slotWidth;
+    }
+
+    double GetY(const double value) const
+    {
+        return m_plot.GetBottom() - (value - m_minValue) / (m_maxValue - m_minValue) * m_plot.m_height;
+    }
+
+    size_t GetColumn(const double x) const
+    {
+        const double column = floor(x - m_plot.m_x);
+
+        return static_cast<size_t>(max(0.0, min(column, GetColumnCount() - 1.0)));
+    }
+
+    size_t GetColumnCount() const
+    {
+        return static_cast<size_t>(max(1.0, ceil(m_plot.m_width)));
+    }
+
+    double GetColumnX(const size_t column) const
+    {
+        return m_plot.m_x + column + 0.5;
+    }
+private:
+    const ChartSnapshot& m_snapshot;
+    wxRect2DDouble m_plot;
+    double m_minValue;
+    double m_maxValue;
+    bool m_timeMode{false};
+    int64_t m_firstTimestamp{0};
+    double m_timeRange{1};
+    double m_slotWidth{1};
+};
+
+// aggregates the values of the series into the pixel columns,
+// from the buckets instead of the values when there are any
+vector<ColumnValues> GetColumnValues(const ChartSnapshot::Series& series,
+                                     const vector<SeriesPyramid::Bucket>* buckets,
+                                     const PlotMapping& mapping)
+{
+    vector<ColumnValues> columns(mapping.GetColumnCount());
+    size_t idx = 0;
+
+    if ( buckets )
+    {
+        for ( const auto& bucket : *buckets )
+        {
+            ColumnValues& column = columns[mapping.GetColumn(mapping.GetX(bucket.first))];
+
+            // a bucket with only missing values is empty
+            if ( std::isfinite(bucket.value.min) )
+                column.Add(bucket.value.min);
+            if ( std::isfinite(bucket.value.max) )
+                column.Add(bucket.value.max);
+        }
+        return columns;
+    }
+
+    series.values.ForEachChunk(0, series.values.GetSize(), [&](const double* values, const size_t count)
+    {
+        for ( size_t i = 0; i < count; ++i, ++idx )
+        {
+            if ( std::isfinite(values[i]) )
+                columns[mapping.GetColumn(mapping.GetX(idx))].Add(values[i]);
+        }
+    });
+    return columns;
+}
+
+void DrawLineSeries(wxGraphicsContext& gc, const ChartSnapshot::Series& series,
+                    const vector<SeriesPyramid::Bucket>* buckets, const PlotMapping& mapping)
+{
+    const size_t count = series.values.GetSize();
+    wxGraphicsPath path = gc.CreatePath();
+    bool penDown = false;
+
+    auto addPoint = [&path, &penDown](const double x, const double y)
+    {
+        if ( penDown )
+            path.AddLineToPoint(x, y);
+        else
+            path.MoveToPoint(x, y);
+        penDown = true;
+    };
+
+    if ( count <= 2 * mapping.GetColumnCount() )
+    {
+        for ( size_t i = 0; i < count; ++i )
+        {
+            const double value = series.values[i];
+
+            // missing values break the line, as in the chart
+            if ( !std::isfinite(value) )
+                penDown = false;
+            else
+                addPoint(mapping.GetX(i), mapping.GetY(value));
+        }
+    }
+    else
+    {
+        const vector<ColumnValues> columns = GetColumnValues(series, buckets, mapping);
+
+        for ( size_t c = 0; c < columns.size(); ++c )
+        {
+            const ColumnValues& column = columns[c];
+            const double x = mapping.GetColumnX(c);
+
+            if ( column.IsEmpty() )
+            {
+                penDown = false;
+                continue;
+            }
+            addPoint(x, mapping.GetY(column.first));
+            path.AddLineToPoint(x, mapping.GetY(column.min));
+            path.AddLineToPoint(x, mapping.GetY(column.max));
+            path.AddLineToPoint(x, mapping.GetY(column.last));
+        }
+    }
+
+    gc.StrokePath(path);
+}
+
+// barIdx of barCount bar series
+void DrawBarSeries(wxGraphicsContext& gc, const ChartSnapshot::Series& series,
+                   const vector<SeriesPyramid::Bucket>* buckets, const PlotMapping& mapping,
+                   const size_t barIdx, const size_t barCount)
+{
+    const size_t count = series.values.GetSize();
+    const double barWidth = mapping.GetSlotWidth() * BarGroupWidth / barCount;
+    const double zeroY = mapping.GetY(0);
+    wxGraphicsPath path = gc.CreatePath();
+
+    if ( barWidth >= 1 )
+    {
+        for ( size_t i = 0; i < count; ++i )
+        {
+            const double value = series.values[i];
+
+            if ( !std::isfinite(value) )
+                continue;
+
+            const double x = mapping.GetX(i) - mapping.GetSlotWidth() * BarGroupWidth / 2 + barIdx * barWidth;
+            const double y = mapping.GetY(value);
+
+            path.AddRectangle(x, min(y, zeroY), barWidth, fabs(zeroY - y));
+        }
+    }
+    else
+    {
+        // the bars are thinner than a pixel, each column shows
+        // the range of the bars in it, including zero
+        const vector<ColumnValues> columns = GetColumnValues(series, buckets, mapping);
+
+        for ( size_t c = 0; c < columns.size(); ++c )
+        {
+            const ColumnValues& column = columns[c];
+
+            if ( column.IsEmpty() )
+                continue;
+
+            const double top = mapping.GetY(max(column.max, 0.0));
+            const double bottom = mapping.GetY(min(column.min, 0.0));
+
+            path.AddRectangle(mapping.GetColumnX(c) - 0.5, top, 1, bottom - top);
+        }
+    }
+
+    gc.FillPath(path);
+}
+
+} // anonymous namespace
+
+std::vector<wxColour> ChartPreview::GetDefaultColors()
+{
+    return { wxColour("#5470c6"), wxColour("#91cc75"), wxColour("#fac858"),
+             wxColour("#ee6666"), wxColour("#73c0de"), wxColour("#3ba272"),
+             wxColour("#fc8452"), wxColour("#9a60b4"), wxColour("#ea7ccc") };
+}
+
+void ChartPreview::Draw(wxGraphicsContext& gc, const wxRect2DDouble& rect,
+                        const ChartSnapshot& snapshot, const std::vector<wxColour>& colors)
+{
+    const vector<wxColour> seriesColors = colors.empty() ? GetDefaultColors() : colors;
+    const size_t seriesCount = snapshot.GetSeriesCount();
+    const size_t variableCount = snapshot.GetVariableCount();
+    size_t barCount = 0;
+    double minValue = numeric_limits<double>::infinity();
+    double maxValue = -numeric_limits<double>::infinity();
+    // the values in a data file can take gigabytes, so they are not all read:
+    // at least two buckets for each pixel column are obtained from the pyramids
+    vector<vector<SeriesPyramid::Bucket>> dataFileBuckets(seriesCount);
+    const size_t minBuckets = 2 * static_cast<size_t>(max(1.0, ceil(rect.m_width)));
+    bool dataFile = false;
+
+    for ( size_t s = 0; s < seriesCount; ++s )
+    {
+        const ChartSnapshot::Series& series = snapshot.GetSeries(s);
+
+        if ( series.type == ChartHelper::Bar )
+        {
+            // the bars start at zero
+            barCount++;
+            minValue = min(minValue, 0.0);
+            maxValue = max(maxValue, 0.0);
+        }
+
+        dataFile = snapshot.GetDataFileBuckets(s, minBuckets, dataFileBuckets[s]);
+        if ( dataFile )
+        {
+            for ( const auto& bucket : dataFileBuckets[s] )
+            {
+                if ( std::isfinite(bucket.value.min) )
+                    minValue = min(minValue, bucket.value.min);
+                if ( std::isfinite(bucket.value.max) )
+                    maxValue = max(maxValue, bucket.value.max);
+            }
+            continue;
+        }
+
+        series.values.ForEachChunk(0, series.values.GetSize(), [&](const double* values, const size_t count)
+        {
+            for ( size_t i = 0; i < count; ++i )
+            {
+                if ( std::isfinite(values[i]) )
+                {
+                    minValue = min(minValue, values[i]);
+                    maxValue = max(maxValue, values[i]);
+                }
+            }
+        });
+    }
+
+    if ( minValue > maxValue )
+    {
+        minValue = 0;
+        maxValue = 1;
+    }
+    else if ( minValue == maxValue )
+    {
+        const double delta = minValue != 0 ? fabs(minValue) / 10 : 1;
+
+        minValue -= delta;
+        maxValue += delta;
+    }
+
+    const double yStep = GetNiceStep(maxValue - minValue, YTickCount);
+
+    minValue = floor(minValue / yStep) * yStep;
+    maxValue = ceil(maxValue / yStep) * yStep;
+
+    gc.SetFont(*wxNORMAL_FONT, *wxBLACK);
+
+    double textHeight = 0;
+
+    gc.GetTextExtent("Xg", nullptr, &textHeight);
+
+    // the legend on the top
+    double legendX = rect.m_x + Margin;
+    const double legendY = rect.m_y + Margin;
+
+    gc.SetPen(*wxTRANSPARENT_PEN);
+    for ( size_t s = 0; s < seriesCount; ++s )
+    {
+        const wxString& name = snapshot.GetSeries(s).name;
+        double nameWidth = 0;
+
+        gc.GetTextExtent(name, &nameWidth, nullptr);
+        if ( legendX + LegendMarkerSize + Margin / 2 + nameWidth > rect.GetRight() - Margin )
+            break;
+
+        gc.SetBrush(wxBrush(seriesColors[s % seriesColors.size()]));
+        gc.DrawRectangle(legendX, legendY + (textHeight - LegendMarkerSize) / 2, LegendMarkerSize, LegendMarkerSize);
+        legendX += LegendMarkerSize + Margin / 2;
+        gc.DrawText(name, legendX, legendY);
+        legendX += nameWidth + 2 * Margin;
+    }
+
+    // the y axis labels on the left
+    vector<wxString> yLabels;
+    double yLabelsWidth = 0;
+
+    for ( int i = 0; minValue + i * yStep <= maxValue + yStep / 2; ++i )
+    {
+        const wxString label = wxString::Format("%g", round((minValue + i * yStep) / yStep) * yStep);
+        double labelWidth = 0;
+
+        gc.GetTextExtent(label, &labelWidth, nullptr);
+        yLabelsWidth = max(yLabelsWidth, labelWidth);
+        yLabels.push_back(label);
+    }
+
+    wxRect2DDouble plot;
+
+    plot.m_x = rect.m_x + Margin + yLabelsWidth + TickLength + Margin / 2;
+    plot.m_y = legendY + textHeight + 2 * Margin;
+    plot.m_width = rect.GetRight() - Margin - plot.m_x;
+    plot.m_height = rect.GetBottom() - Margin - textHeight - TickLength - plot.m_y;
+
+    if ( plot.m_width < 1 || plot.m_height < 1 )
+        return;
+
+    const PlotMapping mapping(snapshot, plot, minValue, maxValue);
+
+    // the grid and y axis
+    gc.SetPen(wxPen(wxColour(224, 230, 241)));
+    for ( size_t i = 0; i < yLabels.size(); ++i )
+    {
+        const double y = mapping.GetY(minValue + i * yStep);
+        double labelWidth = 0;
+
+        gc.StrokeLine(plot.m_x - TickLength, y, plot.GetRight(), y);
+        gc.GetTextExtent(yLabels[i], &labelWidth, nullptr);
+        gc.DrawText(yLabels[i], plot.m_x - TickLength - Margin / 2 - labelWidth, y - textHeight / 2);
+    }
+
+    gc.SetPen(*wxBLACK_PEN);
+    gc.StrokeLine(plot.m_x, plot.m_y, plot.m_x, plot.GetBottom());
+    gc.StrokeLine(plot.m_x, plot.GetBottom(), plot.GetRight(), plot.GetBottom());
+
+    // the x axis labels, as many as fit
+    if ( variableCount > 0 )
+    {
+        double sampleWidth = 0;
+
+        gc.GetTextExtent(snapshot.GetVariableName(variableCount - 1), &sampleWidth, nullptr);
+
+        const size_t maxLabelCount = max<size_t>(1, static_cast<size_t>(plot.m_width / (sampleWidth + 2 * Margin)));
+        const size_t labelStep = (variableCount + maxLabelCount - 1) / maxLabelCount;
+        double lastLabelRight = -numeric_limits<double>::infinity();
+
+        for ( size_t i = 0; i < variableCount; i += labelStep )
+        {
+            const wxString label = snapshot.GetVariableName(i);
+            const double x = mapping.GetX(i);
+            double labelWidth = 0;
+
+            gc.GetTextExtent(label, &labelWidth, nullptr);
+            if ( x - labelWidth / 2 < lastLabelRight + Margin || x + labelWidth / 2 > rect.GetRight() )
+                continue;
+
+            gc.StrokeLine(x, plot.GetBottom(), x, plot.GetBottom() + TickLength);
+            gc.DrawText(label, x - labelWidth / 2, plot.GetBottom() + TickLength);
+            lastLabelRight = x + labelWidth / 2;
+        }
+    }
+
+    // the series, clipped to the plot
+    gc.PushState();
+    gc.Clip(plot.m_x, plot.m_y, plot.m_width, plot.m_height);
+
+    size_t barIdx = 0;
+
+    for ( size_t s = 0; s < seriesCount; ++s )
+    {
+        const ChartSnapshot::Series& series = snapshot.GetSeries(s);
+        const wxColour& color = seriesColors[s % seriesColors.size()];
+        const vector<SeriesPyramid::Bucket>* buckets = dataFile ? &dataFileBuckets[s] : nullptr;
+
+        if ( series.type == ChartHelper::Bar )
+        {
+            gc.SetPen(*wxTRANSPARENT_PEN);
+            gc.SetBrush(wxBrush(color));
+            DrawBarSeries(gc, series, buckets, mapping, barIdx++, barCount);
+        }
+        else
+        {
+            gc.SetPen(wxPen(color, 2));
+            gc.SetBrush(*wxTRANSPARENT_BRUSH);
+            DrawLineSeries(gc, series, buckets, mapping);
+        }
+    }
+
+    gc.PopState();
+}
+
+wxImage ChartPreview::Render(const ChartSnapshot& snapshot, const std::vector<wxColour>& colors,
+                             const wxSize& size)
+{
+    wxCHECK_MSG(size.x > 0 && size.y > 0, wxImage(), "invalid size");
+
+    wxImage image(size);
+
+    image.SetRGB(wxRect(size), 255, 255, 255);
+
+    {
+        unique_ptr<wxGraphicsContext> gc(wxGraphicsContext::Create(image));
+
+        wxCHECK_MSG(gc, wxImage(), "could not create graphics context");
+        Draw(*gc, wxRect2DDouble(0, 0, size.x, size.y), snapshot, colors);
+    } // the drawing is copied to the image when the context is destroyed
+
+    return image;
+}
@@ -0,0 +1,57 @@
+///////////////////////////////////////////////////////////////////////////////
+// Project:     wxECharts
+// Home:        https://github.com/PBfordev/wxecharts
+// File Name:   chartpreview.h
+// Purpose:     Declaration of native chart preview renderer
+// Author:      PB
+// Created:     2026-10-18
+// Copyright:   (c) 2026 PB
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <vector>
+
+#include <wx/colour.h>
+#include <wx/geometry.h>
+#include <wx/image.h>
+
+class ChartSnapshot;
+class wxGraphicsContext;
+
+/*****************************************************************
+
+ChartPreview
+---------------
+draws the bar and line series of a chart snapshot natively with
+wxGraphicsContext, without the webview
+
+The preview is meant for thumbnails, print previews or as a
+placeholder while the webview is loading, it only resembles the
+chart: it has the axes, the legend and the variable names (or
+timestamps) when they fit, but no zooming, tooltips and so on.
+
+Each series is drawn with at most a few points per pixel column:
+when it has more values than the columns, only the minimum and
+maximum of each column are drawn. The values in a data file are not
+all read, they are aggregated with its min/max pyramids instead, see
+ChartSnapshot::GetDataFileBuckets(); the values in memory are read
+once.
+
+******************************************************************/
+
+class ChartPreview final
+{
+public:
+    // the ECharts default palette, used when colors is empty
+    static std::vector<wxColour> GetDefaultColors();
+
+    // draws the chart into rect, the series use colors in turn
+    static void Draw(wxGraphicsContext& gc, const wxRect2DDouble& rect,
+                     const ChartSnapshot& snapshot, const std::vector<wxColour>& colors);
+
+    // returns the chart drawn on white background
+    static wxImage Render(const ChartSnapshot& snapshot, const std::vector<wxColour>& colors,
+                          const wxSize& size);
+};
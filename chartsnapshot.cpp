@@ -0,0 +1,81 @@
+///////////////////////////////////////////////////////////////////////////////
+// Project:     wxECharts
+// Home:        https://github.com/PBfordev/wxecharts
+// File Name:   chartsnapshot.cpp
+// Purpose:     Implementation of immutable snapshot of chart data
+// Author:      PB
+// Created:     2026-10-18
+// Copyright:   (c) 2026 PB
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#include <wx/wx.h>
+
+#include "chartdatafile.h"
+#include "chartsnapshot.h"
+
+// passed by reference to std::min() in Column
+constexpr size_t ChartSnapshot::ChunkSize;
+
+uint64_t ChartSnapshot::GetVersion() const
+{
+    return m_version;
+}
+
+size_t ChartSnapshot::GetVariableCount() const
+{
+    return m_variableCount;
+}
+
+bool ChartSnapshot::IsTimeMode() const
+{
+    return m_timeMode;
+}
+
+wxString ChartSnapshot::GetVariableName(const size_t idx) const
+{
+    wxCHECK(idx < m_variableCount, wxString());
+
+    if ( m_timeMode )
+        return ChartHelper::FormatTimestamp(m_timestamps[idx]);
+    if ( m_dataFile && m_dataFile->GetVariablesType() == ChartDataFile::VariableNames )
+        return m_dataFile->GetVariableName(idx);
+    // variables in a data file can be identified only by their index
+    if ( m_dataFile )
+        return wxString::Format("%zu", idx);
+    return m_variableNames[idx];
+}
+
+const ChartSnapshot::Column<int64_t>& ChartSnapshot::GetTimestamps() const
+{
+    return m_timestamps;
+}
+
+size_t ChartSnapshot::GetSeriesCount() const
+{
+    return m_series.size();
+}
+
+const ChartSnapshot::Series& ChartSnapshot::GetSeries(const size_t seriesIdx) const
+{
+    wxASSERT(seriesIdx < m_series.size());
+    return m_series[seriesIdx];
+}
+
+bool ChartSnapshot::GetDataFileBuckets(const size_t seriesIdx, const size_t minBuckets,
+                                       std::vector<SeriesPyramid::Bucket>& buckets) const
+{
+    wxCHECK(seriesIdx < m_series.size(), false);
+
+    if ( !m_dataFile )
+        return false;
+
+    const double* values = m_dataFile->GetSeriesValues(seriesIdx);
+    const SeriesPyramid* pyramid = m_dataFile->GetSeriesPyramid(seriesIdx);
+
+    if ( pyramid )
+        pyramid->GetLevelBuckets(values, minBuckets, buckets);
+    else
+        SeriesPyramid::GetSampledBuckets(values, 0, m_variableCount, minBuckets, buckets);
+    return true;
+}
@@ -0,0 +1,206 @@
+///////////////////////////////////////////////////////////////////////////////
+// Project:     wxECharts
+// Home:        https://github.com/PBfordev/wxecharts
+// File Name:   chartsnapshot.h
+// Purpose:     Declaration of immutable snapshot of chart data
+// Author:      PB
+// Created:     2026-10-18
+// Copyright:   (c) 2026 PB
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <wx/string.h>
+
+#include "charthelper.h"
+#include "seriespyramid.h"
+
+class ChartDataFile;
+
+/*****************************************************************
+
+ChartSnapshot
+---------------
+immutable version of the chart data published by ChartHelper,
+see ChartHelper::PublishSnapshot()
+
+A published snapshot never changes, so any number of threads can
+read it without locking, while the GUI thread keeps modifying
+the data in ChartHelper.
+
+The values, variable names and timestamps are stored in columns
+made of chunks of ChunkSize items (except the last one), which
+are shared by the snapshots: when a new snapshot is published,
+only the chunks changed since the previous one are copied. The
+data in a data file are not copied at all, the columns point
+to them and the snapshot keeps the file open.
+
+******************************************************************/
+
+class ChartSnapshot final
+{
+public:
+    static constexpr size_t ChunkSize = 64 * 1024;
+
+    template <typename T>
+    class Column final
+    {
+    public:
+        size_t GetSize() const { return m_size; }
+
+        const T& operator[](const size_t idx) const
+        {
+            // a column pointing to a data file has one chunk of any size
+            if ( m_chunks.size() == 1 )
+                return m_chunks[0].items[idx];
+            return m_chunks[idx / ChunkSize].items[idx % ChunkSize];
+        }
+
+        // calls f(const T* items, size_t count) for the contiguous parts of [first, last)
+        template <typename F>
+        void ForEachChunk(const size_t first, const size_t last, F f) const
+        {
+            size_t chunkFirst = 0;
+
+            for ( const auto& chunk : m_chunks )
+            {
+                if ( chunkFirst >= last )
+                    break;
+
+                const size_t chunkLast = chunkFirst + chunk.count;
+
+                if ( chunkLast > first )
+                {
+                    const size_t from = std::max(first, chunkFirst);
+
+                    f(chunk.items + (from - chunkFirst), std::min(last, chunkLast) - from);
+                }
+                chunkFirst = chunkLast;
+            }
+        }
+    private:
+        friend class ChartHelper;
+
+        struct Chunk
+        {
+            // keeps the items alive, either a vector or a data file
+            std::shared_ptr<const void> owner;
+            const T* items;
+            size_t count;
+        };
+
+        std::vector<Chunk> m_chunks;
+        size_t m_size{0};
+
+        // copies the items, except for the chunks of the previous column
+        // with the same size and no items in [changedFirst, changedLast),
+        // the previous column must not point to a data file
+        void Assign(const T* items, const size_t count,
+                    const Column* previous, const size_t changedFirst, const size_t changedLast)
+        {
+            m_chunks.clear();
+            m_size = count;
+
+            for ( size_t first = 0, chunkIdx = 0; first < count; first += ChunkSize, ++chunkIdx )
+            {
+                const size_t chunkCount = std::min(ChunkSize, count - first);
+
+                if ( previous && chunkIdx < previous->m_chunks.size() )
+                {
+                    const Chunk& previousChunk = previous->m_chunks[chunkIdx];
+
+                    if ( previousChunk.count == chunkCount
+                         && (changedLast <= first || changedFirst >= first + chunkCount) )
+                    {
+                        m_chunks.push_back(previousChunk);
+                        continue;
+                    }
+                }
+
+                AddChunk(items + first, chunkCount);
+            }
+        }
+
+        // copies the items returned by getItem(idx)
+        template <typename Getter>
+        void AssignCopy(const size_t count, Getter getItem)
+        {
+            m_chunks.clear();
+            m_size = count;
+
+            for ( size_t first = 0; first < count; first += ChunkSize )
+            {
+                const size_t chunkCount = std::min(ChunkSize, count - first);
+                std::shared_ptr<std::vector<T>> items(new std::vector<T>());
+
+                items->reserve(chunkCount);
+                for ( size_t i = first; i < first + chunkCount; ++i )
+                    items->push_back(getItem(i));
+                m_chunks.push_back({items, items->data(), chunkCount});
+            }
+        }
+
+        void AssignExternal(const std::shared_ptr<const void>& owner, const T* items, const size_t count)
+        {
+            m_chunks.clear();
+            m_size = count;
+            if ( count > 0 )
+                m_chunks.push_back({owner, items, count});
+        }
+
+        void AddChunk(const T* items, const size_t count)
+        {
+            std::shared_ptr<std::vector<T>> chunkItems(new std::vector<T>(items, items + count));
+
+            m_chunks.push_back({chunkItems, chunkItems->data(), count});
+        }
+    };
+
+    struct Series
+    {
+        wxString name;
+        ChartHelper::SeriesType type{ChartHelper::Bar};
+        ChartHelper::ValuePrecision precision;
+        Column<double> values;
+    };
+
+    // increases with every published snapshot
+    uint64_t GetVersion() const;
+
+    size_t GetVariableCount() const;
+    bool IsTimeMode() const;
+    // formatted the same as ChartHelper::GetVariableName()
+    wxString GetVariableName(const size_t idx) const;
+    // empty when not in time mode
+    const Column<int64_t>& GetTimestamps() const;
+
+    size_t GetSeriesCount() const;
+    const Series& GetSeries(const size_t seriesIdx) const;
+
+    // aggregates the values of the series in a data file, which can be much
+    // larger than the memory, to at least minBuckets min/max buckets (up to
+    // SeriesPyramid::Fanout times more) taken from its pyramid, without
+    // reading the values; until the pyramids are built, there are minBuckets
+    // buckets, each with only its first value; returns false when the data
+    // are not in a data file
+    bool GetDataFileBuckets(const size_t seriesIdx, const size_t minBuckets,
+                            std::vector<SeriesPyramid::Bucket>& buckets) const;
+private:
+    friend class ChartHelper;
+
+    uint64_t m_version{0};
+    size_t m_variableCount{0};
+    bool m_timeMode{false};
+    // only when the variables have names which are not in a data file
+    Column<wxString> m_variableNames;
+    Column<int64_t> m_timestamps;
+    // for the variable names in the data file
+    std::shared_ptr<const ChartDataFile> m_dataFile;
+    std::vector<Series> m_series;
+};
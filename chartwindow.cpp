@@ -0,0 +1,79 @@
+///////////////////////////////////////////////////////////////////////////////
+// Project:     wxECharts
+// Home:        https://github.com/PBfordev/wxecharts
+// File Name:   chartwindow.cpp
+// Purpose:     Implementation of the frame with only a chart
+// Author:      PB
+// Created:     2026-10-18
+// Copyright:   (c) 2026 PB
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#include <wx/wx.h>
+#include <wx/filename.h>
+#include <wx/webview.h>
+
+#include "chartwindow.h"
+#include "webkitprofile.h"
+#include "webviewfactory.h"
+
+ChartWindow::ChartWindow(wxWindow* parent, const wxString& title,
+                         const wxString& chartAssetsFolder, const wxString& webViewBackend,
+                         const ShownHandler& onShown)
+    : wxFrame(parent, wxID_ANY, title),
+      m_onShown(onShown)
+{
+    const wxString url = wxString::Format("file://%s", wxFileName(chartAssetsFolder, "wxecharts.html").GetFullPath());
+
+    m_webView = WebViewFactory::Create(this, url, webViewBackend);
+    if ( !m_webView )
+    {
+        wxLogError(_("Could not create the webview for the chart."));
+        CallAfter(&ChartWindow::CallShownHandler, false);
+        return;
+    }
+
+    m_webView->EnableContextMenu(false);
+    m_webView->EnableHistory(false);
+#ifdef __WXGTK__
+    if ( webViewBackend == wxWebViewBackendWebKit )
+        WebKitProfile::Apply(m_webView);
+#endif // #ifdef __WXGTK__
+
+    if ( m_webView->AddScriptMessageHandler("wxmsg") )
+        m_webView->Bind(wxEVT_WEBVIEW_SCRIPT_MESSAGE_RECEIVED, &ChartWindow::OnWebViewMessageReceived, this);
+    m_webView->Bind(wxEVT_WEBVIEW_LOADED, &ChartWindow::OnWebViewPageLoaded, this);
+    m_webView->Bind(wxEVT_WEBVIEW_ERROR, &ChartWindow::OnWebViewError, this);
+}
+
+void ChartWindow::CallShownHandler(const bool rendered)
+{
+    if ( !m_onShown )
+        return;
+
+    // called only once
+    const ShownHandler onShown = m_onShown;
+
+    m_onShown = nullptr;
+    onShown(rendered);
+}
+
+void ChartWindow::OnWebViewPageLoaded(wxWebViewEvent&)
+{
+    m_chartHelper.SetWebView(m_webView);
+    m_chartHelper.RunChartCreate();
+    m_chartHelper.RunChartUpdateVariableNames();
+    m_chartHelper.RunChartUpdateSeries();
+}
+
+void ChartWindow::OnWebViewError(wxWebViewEvent&)
+{
+    wxLogError(_("Could not initialize the chart."));
+    CallShownHandler(false);
+}
+
+void ChartWindow::OnWebViewMessageReceived(wxWebViewEvent& evt)
+{
+    if ( evt.GetString().StartsWith("wxECharts::rendered\t") )
+        CallShownHandler(true);
+}
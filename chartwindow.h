@@ -0,0 +1,57 @@
+///////////////////////////////////////////////////////////////////////////////
+// Project:     wxECharts
+// Home:        https://github.com/PBfordev/wxecharts
+// File Name:   chartwindow.h
+// Purpose:     Declaration of the frame with only a chart
+// Author:      PB
+// Created:     2026-10-18
+// Copyright:   (c) 2026 PB
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <functional>
+
+#include <wx/frame.h>
+
+#include "charthelper.h"
+
+class wxWebView;
+class wxWebViewEvent;
+
+/*****************************************************************
+
+ChartWindow
+---------------
+a frame with only a chart, which has its own ChartHelper
+
+The chart data are set with GetChartHelper() before the chart page
+is loaded, the chart is then created with them. The chart cannot be
+edited and ignores the messages other than "rendered".
+
+******************************************************************/
+
+class ChartWindow : public wxFrame
+{
+public:
+    // called once, when the chart was rendered for the first time
+    // (rendered is true) or the chart page could not be loaded
+    using ShownHandler = std::function<void(bool rendered)>;
+
+    ChartWindow(wxWindow* parent, const wxString& title,
+                const wxString& chartAssetsFolder, const wxString& webViewBackend,
+                const ShownHandler& onShown);
+
+    ChartHelper& GetChartHelper() { return m_chartHelper; }
+private:
+    ChartHelper m_chartHelper;
+    wxWebView* m_webView{nullptr};
+    ShownHandler m_onShown;
+
+    void CallShownHandler(const bool rendered);
+
+    void OnWebViewPageLoaded(wxWebViewEvent&);
+    void OnWebViewError(wxWebViewEvent&);
+    void OnWebViewMessageReceived(wxWebViewEvent& evt);
+};
@@ -0,0 +1,130 @@
+///////////////////////////////////////////////////////////////////////////////
+// Project:     wxECharts
+// Home:        https://github.com/PBfordev/wxecharts
+// File Name:   contenthash.cpp
+// Purpose:     Implementation of fast hash of content
+// Author:      PB
+// Created:     2026-10-18
+// Copyright:   (c) 2026 PB
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#include <wx/wx.h>
+
+#include <cstring>
+
+#include "contenthash.h"
+
+namespace {
+
+constexpr uint64_t Prime1 = 0x9E3779B185EBCA87ULL;
+constexpr uint64_t Prime2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr uint64_t Prime3 = 0x165667B19E3779F9ULL;
+constexpr uint64_t Prime4 = 0x85EBCA77C2B2AE63ULL;
+constexpr uint64_t Prime5 = 0x27D4EB2F165667C5ULL;
+
+inline uint64_t RotateLeft(const uint64_t value, const int count)
+{
+    return (value << count) | (value >> (64 - count));
+}
+
+// the data are read as little endian, as all the supported platforms are
+inline uint64_t Read64(const unsigned char* p)
+{
+    uint64_t value;
+
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+inline uint32_t Read32(const unsigned char* p)
+{
+    uint32_t value;
+
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+inline uint64_t Round(uint64_t acc, const uint64_t input)
+{
+    acc += input * Prime2;
+    acc = RotateLeft(acc, 31);
+    return acc * Prime1;
+}
+
+inline uint64_t MergeRound(uint64_t acc, const uint64_t value)
+{
+    acc ^= Round(0, value);
+    return acc * Prime1 + Prime4;
+}
+
+} // anonymous namespace
+
+uint64_t ContentHash::Compute(const void* data, const size_t size, const uint64_t seed)
+{
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    const unsigned char* const end = p + size;
+    uint64_t hash;
+
+    if ( size >= 32 )
+    {
+        const unsigned char* const lastStripe = end - 32;
+        uint64_t v1 = seed + Prime1 + Prime2;
+        uint64_t v2 = seed + Prime2;
+        uint64_t v3 = seed;
+        uint64_t v4 = seed - Prime1;
+
+        do
+        {
+            v1 = Round(v1, Read64(p));
+            v2 = Round(v2, Read64(p + 8));
+            v3 = Round(v3, Read64(p + 16));
+            v4 = Round(v4, Read64(p + 24));
+            p += 32;
+        } while ( p <= lastStripe );
+
+        hash = RotateLeft(v1, 1) + RotateLeft(v2, 7) + RotateLeft(v3, 12) + RotateLeft(v4, 18);
+        hash = MergeRound(hash, v1);
+        hash = MergeRound(hash, v2);
+        hash = MergeRound(hash, v3);
+        hash = MergeRound(hash, v4);
+    }
+    else
+    {
+        hash = seed + Prime5;
+    }
+
+    hash += static_cast<uint64_t>(size);
+
+    for ( ; p + 8 <= end; p += 8 )
+    {
+        hash ^= Round(0, Read64(p));
+        hash = RotateLeft(hash, 27) * Prime1 + Prime4;
+    }
+
+    if ( p + 4 <= end )
+    {
+        hash ^= static_cast<uint64_t>(Read32(p)) * Prime1;
+        hash = RotateLeft(hash, 23) * Prime2 + Prime3;
+        p += 4;
+    }
+
+    for ( ; p < end; ++p )
+    {
+        hash ^= (*p) * Prime5;
+        hash = RotateLeft(hash, 11) * Prime1;
+    }
+
+    hash ^= hash >> 33;
+    hash *= Prime2;
+    hash ^= hash >> 29;
+    hash *= Prime3;
+    hash ^= hash >> 32;
+
+    return hash;
+}
+
+uint64_t ContentHash::Compute(const std::string& str, const uint64_t seed)
+{
+    return Compute(str.data(), str.size(), seed);
+}
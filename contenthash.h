@@ -0,0 +1,35 @@
+///////////////////////////////////////////////////////////////////////////////
+// Project:     wxECharts
+// Home:        https://github.com/PBfordev/wxecharts
+// File Name:   contenthash.h
+// Purpose:     Declaration of fast hash of content
+// Author:      PB
+// Created:     2026-10-18
+// Copyright:   (c) 2026 PB
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/*****************************************************************
+
+ContentHash
+---------------
+computes the 64-bit hash of data with the XXH64 algorithm
+
+Used to find out whether the content about to be sent is the same
+as the content sent before, it is much faster than comparing the
+content with its copy. It is not a cryptographic hash.
+
+******************************************************************/
+
+class ContentHash final
+{
+public:
+    static uint64_t Compute(const void* data, const size_t size, const uint64_t seed = 0);
+    static uint64_t Compute(const std::string& str, const uint64_t seed = 0);
+};
@@ -0,0 +1,523 @@
+///////////////////////////////////////////////////////////////////////////////
+// Project:     wxECharts
+// Home:        https://github.com/PBfordev/wxecharts
+// File Name:   csvimporter.cpp
+// Purpose:     Implementation of parallel CSV/TSV importer
+// Author:      PB
+// Created:     2026-10-18
+// Copyright:   (c) 2026 PB
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#include <wx/wx.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <limits>
+#include <new>
+
+#include "csvimporter.h"
+
+using namespace std;
+
+namespace {
+
+// smaller files are not worth splitting into more chunks
+constexpr size_t MinChunkSize = 1024 * 1024;
+
+// how often the workers report progress and check for cancellation
+constexpr size_t ProgressStep = 4 * 1024 * 1024;
+
+// returns the start of the next line, lineEnd is the end
+// of the current line without the line break
+const char* NextLine(const char* first, const char* last, const char*& lineEnd)
+{
+    const char* newLine = static_cast<const char*>(memchr(first, '\n', last - first));
+
+    if ( !newLine )
+    {
+        lineEnd = last;
+        if ( lineEnd > first && lineEnd[-1] == '\r' )
+            --lineEnd;
+        return last;
+    }
+
+    lineEnd = newLine;
+    if ( lineEnd > first && lineEnd[-1] == '\r' )
+        --lineEnd;
+    return newLine + 1;
+}
+
+// removes spaces and enclosing double quotes
+void TrimField(const char*& first, const char*& last)
+{
+    while ( first < last && *first == ' ' )
+        ++first;
+    while ( last > first && last[-1] == ' ' )
+        --last;
+
+    if ( last - first >= 2 && *first == '"' && last[-1] == '"' )
+    {
+        ++first;
+        --last;
+    }
+}
+
+// returns the end of the field starting at first
+const char* FieldEnd(const char* first, const char* last, const char delimiter)
+{
+    const char* end = static_cast<const char*>(memchr(first, delimiter, last - first));
+
+    return end ? end : last;
+}
+
+inline bool IsDigit(const char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+} // anonymous namespace
+
+CSVImporter::CSVImporter()
+{}
+
+CSVImporter::~CSVImporter()
+{
+    m_cancel = true;
+    if ( m_thread.joinable() )
+        m_thread.join();
+}
+
+bool CSVImporter::Start(const wxString& fileName, const std::function<void()>& onDone)
+{
+    wxCHECK_MSG(!m_file.IsOpened() && !m_thread.joinable(), false, "Import already started");
+
+    if ( !m_file.Open(fileName) )
+        return false;
+
+    if ( !ReadHeader() )
+    {
+        wxLogError(_("'%s' is not a valid CSV or TSV file."), fileName);
+        m_file.Close();
+        return false;
+    }
+
+    m_file.Advise(MappedFile::Sequential);
+    m_thread = thread(&CSVImporter::Import, this, onDone);
+    return true;
+}
+
+void CSVImporter::Cancel()
+{
+    m_cancel = true;
+}
+
+CSVImporter::Status CSVImporter::GetStatus() const
+{
+    return static_cast<Status>(m_status.load());
+}
+
+double CSVImporter::GetProgress() const
+{
+    if ( m_bodySize == 0 )
+        return 1;
+
+    return min(1.0, static_cast<double>(m_processedBytes.load()) / (2.0 * m_bodySize));
+}
+
+wxString CSVImporter::GetError() const
+{
+    lock_guard<mutex> lock(m_errorMutex);
+
+    return m_error;
+}
+
+long CSVImporter::GetElapsedTime() const
+{
+    return m_elapsedTime;
+}
+
+bool CSVImporter::TakeData(std::vector<wxString>& variableNames,
+                           std::vector<ChartHelper::ValueSeries>& series)
+{
+    wxCHECK_MSG(GetStatus() == Finished, false, "Import has not finished");
+    wxCHECK_MSG(!m_series.empty(), false, "Data already taken");
+
+    variableNames = move(m_variableNames);
+    series = move(m_series);
+    m_variableNames.clear();
+    m_series.clear();
+    return true;
+}
+
+// the fast path is exact when the decimal mantissa and the power of ten
+// are both exactly representable as double (W. D. Clinger, 1990),
+// which is the case for nearly all numbers in data exports;
+// the others are left to the C library
+bool CSVImporter::ParseDouble(const char* first, const char* last, double& value)
+{
+    static const double powersOf10[] =
+    {
+        1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+    static constexpr int maxFastExponent = 22;
+    static constexpr uint64_t maxFastMantissa = uint64_t(1) << 53;
+    static constexpr int maxMantissaDigits = 19;
+
+    TrimField(first, last);
+
+    if ( first == last )
+    {
+        value = numeric_limits<double>::quiet_NaN();
+        return true;
+    }
+
+    const char* p = first;
+    bool negative = false;
+    uint64_t mantissa = 0;
+    int mantissaDigits = 0;
+    int exponent = 0;
+    bool hasDigits = false;
+    bool truncated = false;
+
+    if ( *p == '-' || *p == '+' )
+    {
+        negative = *p == '-';
+        ++p;
+    }
+
+    for ( ; p < last && IsDigit(*p); ++p )
+    {
+        hasDigits = true;
+        if ( mantissaDigits < maxMantissaDigits )
+        {
+            mantissa = mantissa * 10 + (*p - '0');
+            if ( mantissa != 0 )
+                ++mantissaDigits;
+        }
+        else
+        {
+            truncated = true;
+        }
+    }
+
+    if ( p < last && *p == '.' )
+    {
+        for ( ++p; p < last && IsDigit(*p); ++p )
+        {
+            hasDigits = true;
+            if ( mantissaDigits < maxMantissaDigits )
+            {
+                mantissa = mantissa * 10 + (*p - '0');
+                if ( mantissa != 0 )
+                    ++mantissaDigits;
+                --exponent;
+            }
+            else
+            {
+                truncated = true;
+            }
+        }
+    }
+
+    if ( hasDigits && p < last && (*p == 'e' || *p == 'E') )
+    {
+        bool negativeExponent = false;
+        int explicitExponent = 0;
+
+        ++p;
+        if ( p < last && (*p == '-' || *p == '+') )
+        {
+            negativeExponent = *p == '-';
+            ++p;
+        }
+
+        if ( p == last || !IsDigit(*p) )
+            hasDigits = false;
+
+        for ( ; p < last && IsDigit(*p); ++p )
+        {
+            if ( explicitExponent < 100000 )
+                explicitExponent = explicitExponent * 10 + (*p - '0');
+        }
+        exponent += negativeExponent ? -explicitExponent : explicitExponent;
+    }
+
+    if ( hasDigits && p == last && !truncated
+         && mantissa <= maxFastMantissa
+         && exponent >= -maxFastExponent && exponent <= maxFastExponent )
+    {
+        value = static_cast<double>(mantissa);
+        if ( exponent < 0 )
+            value /= powersOf10[-exponent];
+        else
+            value *= powersOf10[exponent];
+        if ( negative )
+            value = -value;
+        return true;
+    }
+
+    // also handles "nan" and "inf"
+    return wxString(first, last - first).ToCDouble(&value);
+}
+
+bool CSVImporter::ReadHeader()
+{
+    const char* data = m_file.GetData();
+    const char* end = data + m_file.GetSize();
+
+    if ( !data )
+        return false;
+
+    // UTF-8 BOM
+    if ( end - data >= 3 && memcmp(data, "\xEF\xBB\xBF", 3) == 0 )
+        data += 3;
+
+    const char* headerEnd;
+
+    m_bodyStart = NextLine(data, end, headerEnd);
+    m_bodySize = end - m_bodyStart;
+
+    // tab for TSV, semicolon for CSV with decimal comma in other columns
+    const char delimiters[] = { '\t', ';', ',' };
+    ptrdiff_t maxDelimiterCount = 0;
+
+    for ( const auto d : delimiters )
+    {
+        const ptrdiff_t count = std::count(data, headerEnd, d);
+
+        if ( count > maxDelimiterCount )
+        {
+            maxDelimiterCount = count;
+            m_delimiter = d;
+        }
+    }
+
+    // at least the variable names and one series
+    if ( maxDelimiterCount == 0 )
+        return false;
+
+    vector<wxString> columnNames;
+
+    for ( const char* p = data; p <= headerEnd; )
+    {
+        const char* fieldFirst = p;
+        const char* fieldLast = FieldEnd(p, headerEnd, m_delimiter);
+
+        p = fieldLast + 1;
+        TrimField(fieldFirst, fieldLast);
+        columnNames.push_back(wxString::FromUTF8(fieldFirst, fieldLast - fieldFirst));
+    }
+
+    m_series.resize(columnNames.size() - 1);
+    for ( size_t i = 0; i < m_series.size(); ++i )
+    {
+        wxString& name = m_series[i].name;
+
+        name = columnNames[i + 1];
+        if ( name.empty() )
+            name.Printf(_("Series %zu"), i + 1);
+
+        for ( size_t j = 0; j < i; ++j )
+        {
+            if ( m_series[j].name.IsSameAs(name, true) )
+            {
+                wxLogError(_("Series name '%s' is used more than once."), name);
+                return false;
+            }
+        }
+        m_series[i].type = ChartHelper::Line;
+    }
+
+    return true;
+}
+
+void CSVImporter::Import(std::function<void()> onDone)
+{
+    const auto startTime = chrono::steady_clock::now();
+    const char* bodyEnd = m_bodyStart + m_bodySize;
+    const size_t chunkCount = max<size_t>(1, min<size_t>(thread::hardware_concurrency(),
+                                                          m_bodySize / MinChunkSize));
+    // runs the function for each chunk in its own thread
+    auto ForEachChunk = [this](const function<void(Chunk&)>& f)
+    {
+        vector<thread> workers;
+
+        for ( auto& c : m_chunks )
+            workers.emplace_back(f, ref(c));
+        for ( auto& w : workers )
+            w.join();
+    };
+
+    // the chunks end after a line break, so that no line is split
+    for ( size_t i = 0; i < chunkCount; ++i )
+    {
+        const char* first = m_chunks.empty() ? m_bodyStart : m_chunks.back().last;
+        const char* last = bodyEnd;
+
+        if ( i + 1 < chunkCount )
+        {
+            const char* nominalLast = max(first, m_bodyStart + m_bodySize / chunkCount * (i + 1));
+            const char* newLine = static_cast<const char*>(memchr(nominalLast, '\n', bodyEnd - nominalLast));
+
+            last = newLine ? newLine + 1 : bodyEnd;
+        }
+        m_chunks.push_back({first, last, 0, 0});
+    }
+
+    ForEachChunk([this](Chunk& c) { CountRows(c); });
+
+    size_t rowCount = 0;
+
+    for ( auto& c : m_chunks )
+    {
+        c.firstRow = rowCount;
+        rowCount += c.rowCount;
+    }
+
+    if ( !m_cancel && GetStatus() == Running && rowCount == 0 )
+        SetError(_("The file contains no data."));
+
+    if ( !m_cancel && GetStatus() == Running )
+    {
+        try
+        {
+            m_variableNames.resize(rowCount);
+            for ( auto& s : m_series )
+                s.data.resize(rowCount);
+        }
+        catch ( const bad_alloc& )
+        {
+            SetError(wxString::Format(_("Not enough memory for %zu values in %zu series."),
+                                      rowCount, m_series.size()));
+        }
+    }
+
+    if ( !m_cancel && GetStatus() == Running )
+        ForEachChunk([this](Chunk& c) { ParseRows(c); });
+
+    m_file.Close();
+    m_elapsedTime = static_cast<long>(chrono::duration_cast<chrono::milliseconds>(
+                        chrono::steady_clock::now() - startTime).count());
+
+    if ( GetStatus() == Running )
+    {
+        if ( m_cancel )
+        {
+            m_variableNames.clear();
+            m_series.clear();
+            m_status = Cancelled;
+        }
+        else
+        {
+            m_status = Finished;
+        }
+    }
+
+    if ( onDone )
+        onDone();
+}
+
+void CSVImporter::CountRows(Chunk& chunk)
+{
+    const char* reported = chunk.first;
+    const char* lineEnd;
+
+    chunk.rowCount = 0;
+    for ( const char* p = chunk.first; p < chunk.last; )
+    {
+        const char* lineFirst = p;
+
+        p = NextLine(p, chunk.last, lineEnd);
+        if ( lineEnd > lineFirst )
+            ++chunk.rowCount;
+
+        if ( static_cast<size_t>(p - reported) >= ProgressStep )
+        {
+            m_processedBytes += p - reported;
+            reported = p;
+            if ( m_cancel )
+                return;
+        }
+    }
+    m_processedBytes += chunk.last - reported;
+}
+
+void CSVImporter::ParseRows(const Chunk& chunk)
+{
+    const char* reported = chunk.first;
+    const char* lineEnd;
+    size_t row = chunk.firstRow;
+
+    for ( const char* p = chunk.first; p < chunk.last; )
+    {
+        const char* lineFirst = p;
+
+        p = NextLine(p, chunk.last, lineEnd);
+        if ( lineEnd == lineFirst )
+            continue;
+
+        const char* fieldFirst = lineFirst;
+        const char* fieldLast = FieldEnd(fieldFirst, lineEnd, m_delimiter);
+        const char* next = fieldLast + 1;
+
+        TrimField(fieldFirst, fieldLast);
+        m_variableNames[row] = wxString::FromUTF8(fieldFirst, fieldLast - fieldFirst);
+
+        for ( auto& s : m_series )
+        {
+            double& value = s.data[row];
+
+            // missing trailing fields
+            if ( next > lineEnd )
+            {
+                value = numeric_limits<double>::quiet_NaN();
+                continue;
+            }
+
+            fieldFirst = next;
+            fieldLast = FieldEnd(fieldFirst, lineEnd, m_delimiter);
+            next = fieldLast + 1;
+
+            if ( !ParseDouble(fieldFirst, fieldLast, value) )
+            {
+                SetError(wxString::Format(_("Invalid number '%s' for variable '%s' in series '%s'."),
+                                          wxString::FromUTF8(fieldFirst, fieldLast - fieldFirst),
+                                          m_variableNames[row], s.name));
+                return;
+            }
+        }
+
+        if ( next <= lineEnd )
+        {
+            SetError(wxString::Format(_("Variable '%s' has more values than there are series."),
+                                      m_variableNames[row]));
+            return;
+        }
+
+        ++row;
+
+        if ( static_cast<size_t>(p - reported) >= ProgressStep )
+        {
+            m_processedBytes += p - reported;
+            reported = p;
+            if ( m_cancel || GetStatus() != Running )
+                return;
+        }
+    }
+    m_processedBytes += chunk.last - reported;
+}
+
+void CSVImporter::SetError(const wxString& error)
+{
+    lock_guard<mutex> lock(m_errorMutex);
+
+    // only the first error is reported
+    if ( GetStatus() != Running )
+        return;
+
+    m_error = error;
+    m_status = Failed;
+}
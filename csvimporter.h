@@ -0,0 +1,119 @@
+///////////////////////////////////////////////////////////////////////////////
+// Project:     wxECharts
+// Home:        https://github.com/PBfordev/wxecharts
+// File Name:   csvimporter.h
+// Purpose:     Declaration of parallel CSV/TSV importer
+// Author:      PB
+// Created:     2026-10-18
+// Copyright:   (c) 2026 PB
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <wx/string.h>
+
+#include "charthelper.h"
+#include "mappedfile.h"
+
+/*****************************************************************
+
+CSVImporter
+---------------
+imports chart data from a CSV or TSV file, which can be
+several GB large, in a worker thread
+
+The first line contains the column names: the first column
+contains the variable names, the other columns the series
+values. The delimiter (comma, semicolon or tab) is detected
+from the first line. Fields may be enclosed in double quotes,
+but cannot contain the delimiter or line breaks. Empty and
+missing fields are imported as NaN.
+
+The file is memory-mapped and split into chunks at line
+boundaries, which are parsed in parallel on all the cores.
+The first pass counts the lines in each chunk, so that the
+second pass can parse the values directly to their place
+in the series, without merging the chunks. The numbers
+are parsed independently of the current locale, with the
+decimal point.
+
+******************************************************************/
+
+class CSVImporter final
+{
+public:
+    enum Status
+    {
+        Running,
+        Finished,
+        Cancelled,
+        Failed,
+    };
+
+    CSVImporter();
+    ~CSVImporter();
+
+    // onDone is called from the worker thread when the import
+    // finished, was cancelled or failed, see GetStatus()
+    bool Start(const wxString& fileName, const std::function<void()>& onDone);
+    void Cancel();
+
+    Status GetStatus() const;
+    // from 0 to 1
+    double GetProgress() const;
+    // valid only if the import failed
+    wxString GetError() const;
+    // in milliseconds, valid once the import is done
+    long GetElapsedTime() const;
+
+    // moves the imported data, can be called only once when the import finished
+    bool TakeData(std::vector<wxString>& variableNames,
+                  std::vector<ChartHelper::ValueSeries>& series);
+
+    // parses a number without regard to the current locale, an empty
+    // field is NaN; exposed for the reuse by other importers
+    static bool ParseDouble(const char* first, const char* last, double& value);
+private:
+    struct Chunk
+    {
+        const char* first;
+        const char* last;
+        size_t firstRow;
+        size_t rowCount;
+    };
+
+    MappedFile m_file;
+    char m_delimiter{','};
+    const char* m_bodyStart{nullptr};
+    size_t m_bodySize{0};
+
+    std::vector<Chunk> m_chunks;
+    std::vector<wxString> m_variableNames;
+    std::vector<ChartHelper::ValueSeries> m_series;
+
+    std::atomic<int> m_status{Running};
+    std::atomic<bool> m_cancel{false};
+    // processed in both passes, so it goes up to twice the file size
+    std::atomic<uint64_t> m_processedBytes{0};
+    long m_elapsedTime{0};
+
+    mutable std::mutex m_errorMutex;
+    wxString m_error;
+
+    std::thread m_thread;
+
+    bool ReadHeader();
+    // run in the worker threads
+    void Import(std::function<void()> onDone);
+    void CountRows(Chunk& chunk);
+    void ParseRows(const Chunk& chunk);
+    void SetError(const wxString& error);
+};
@@ -0,0 +1,345 @@
+///////////////////////////////////////////////////////////////////////////////
+// Project:     wxECharts
+// Home:        https://github.com/PBfordev/wxecharts
+// File Name:   jsonwriter.cpp
+// Purpose:     Implementation of streaming JSON writer
+// Author:      PB
+// Created:     2026-10-18
+// Copyright:   (c) 2026 PB
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#include <wx/wx.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <json.hpp>
+
+#include "jsonwriter.h"
+
+using namespace std;
+
+namespace {
+
+// the numbers are written in blocks, so that the string does not have
+// to grow for every number nor be much larger than needed
+constexpr size_t NumberBlockSize = 4096;
+
+// the powers of ten which are exactly representable as double
+const double PowersOf10[] =
+{
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+constexpr int MaxPowerOf10 = 22;
+
+// rounds the value to the decimals (negative to tens, hundreds...),
+// the result is the double nearest to the rounded decimal number,
+// so that its shortest form has no more digits than the decimal
+double RoundToDecimals(const double value, const int decimals)
+{
+    if ( decimals > MaxPowerOf10 || -decimals > MaxPowerOf10 )
+        return value;
+
+    if ( decimals >= 0 )
+    {
+        const double scale = PowersOf10[decimals];
+        const double scaled = value * scale;
+
+        // no fractional part left to round (or overflow)
+        if ( !(fabs(scaled) < 9007199254740992.0) ) // 2^53
+            return value;
+        // adding zero turns -0.0 into 0.0
+        return round(scaled) / scale + 0.0;
+    }
+
+    const double scale = PowersOf10[-decimals];
+    const double rounded = round(value / scale) * scale + 0.0;
+
+    return std::isfinite(rounded) ? rounded : value;
+}
+
+double RoundToSignificantDigits(const double value, const int digits)
+{
+    if ( value == 0 )
+        return value;
+
+    const int exponent = static_cast<int>(floor(log10(fabs(value))));
+    const int decimals = digits - 1 - exponent;
+
+    if ( decimals <= MaxPowerOf10 && -decimals <= MaxPowerOf10 )
+        return RoundToDecimals(value, decimals);
+
+    // the scale of a tiny or huge value is not exactly representable,
+    // so the mantissa is rounded by formatting the value, which is exact,
+    // and parsing it gives the double nearest to the rounded number
+    char buffer[32];
+
+    snprintf(buffer, sizeof(buffer), "%.*e", digits - 1, value);
+
+    const double rounded = strtod(buffer, nullptr);
+
+    // rounded up out of the double range
+    return std::isfinite(rounded) ? rounded : value;
+}
+
+template <typename T, typename Format>
+void WriteNumbers(string& out, const T* values, const size_t count, bool needComma, Format format)
+{
+    for ( size_t first = 0; first < count; first += NumberBlockSize )
+    {
+        const size_t blockCount = min(NumberBlockSize, count - first);
+        const size_t start = out.size();
+
+        out.resize(start + blockCount * (JSONWriter::MaxNumberLength + 1));
+
+        char* const begin = &out[0];
+        char* p = begin + start;
+
+        for ( size_t i = first; i < first + blockCount; ++i )
+        {
+            if ( needComma )
+                *p++ = ',';
+            p = format(p, values[i]);
+            needComma = true;
+        }
+        out.resize(static_cast<size_t>(p - begin));
+    }
+}
+
+} // anonymous namespace
+
+constexpr size_t JSONWriter::MaxNumberLength;
+constexpr int JSONWriter::Precision::MaxDigits;
+
+bool JSONWriter::Precision::IsValid() const
+{
+    switch ( type )
+    {
+        case Full:              return true;
+        case SignificantDigits: return digits >= 1 && digits <= MaxDigits;
+        case Decimals:          return digits >= 0 && digits <= MaxDigits;
+    }
+    return false;
+}
+
+JSONWriter::JSONWriter(std::string& out)
+    : m_out(out)
+{}
+
+void JSONWriter::BeginObject()
+{
+    BeforeValue();
+    m_out += '{';
+    m_needComma = false;
+}
+
+void JSONWriter::EndObject()
+{
+    m_out += '}';
+    m_needComma = true;
+}
+
+void JSONWriter::BeginArray()
+{
+    BeforeValue();
+    m_out += '[';
+    m_needComma = false;
+}
+
+void JSONWriter::EndArray()
+{
+    m_out += ']';
+    m_needComma = true;
+}
+
+void JSONWriter::Key(const char* key)
+{
+    String(key, strlen(key));
+    m_out += ':';
+    m_needComma = false;
+}
+
+void JSONWriter::String(const char* str, const size_t length)
+{
+    static const char hexDigits[] = "0123456789abcdef";
+
+    BeforeValue();
+    m_out += '"';
+    for ( size_t i = 0; i < length; ++i )
+    {
+        const unsigned char c = static_cast<unsigned char>(str[i]);
+
+        switch ( c )
+        {
+            case '"':  m_out += "\\\""; break;
+            case '\\': m_out += "\\\\"; break;
+            case '\b': m_out += "\\b"; break;
+            case '\f': m_out += "\\f"; break;
+            case '\n': m_out += "\\n"; break;
+            case '\r': m_out += "\\r"; break;
+            case '\t': m_out += "\\t"; break;
+            default:
+                if ( c < 0x20 )
+                {
+                    m_out += "\\u00";
+                    m_out += hexDigits[c >> 4];
+                    m_out += hexDigits[c & 0xf];
+                }
+                else
+                {
+                    m_out += static_cast<char>(c);
+                }
+        }
+    }
+    m_out += '"';
+    m_needComma = true;
+}
+
+void JSONWriter::String(const std::string& str)
+{
+    String(str.data(), str.size());
+}
+
+void JSONWriter::Double(const double value)
+{
+    char buffer[MaxNumberLength];
+
+    BeforeValue();
+    m_out.append(buffer, FormatDouble(buffer, value));
+    m_needComma = true;
+}
+
+void JSONWriter::Double(const double value, const Precision& precision)
+{
+    char buffer[MaxNumberLength];
+
+    BeforeValue();
+    m_out.append(buffer, FormatDouble(buffer, value, precision));
+    m_needComma = true;
+}
+
+void JSONWriter::Int(const int64_t value)
+{
+    char buffer[MaxNumberLength];
+
+    BeforeValue();
+    m_out.append(buffer, FormatInt(buffer, value));
+    m_needComma = true;
+}
+
+void JSONWriter::Null()
+{
+    BeforeValue();
+    m_out += "null";
+    m_needComma = true;
+}
+
+void JSONWriter::Raw(const std::string& json)
+{
+    BeforeValue();
+    m_out += json;
+    m_needComma = true;
+}
+
+void JSONWriter::Doubles(const double* values, const size_t count)
+{
+    if ( count == 0 )
+        return;
+
+    WriteNumbers(m_out, values, count, m_needComma,
+                 [](char* first, const double value) { return FormatDouble(first, value); });
+    m_needComma = true;
+}
+
+void JSONWriter::Doubles(const double* values, const size_t count, const Precision& precision)
+{
+    if ( precision.IsFull() )
+    {
+        Doubles(values, count);
+        return;
+    }
+
+    if ( count == 0 )
+        return;
+
+    WriteNumbers(m_out, values, count, m_needComma,
+                 [&precision](char* first, const double value) { return FormatDouble(first, value, precision); });
+    m_needComma = true;
+}
+
+void JSONWriter::Ints(const int64_t* values, const size_t count)
+{
+    if ( count == 0 )
+        return;
+
+    WriteNumbers(m_out, values, count, m_needComma, &JSONWriter::FormatInt);
+    m_needComma = true;
+}
+
+char* JSONWriter::FormatDouble(char* first, const double value)
+{
+    if ( !std::isfinite(value) )
+    {
+        memcpy(first, "null", 4);
+        return first + 4;
+    }
+
+    // the shortest round-trip representation (Grisu2) used by nlohmann::json::dump()
+    return nlohmann::detail::to_chars(first, first + MaxNumberLength, value);
+}
+
+char* JSONWriter::FormatDouble(char* first, const double value, const Precision& precision)
+{
+    if ( !std::isfinite(value) )
+        return FormatDouble(first, value);
+
+    double rounded = value;
+
+    if ( precision.type == Precision::SignificantDigits )
+        rounded = RoundToSignificantDigits(value, precision.digits);
+    else if ( precision.type == Precision::Decimals )
+        rounded = RoundToDecimals(value, precision.digits);
+
+    if ( precision.float32 )
+    {
+        const float roundedFloat = static_cast<float>(rounded);
+
+        // doubles out of the float range are written in full
+        if ( std::isfinite(roundedFloat) )
+            return nlohmann::detail::to_chars(first, first + MaxNumberLength, roundedFloat);
+    }
+
+    return FormatDouble(first, rounded);
+}
+
+char* JSONWriter::FormatInt(char* first, const int64_t value)
+{
+    char digits[20];
+    size_t count = 0;
+    // the absolute value of INT64_MIN does not fit into int64_t
+    uint64_t absValue = value < 0 ? 0 - static_cast<uint64_t>(value) : static_cast<uint64_t>(value);
+
+    do
+    {
+        digits[count++] = static_cast<char>('0' + absValue % 10);
+        absValue /= 10;
+    } while ( absValue != 0 );
+
+    if ( value < 0 )
+        *first++ = '-';
+    while ( count > 0 )
+        *first++ = digits[--count];
+    return first;
+}
+
+void JSONWriter::BeforeValue()
+{
+    if ( m_needComma )
+        m_out += ',';
+}
@@ -0,0 +1,102 @@
+///////////////////////////////////////////////////////////////////////////////
+// Project:     wxECharts
+// Home:        https://github.com/PBfordev/wxecharts
+// File Name:   jsonwriter.h
+// Purpose:     Declaration of streaming JSON writer
+// Author:      PB
+// Created:     2026-10-18
+// Copyright:   (c) 2026 PB
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/*****************************************************************
+
+JSONWriter
+---------------
+writes JSON directly to a string, without building a document
+first as nlohmann::json does
+
+Used for the chart update payloads, which are mostly long arrays
+of numbers. The doubles are written in the shortest form which
+reads back as the same double, exactly as nlohmann::json::dump()
+writes them, and NaN and infinity are written as null.
+
+The doubles can also be written with a Precision, rounded to
+the given number of significant digits or decimals and/or as
+floats, in the shortest form which reads back as the rounded
+value. This makes the payloads of measured values, which have
+only a few meaningful digits, much shorter.
+
+The writer only puts the commas and colons where they belong, it
+does not check that the calls make a valid JSON. The strings must
+be UTF-8.
+
+******************************************************************/
+
+class JSONWriter final
+{
+public:
+    // the longest double or integer written
+    static constexpr size_t MaxNumberLength = 32;
+
+    struct Precision
+    {
+        enum Type
+        {
+            Full,              // all the digits needed to read back the same double
+            SignificantDigits, // rounded to digits significant digits
+            Decimals,          // rounded to digits decimals
+        };
+
+        // 1 to MaxDigits significant digits, 0 to MaxDigits decimals
+        static constexpr int MaxDigits = 15;
+
+        Type type{Full};
+        int digits{0};
+        // written with all the digits needed to read back the same float
+        bool float32{false};
+
+        bool IsFull() const { return type == Full && !float32; }
+        bool IsValid() const;
+    };
+
+    // appends to out, which keeps its capacity when reused
+    explicit JSONWriter(std::string& out);
+
+    void BeginObject();
+    void EndObject();
+    void BeginArray();
+    void EndArray();
+
+    void Key(const char* key);
+
+    void String(const char* str, const size_t length);
+    void String(const std::string& str);
+    void Double(const double value);
+    void Double(const double value, const Precision& precision);
+    void Int(const int64_t value);
+    void Null();
+    // the value already serialized to JSON
+    void Raw(const std::string& json);
+
+    // the values as the items of the current array
+    void Doubles(const double* values, const size_t count);
+    void Doubles(const double* values, const size_t count, const Precision& precision);
+    void Ints(const int64_t* values, const size_t count);
+
+    // write at most MaxNumberLength chars without '\0', return the end
+    static char* FormatDouble(char* first, const double value);
+    static char* FormatDouble(char* first, const double value, const Precision& precision);
+    static char* FormatInt(char* first, const int64_t value);
+private:
+    std::string& m_out;
+    bool m_needComma{false};
+
+    void BeforeValue();
+};
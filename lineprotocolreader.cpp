@@ -0,0 +1,291 @@
+///////////////////////////////////////////////////////////////////////////////
+// Project:     wxECharts
+// Home:        https://github.com/PBfordev/wxecharts
+// File Name:   lineprotocolreader.cpp
+// Purpose:     Implementation of line protocol reader for live data
+// Author:      PB
+// Created:     2026-10-18
+// Copyright:   (c) 2026 PB
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#include <wx/wx.h>
+
+#ifdef __WXMSW__
+    #include <wx/msw/wrapwin.h>
+#else
+    #include <cerrno>
+    #include <poll.h>
+    #include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <limits>
+
+#include "csvimporter.h"
+#include "lineprotocolreader.h"
+
+using namespace std;
+
+namespace {
+
+bool IsSeparator(const char c)
+{
+    return c == ' ' || c == '\t' || c == ',';
+}
+
+bool ParseTimestamp(const char* first, const char* last, int64_t& timestamp)
+{
+    const bool negative = first < last && *first == '-';
+
+    if ( negative )
+        ++first;
+    if ( first == last )
+        return false;
+
+    uint64_t value = 0;
+
+    for ( ; first < last; ++first )
+    {
+        if ( *first < '0' || *first > '9' )
+            return false;
+
+        const unsigned digit = *first - '0';
+
+        if ( value > (static_cast<uint64_t>(numeric_limits<int64_t>::max()) - digit) / 10 )
+            return false;
+        value = value * 10 + digit;
+    }
+
+    timestamp = negative ? -static_cast<int64_t>(value) : static_cast<int64_t>(value);
+    return true;
+}
+
+} // anonymous namespace
+
+LineProtocolReader::LineProtocolReader()
+{}
+
+LineProtocolReader::~LineProtocolReader()
+{
+    Stop();
+}
+
+bool LineProtocolReader::Start()
+{
+    wxCHECK_MSG(!m_thread.joinable(), false, "Reader already started");
+
+    m_thread = thread(&LineProtocolReader::Read, this);
+    return true;
+}
+
+void LineProtocolReader::Stop()
+{
+    m_stop = true;
+    if ( m_thread.joinable() )
+        m_thread.join();
+}
+
+bool LineProtocolReader::TryPop(Batch& batch)
+{
+    return m_queue.TryPop(batch);
+}
+
+bool LineProtocolReader::IsFinished() const
+{
+    // the last batch is pushed before the end of input is set
+    return m_inputEnded.load(memory_order_acquire) && m_queue.IsEmpty();
+}
+
+size_t LineProtocolReader::GetPointCount() const
+{
+    return m_pointCount;
+}
+
+size_t LineProtocolReader::GetInvalidLineCount() const
+{
+    return m_invalidLineCount;
+}
+
+void LineProtocolReader::Read()
+{
+    // the incomplete line from the previous read is moved to the start
+    vector<char> buffer(MaxLineLength + ReadBufferSize);
+    size_t pending = 0;
+    bool skippingLine = false;
+    size_t readSize = 0;
+    Batch batch;
+
+    while ( ReadInput(buffer.data() + pending, ReadBufferSize, readSize) )
+    {
+        const char* first = buffer.data();
+        const char* const last = buffer.data() + pending + readSize;
+
+        for ( ;; )
+        {
+            const char* lineEnd = static_cast<const char*>(memchr(first, '\n', last - first));
+
+            if ( !lineEnd )
+                break;
+
+            if ( skippingLine )
+                skippingLine = false;
+            else
+                ParseLine(first, lineEnd, batch);
+            first = lineEnd + 1;
+        }
+
+        pending = last - first;
+        if ( pending > MaxLineLength )
+        {
+            ++m_invalidLineCount;
+            skippingLine = true;
+            pending = 0;
+        }
+        else
+        {
+            memmove(buffer.data(), first, pending);
+        }
+
+        if ( !PushBatch(batch) )
+            return;
+    }
+
+    if ( m_stop )
+        return;
+
+    // the last line does not have to end with a new line
+    if ( pending > 0 && !skippingLine )
+        ParseLine(buffer.data(), buffer.data() + pending, batch);
+    if ( PushBatch(batch) )
+        m_inputEnded.store(true, memory_order_release);
+}
+
+bool LineProtocolReader::ReadInput(char* buffer, const size_t size, size_t& readSize)
+{
+    // waiting for the input is interrupted regularly to check whether to stop
+    static constexpr int WaitTimeout = 100; // in milliseconds
+
+#ifdef __WXMSW__
+    const HANDLE input = ::GetStdHandle(STD_INPUT_HANDLE);
+
+    if ( input == NULL || input == INVALID_HANDLE_VALUE )
+        return false;
+
+    const DWORD type = ::GetFileType(input);
+
+    // a console cannot be read without possibly blocking forever
+    if ( type != FILE_TYPE_PIPE && type != FILE_TYPE_DISK )
+        return false;
+
+    while ( !m_stop )
+    {
+        DWORD toRead = static_cast<DWORD>(size);
+
+        if ( type == FILE_TYPE_PIPE )
+        {
+            DWORD available = 0;
+
+            // fails when the pipe was closed by the writer
+            if ( !::PeekNamedPipe(input, nullptr, 0, nullptr, &available, nullptr) )
+                return false;
+
+            if ( available == 0 )
+            {
+                this_thread::sleep_for(chrono::milliseconds(WaitTimeout / 10));
+                continue;
+            }
+            toRead = min(toRead, available);
+        }
+
+        DWORD read = 0;
+
+        if ( !::ReadFile(input, buffer, toRead, &read, nullptr) || read == 0 )
+            return false;
+
+        readSize = read;
+        return true;
+    }
+#else // #ifdef __WXMSW__
+    while ( !m_stop )
+    {
+        pollfd inputFd = { STDIN_FILENO, POLLIN, 0 };
+        const int ready = poll(&inputFd, 1, WaitTimeout);
+
+        if ( ready < 0 && errno != EINTR )
+            return false;
+        if ( ready <= 0 )
+            continue;
+
+        const ssize_t read = ::read(STDIN_FILENO, buffer, size);
+
+        if ( read < 0 && (errno == EINTR || errno == EAGAIN) )
+            continue;
+        if ( read <= 0 )
+            return false;
+
+        readSize = static_cast<size_t>(read);
+        return true;
+    }
+#endif // #else // #ifdef __WXMSW__
+
+    return false;
+}
+
+void LineProtocolReader::ParseLine(const char* first, const char* last, Batch& batch)
+{
+    if ( last > first && last[-1] == '\r' )
+        --last;
+
+    first = find_if_not(first, last, IsSeparator);
+    if ( first == last || *first == '#' )
+        return;
+
+    const char* seriesLast = find_if(first, last, IsSeparator);
+    const char* timestampFirst = find_if_not(seriesLast, last, IsSeparator);
+    const char* timestampLast = find_if(timestampFirst, last, IsSeparator);
+    const char* valueFirst = find_if_not(timestampLast, last, IsSeparator);
+    const char* valueLast = find_if(valueFirst, last, IsSeparator);
+    Point point;
+
+    // nothing but separators can follow the value
+    if ( find_if_not(valueLast, last, IsSeparator) != last
+         || !ParseTimestamp(timestampFirst, timestampLast, point.timestamp)
+         || !CSVImporter::ParseDouble(valueFirst, valueLast, point.value) )
+    {
+        ++m_invalidLineCount;
+        return;
+    }
+
+    const auto result = m_seriesIndices.emplace(string(first, seriesLast), m_seriesIndices.size());
+
+    if ( result.second )
+        batch.newSeriesNames.push_back(wxString::FromUTF8(first, seriesLast - first));
+
+    point.seriesIdx = result.first->second;
+    batch.points.push_back(point);
+}
+
+bool LineProtocolReader::PushBatch(Batch& batch)
+{
+    if ( batch.points.empty() )
+        return true;
+
+    const size_t pointCount = batch.points.size();
+
+    // the queue is full when the GUI thread cannot keep up,
+    // waiting also slows down the process writing the input
+    while ( !m_queue.TryPush(move(batch)) )
+    {
+        if ( m_stop )
+            return false;
+        this_thread::sleep_for(chrono::milliseconds(1));
+    }
+
+    m_pointCount += pointCount;
+    batch.newSeriesNames.clear();
+    batch.points.clear();
+    return true;
+}
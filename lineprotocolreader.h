@@ -0,0 +1,107 @@
+///////////////////////////////////////////////////////////////////////////////
+// Project:     wxECharts
+// Home:        https://github.com/PBfordev/wxecharts
+// File Name:   lineprotocolreader.h
+// Purpose:     Declaration of line protocol reader for live data
+// Author:      PB
+// Created:     2026-10-18
+// Copyright:   (c) 2026 PB
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <wx/string.h>
+
+#include "spscqueue.h"
+
+/*****************************************************************
+
+LineProtocolReader
+---------------
+reads timestamped values of live series from the standard
+input, e.g., piped from another process, in a worker thread
+
+Each line contains one value as
+
+  <series> <timestamp> <value>
+
+where the fields are separated by spaces, tabs or commas,
+series is the series name, timestamp is in milliseconds since
+the Unix epoch and value is a number with the decimal point,
+an empty value is NaN. Empty lines and lines starting with '#'
+are skipped.
+
+The values parsed from every chunk of the input read at once
+are passed as one batch through a lock-free queue, from which
+the GUI thread pops them with TryPop(), usually on a timer.
+When the queue is full, the reader waits, so that a fast
+producer is slowed down instead of the memory growing.
+
+******************************************************************/
+
+class LineProtocolReader final
+{
+public:
+    struct Point
+    {
+        size_t seriesIdx;
+        int64_t timestamp;
+        double value;
+    };
+
+    struct Batch
+    {
+        // the series which appeared for the first time in this batch,
+        // their indices continue after the series from previous batches
+        std::vector<wxString> newSeriesNames;
+        std::vector<Point> points;
+    };
+
+    LineProtocolReader();
+    ~LineProtocolReader();
+
+    bool Start();
+    // waits for the worker thread to finish, the queued batches are discarded
+    void Stop();
+
+    // called only from one thread, usually the GUI one
+    bool TryPop(Batch& batch);
+
+    // true after the end of input was reached and all the batches popped
+    bool IsFinished() const;
+
+    size_t GetPointCount() const;
+    size_t GetInvalidLineCount() const;
+private:
+    // batches of values parsed from up to ReadBufferSize bytes
+    static constexpr size_t QueueCapacity = 256;
+    static constexpr size_t ReadBufferSize = 64 * 1024;
+    // longer lines are skipped as invalid
+    static constexpr size_t MaxLineLength = 64 * 1024;
+
+    SPSCQueue<Batch> m_queue{QueueCapacity};
+    std::thread m_thread;
+    std::atomic<bool> m_stop{false};
+    std::atomic<bool> m_inputEnded{false};
+    std::atomic<size_t> m_pointCount{0};
+    std::atomic<size_t> m_invalidLineCount{0};
+
+    // used only in the worker thread
+    std::unordered_map<std::string, size_t> m_seriesIndices;
+
+    // runs in the worker thread
+    void Read();
+    // returns false when stopped or the input ended
+    bool ReadInput(char* buffer, const size_t size, size_t& readSize);
+    void ParseLine(const char* first, const char* last, Batch& batch);
+    // returns false when stopped
+    bool PushBatch(Batch& batch);
+};
@@ -16,9 +16,11 @@
 #include <wx/grid.h>
 #include <wx/mstream.h>
 #include <wx/numdlg.h>
+#include <wx/progdlg.h>
 #include <wx/splitter.h>
 #include <wx/statline.h>
 #include <wx/stdpaths.h>
+#include <wx/stopwatch.h>
 #include <wx/tokenzr.h>
 #include <wx/webview.h>
 
@@ -27,8 +29,19 @@
     #include <wx/msw/private/comptr.h>
 #endif // #ifdef __WXMSW__
 
+#include "benchmarks.h"
 #include "chartdlgs.h"
+#include "chartgridtable.h"
+#include "chartpreview.h"
+#include "chartsnapshot.h"
+#include "chartwindow.h"
+#include "csvimporter.h"
+#include "lineprotocolreader.h"
+#include "metricslistener.h"
 #include "mainframe.h"
+#include "sharedringbuffer.h"
+#include "webkitprofile.h"
+#include "webviewfactory.h"
 
 #if USING_WEBVIEW_EDGE
     #include <WebView2.h>
@@ -40,12 +53,18 @@
 
 #include <json.hpp>
 
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <random>
+
 using namespace std;
 
 using json = nlohmann::ordered_json;
 
 wxEChartsMainFrame::wxEChartsMainFrame(wxWindow* parent, const wxString& chartAssetsFolder)
-    : wxFrame(parent, wxID_ANY, wxTheApp->GetAppDisplayName())
+    : wxFrame(parent, wxID_ANY, wxTheApp->GetAppDisplayName()),
+      m_chartAssetsFolder(chartAssetsFolder)
 {
     SetMinClientSize(FromDIP(wxSize(600, 400)));
 
@@ -53,8 +72,29 @@ wxEChartsMainFrame::wxEChartsMainFrame(wxWindow* parent, const wxString& chartAs
 
     menu->Append(ID_CHART_COLORS, _("Change Chart &Colors...\tCtrl+C"));
     menu->Append(ID_CHART_SIZING_OPTIONS,  _("Change Chart Sizing &Options...\tCtrl+O"));
+    menu->Append(ID_CHART_RENDERING_OPTIONS, _("Change Chart &Rendering Options..."));
+    menu->AppendCheckItem(ID_RESIZE_SETTLE_MODE, _("Render Chart After Resi&zing Settles"));
+    menu->Append(ID_SERIES_PRECISION, _("Change Series &Precision..."));
     menu->AppendSeparator();
     menu->Append(wxID_SAVE, _("&Save chart as PNG...\tCtrl+S"));
+    menu->Append(ID_SAVE_CHART_PREVIEW, _("Save Native Chart Pre&view as PNG..."));
+    menu->AppendSeparator();
+    menu->Append(ID_APPEND_GENERATED_DATA, _("Append &Generated Data...\tCtrl+G"));
+    menu->Append(ID_NEW_TIME_SERIES, _("New &Time Series...\tCtrl+T"));
+    menu->Append(ID_OPEN_DATA_FILE, _("Open Data &File...\tCtrl+F"));
+    menu->Append(ID_SAVE_DATA_FILE, _("Save D&ata File...\tCtrl+Shift+S"));
+    menu->Append(ID_IMPORT_CSV, _("&Import CSV or TSV File...\tCtrl+I"));
+    menu->AppendCheckItem(ID_LIVE_DATA, _("&Live Data\tCtrl+L"));
+    menu->AppendCheckItem(ID_METRICS_LISTENER, _("Live &Metrics\tCtrl+M"));
+    menu->AppendCheckItem(ID_SHARED_RING_BUFFER, _("Live S&hared Memory...\tCtrl+H"));
+    menu->AppendCheckItem(ID_WORKER_UPDATES, _("Updates from &Worker Threads\tCtrl+U"));
+    menu->Append(ID_SERIES_STATISTICS, _("Series Stat&istics in Background\tCtrl+Shift+T"));
+    menu->Append(ID_BENCHMARK_JSON_SERIALIZERS, _("&Benchmark JSON Serializers"));
+    menu->Append(ID_BENCHMARK_DATA_FILE, _("Benchmark Saving and Opening Data Fil&e"));
+    menu->Append(ID_BENCHMARK_TASK_POOL, _("Benchmark &Parallel Serializing with Threads"));
+    menu->Append(ID_BENCHMARK_WEBVIEW_STARTUP, _("Benchmark &WebView Startup and Memory"));
+    menu->Append(ID_BENCHMARK_CHART_WINDOWS, _("Benchmark Memory of Multiple Chart Wi&ndows"));
+    menu->Append(ID_SENT_UPDATE_STATISTICS, _("Sent &Update Statistics"));
     menu->AppendSeparator();
     menu->Append(ID_SHOW_DEVTOOLS,  _("Show &DevTools\tCtrl+D"));
 
@@ -64,216 +104,1371 @@ wxEChartsMainFrame::wxEChartsMainFrame(wxWindow* parent, const wxString& chartAs
 
     Bind(wxEVT_MENU, &wxEChartsMainFrame::OnChartColors, this, ID_CHART_COLORS);
     Bind(wxEVT_MENU, &wxEChartsMainFrame::OnChartSizingOptions, this, ID_CHART_SIZING_OPTIONS);
+    Bind(wxEVT_MENU, &wxEChartsMainFrame::OnChartRenderingOptions, this, ID_CHART_RENDERING_OPTIONS);
+    Bind(wxEVT_MENU, &wxEChartsMainFrame::OnResizeSettleMode, this, ID_RESIZE_SETTLE_MODE);
+    Bind(wxEVT_MENU, &wxEChartsMainFrame::OnSeriesPrecision, this, ID_SERIES_PRECISION);
     Bind(wxEVT_MENU, &wxEChartsMainFrame::OnChartSave, this, wxID_SAVE);
+    Bind(wxEVT_MENU, &wxEChartsMainFrame::OnSaveChartPreview, this, ID_SAVE_CHART_PREVIEW);
+    Bind(wxEVT_MENU, &wxEChartsMainFrame::OnAppendGeneratedData, this, ID_APPEND_GENERATED_DATA);
+    Bind(wxEVT_MENU, &wxEChartsMainFrame::OnNewTimeSeries, this, ID_NEW_TIME_SERIES);
+    Bind(wxEVT_MENU, &wxEChartsMainFrame::OnOpenDataFile, this, ID_OPEN_DATA_FILE);
+    Bind(wxEVT_MENU, &wxEChartsMainFrame::OnSaveDataFile, this, ID_SAVE_DATA_FILE);
+    Bind(wxEVT_MENU, &wxEChartsMainFrame::OnImportCSV, this, ID_IMPORT_CSV);
+    Bind(wxEVT_MENU, &wxEChartsMainFrame::OnLiveData, this, ID_LIVE_DATA);
+    Bind(wxEVT_MENU, &wxEChartsMainFrame::OnMetricsListener, this, ID_METRICS_LISTENER);
+    Bind(wxEVT_MENU, &wxEChartsMainFrame::OnSharedRingBuffer, this, ID_SHARED_RING_BUFFER);
+    Bind(wxEVT_MENU, &wxEChartsMainFrame::OnWorkerUpdates, this, ID_WORKER_UPDATES);
+    Bind(wxEVT_MENU, &wxEChartsMainFrame::OnSeriesStatistics, this, ID_SERIES_STATISTICS);
+    Bind(wxEVT_MENU, &wxEChartsMainFrame::OnBenchmarkJSONSerializers, this, ID_BENCHMARK_JSON_SERIALIZERS);
+    Bind(wxEVT_MENU, &wxEChartsMainFrame::OnBenchmarkDataFile, this, ID_BENCHMARK_DATA_FILE);
+    Bind(wxEVT_MENU, &wxEChartsMainFrame::OnBenchmarkTaskPool, this, ID_BENCHMARK_TASK_POOL);
+    Bind(wxEVT_MENU, &wxEChartsMainFrame::OnBenchmarkWebViewStartup, this, ID_BENCHMARK_WEBVIEW_STARTUP);
+    Bind(wxEVT_MENU, &wxEChartsMainFrame::OnBenchmarkChartWindows, this, ID_BENCHMARK_CHART_WINDOWS);
+    Bind(wxEVT_MENU, &wxEChartsMainFrame::OnSentUpdateStatistics, this, ID_SENT_UPDATE_STATISTICS);
     Bind(wxEVT_MENU, &wxEChartsMainFrame::OnShowDevTools, this, ID_SHOW_DEVTOOLS);
 
-    InitChartData();
+    // the chart is not updated while the frame is minimized
+    Bind(wxEVT_ICONIZE, &wxEChartsMainFrame::OnIconize, this);
+
+    m_liveDataTimer.SetOwner(this);
+    Bind(wxEVT_TIMER, &wxEChartsMainFrame::OnLiveDataTimer, this, m_liveDataTimer.GetId());
+
+    m_CSVImportProgressTimer.SetOwner(this);
+    Bind(wxEVT_TIMER, &wxEChartsMainFrame::OnCSVImportProgressTimer, this, m_CSVImportProgressTimer.GetId());
+
+    m_stdinReaderTimer.SetOwner(this);
+    Bind(wxEVT_TIMER, &wxEChartsMainFrame::OnStdinReaderTimer, this, m_stdinReaderTimer.GetId());
+
+    m_metricsTimer.SetOwner(this);
+    Bind(wxEVT_TIMER, &wxEChartsMainFrame::OnMetricsTimer, this, m_metricsTimer.GetId());
+
+    m_sharedRingBufferTimer.SetOwner(this);
+    Bind(wxEVT_TIMER, &wxEChartsMainFrame::OnSharedRingBufferTimer, this, m_sharedRingBufferTimer.GetId());
+
+    m_chartWindowsBenchmarkTimer.SetOwner(this);
+    Bind(wxEVT_TIMER, &wxEChartsMainFrame::OnChartWindowsBenchmarkTimer, this, m_chartWindowsBenchmarkTimer.GetId());
+
+    // called from a worker thread, CallAfter() is thread-safe
+    m_chartHelper.SetPostedUpdatesHandler([this]() { CallAfter(&wxEChartsMainFrame::OnPostedUpdates); });
+    // large chart updates are prepared in worker threads
+    m_chartHelper.SetChartUpdateReadyHandler([this]() { CallAfter(&wxEChartsMainFrame::OnChartUpdateReady); });
+
+    InitChartData(m_chartHelper);
 
     wxSplitterWindow* mainSplitter = new wxSplitterWindow(this, wxID_ANY, wxDefaultPosition, wxDefaultSize,
                                             wxSP_BORDER | wxSP_LIVE_UPDATE);
     wxSplitterWindow* topSplitter = new wxSplitterWindow(mainSplitter, wxID_ANY, wxDefaultPosition, wxDefaultSize,
                                             wxSP_BORDER | wxSP_LIVE_UPDATE);
 
-    wxPanel* gridAndHelpPanel = new wxPanel(topSplitter);
-    wxBoxSizer* gridAndHelpPanelSizer = new wxBoxSizer(wxVERTICAL);
+    wxPanel* gridAndHelpPanel = new wxPanel(topSplitter);
+    wxBoxSizer* gridAndHelpPanelSizer = new wxBoxSizer(wxVERTICAL);
+
+    CreateGrid(gridAndHelpPanel);
+    gridAndHelpPanelSizer->Add(m_grid, wxSizerFlags().Expand().Border());
+
+    const auto helpText = "To interact with the chart:\n"
+                          "* use the Chart menu,\n"
+                          "* change a value in the grid,\n"
+                          "* doubleclick a data point or the y axis,\n"
+                          "* right click the chart window.\n";
+
+    wxTextCtrl* helpCtrl = new wxTextCtrl(gridAndHelpPanel, wxID_ANY, helpText, wxDefaultPosition, wxDefaultSize, wxTE_MULTILINE | wxTE_READONLY);
+    helpCtrl->SetBackgroundColour(gridAndHelpPanel->GetBackgroundColour());
+    gridAndHelpPanelSizer->Add(helpCtrl, wxSizerFlags().Expand().Border());
+
+    gridAndHelpPanel->SetSizer(gridAndHelpPanelSizer);
+
+    CreateWebView(topSplitter, chartAssetsFolder);
+
+    wxTextCtrl* logCtrl = new wxTextCtrl(mainSplitter, wxID_ANY, wxEmptyString, wxDefaultPosition, wxDefaultSize, wxTE_MULTILINE | wxTE_READONLY | wxTE_RICH2);
+    wxLog::SetActiveTarget(new wxLogTextCtrl(logCtrl));
+    wxLog::DisableTimestamp();
+
+    topSplitter->SetSashGravity(0);
+    topSplitter->SetMinimumPaneSize(FromDIP(20));
+    topSplitter->SplitVertically(gridAndHelpPanel, m_webView, gridAndHelpPanel->GetBestWidth(-1));
+    topSplitter->Bind(wxEVT_SPLITTER_DOUBLECLICKED, [topSplitter, gridAndHelpPanel](wxSplitterEvent&)
+        { topSplitter->SetSashPosition(gridAndHelpPanel->GetBestWidth(-1)); });
+
+    mainSplitter->SetSashGravity(1);
+    mainSplitter->SetMinimumPaneSize(FromDIP(100));
+
+    mainSplitter->SplitHorizontally(topSplitter, logCtrl, -FromDIP(60));
+
+    wxLogMessage("Using chart assets folder '%s'.", chartAssetsFolder);
+    wxLogMessage("Using wxWebView backend '%s'.", wxWebView::GetBackendVersionInfo(m_webViewBackend).ToString());
+}
+
+wxEChartsMainFrame::~wxEChartsMainFrame()
+{
+    // the workers use the chart helper
+    m_stopUpdateWorkers = true;
+    for ( auto& worker : m_updateWorkers )
+        worker.join();
+    m_stopStatistics = true;
+    if ( m_statisticsThread.joinable() )
+        m_statisticsThread.join();
+    if ( m_benchmarkThread.joinable() )
+        m_benchmarkThread.join();
+    // stops the workers preparing the chart updates
+    m_chartHelper.SetChartUpdateReadyHandler(nullptr);
+}
+
+void wxEChartsMainFrame::InitChartData(ChartHelper& chartHelper)
+{
+    chartHelper.AddVariableNames({"Variable 1", "Variable 2", "Variable 3"});
+
+    ChartHelper::ValueSeries s;
+
+    s.name = "Group A";
+    s.type = ChartHelper::Bar;
+    s.data = {10, 20, 30};
+    chartHelper.AddSeries(s);
+
+    s.name = "Group B";
+    s.type = ChartHelper::Bar;
+    s.data = {15, 25, 35};
+    chartHelper.AddSeries(s);
+}
+
+void wxEChartsMainFrame::CreateGrid(wxWindow* parent)
+{
+    m_grid = new wxGrid(parent, wxID_ANY);
+    m_grid->SetDefaultRenderer(new wxGridCellFloatRenderer(-1, 1));
+    m_grid->SetDefaultEditor(new wxGridCellFloatEditor(-1, 1));
+    m_grid->EnableDragRowSize(false);
+
+    // the grid values are obtained from the chart helper, as the chart
+    // can have too many variables for the grid to keep its own copy
+    m_gridTable = new ChartGridTable(m_chartHelper);
+    m_grid->SetTable(m_gridTable, true);
+
+    m_grid->Bind(wxEVT_GRID_CELL_CHANGING, &wxEChartsMainFrame::OnGridCellChanging, this);
+    m_grid->Bind(wxEVT_GRID_CELL_CHANGED, &wxEChartsMainFrame::OnGridCellChanged, this);
+}
+
+void wxEChartsMainFrame::CreateWebView(wxWindow* parent, const wxString& assetsFolder)
+{
+    const wxString url = wxString::Format("file://%s", wxFileName(assetsFolder, "wxecharts.html").GetFullPath());
+
+    m_webViewBackend = wxWebViewBackendDefault;
+#if USING_WEBVIEW_EDGE
+    m_webViewBackend = wxWebViewBackendEdge;
+#endif
+
+    m_webViewStopWatch.Start();
+    m_webView = WebViewFactory::Create(parent, url, m_webViewBackend);
+    m_webView->EnableContextMenu(false);
+    m_webView->EnableHistory(false);
+#ifdef __WXGTK__
+    // WebKitWebView exists already, configure it before the page is rendered
+    ConfigureWebView();
+#endif // #ifdef __WXGTK__
+
+    m_webView->Bind(wxEVT_WEBVIEW_SCRIPT_RESULT, &wxEChartsMainFrame::OnWebViewScriptResult, this);
+    if ( m_webView->AddScriptMessageHandler("wxmsg") )
+        m_webView->Bind(wxEVT_WEBVIEW_SCRIPT_MESSAGE_RECEIVED, &wxEChartsMainFrame::OnWebViewMessageReceived, this);
+    else
+        wxLogError(_("Could not install the webview message handler, the application will be unusable."));
+
+#if wxCHECK_VERSION(3, 3, 0)
+    m_webView->Bind(wxEVT_WEBVIEW_CREATED, [this](wxWebViewEvent&){ ConfigureWebView(); });
+#endif // #if wxCHECK_VERSION(3, 3, 0)
+    m_webView->Bind(wxEVT_WEBVIEW_LOADED, &wxEChartsMainFrame::OnWebViewPageLoaded, this);
+    m_webView->Bind(wxEVT_WEBVIEW_ERROR, &wxEChartsMainFrame::OnWebViewError, this);
+}
+
+void wxEChartsMainFrame::ConfigureWebView()
+{
+    if ( m_webViewConfigured )
+        return;
+
+    void* nativeBackend = m_webView->GetNativeBackend();
+
+    if ( !nativeBackend )
+        return;
+
+    m_webViewConfigured = true;
+
+#if USING_WEBVIEW_EDGE
+    ICoreWebView2* webView2 = static_cast<ICoreWebView2*>(nativeBackend);
+    HRESULT hr;
+    wxCOMPtr<ICoreWebView2Settings> settings;
+
+    hr = webView2->get_Settings(&settings);
+    if ( FAILED(hr) )
+    {
+        wxLogError(_("Could not obtain WebView2Settings (error code 0x%08lx)."), (long)hr);
+        return;
+    }
+    settings->put_IsBuiltInErrorPageEnabled(FALSE);
+    settings->put_IsZoomControlEnabled(FALSE);
+
+    wxCOMPtr<ICoreWebView2Settings3> settings3;
+
+    hr = settings->QueryInterface(wxIID_PPV_ARGS(ICoreWebView2Settings3, &settings3));
+    if ( FAILED(hr) )
+    {
+        wxLogError(_("Could not obtain WebView2Settings3 (error code 0x%08lx)."), (long)hr);
+        return;
+    }
+    settings3->put_AreBrowserAcceleratorKeysEnabled(FALSE);
+#elif defined(__WXGTK__)
+    if ( m_webViewBackend == wxWebViewBackendWebKit )
+        WebKitProfile::Apply(m_webView);
+#endif // #elif defined(__WXGTK__)
+}
+
+void wxEChartsMainFrame::OnGridCellChanging(wxGridEvent& e)
+{
+    static constexpr double minAllowedValue = -100;
+    static constexpr double maxAllowedValue = 100;
+
+    double d;
+
+    if ( !e.GetString().ToDouble(&d)
+          || d < minAllowedValue || d > maxAllowedValue )
+    {
+        e.Veto();
+        wxLogError(_("Invalid series value '%s' (col %d, row %d)."), e.GetString(), e.GetCol(), e.GetRow());
+    }
+}
+
+void wxEChartsMainFrame::OnIconize(wxIconizeEvent& e)
+{
+    e.Skip();
+    m_chartHelper.SetChartShown(!e.IsIconized());
+}
+
+void wxEChartsMainFrame::OnGridCellChanged(wxGridEvent&)
+{
+    // the value was already set by the grid table
+    m_chartHelper.RunChartUpdateSeries();
+}
+
+void wxEChartsMainFrame::OnChartColors(wxCommandEvent&)
+{
+    vector<wxColour> colors;
+
+    if ( !m_chartHelper.GetChartColors(colors) )
+    {
+        wxLogError(_("The chart colors are not known yet."));
+        return;
+    }
+
+    ChartColorsDlg dlg(this, colors);
+
+    if ( dlg.ShowModal() == wxID_OK )
+        m_chartHelper.RunChartSetColors(dlg.GetColors());
+}
+
+void wxEChartsMainFrame::OnChartSizingOptions(wxCommandEvent&)
+{
+    double widthToHeightRatio;
+    int minWidth, minHeight;
+
+    if ( !m_chartHelper.GetChartSizingOptions(widthToHeightRatio, minWidth, minHeight) )
+    {
+        wxLogError(_("The chart sizing options are not known yet."));
+        return;
+    }
+
+    ChartSizingOptionsDlg dlg(this, widthToHeightRatio, minWidth, minHeight);
+
+    if ( dlg.ShowModal() == wxID_OK )
+    {
+        dlg.GetSizingOptions(widthToHeightRatio, minWidth, minHeight);
+        m_chartHelper.RunChartSetSizingOptions(widthToHeightRatio, minWidth, minHeight);
+    }
+}
+
+void wxEChartsMainFrame::OnChartRenderingOptions(wxCommandEvent&)
+{
+    ChartRenderingOptionsDlg dlg(this, m_chartHelper.HasAutomaticRenderingOptions(),
+                                 m_chartHelper.GetRenderingOptions());
+
+    if ( dlg.ShowModal() != wxID_OK )
+        return;
+
+    if ( dlg.IsAutomatic() )
+        m_chartHelper.RunChartSetAutomaticRenderingOptions();
+    else
+        m_chartHelper.RunChartSetRenderingOptions(dlg.GetRenderingOptions());
+}
+
+void wxEChartsMainFrame::OnResizeSettleMode(wxCommandEvent& e)
+{
+    // dragging the live-update splitters resizes the chart many times
+    m_chartHelper.RunChartSetResizeSettleMode(e.IsChecked());
+}
+
+void wxEChartsMainFrame::OnSeriesPrecision(wxCommandEvent&)
+{
+    const size_t seriesCount = m_chartHelper.GetSeriesCount();
+
+    if ( seriesCount == 0 )
+    {
+        wxLogError(_("There are no series."));
+        return;
+    }
+
+    ChartHelper::ValuePrecision precision;
+
+    m_chartHelper.GetSeriesPrecision(0, precision);
+
+    const long digits = wxGetNumberFromUser(_("Enter the number of significant digits of the values sent to the chart (0 for all)"),
+                          _("Digits"), _("Series Precision"),
+                          precision.type == ChartHelper::ValuePrecision::SignificantDigits ? precision.digits : 0,
+                          0, ChartHelper::ValuePrecision::MaxDigits, this);
+
+    if ( digits == -1 )
+        return;
+
+    precision = ChartHelper::ValuePrecision();
+    if ( digits > 0 )
+    {
+        precision.type = ChartHelper::ValuePrecision::SignificantDigits;
+        precision.digits = static_cast<int>(digits);
+    }
+
+    for ( size_t s = 0; s < seriesCount; ++s )
+        m_chartHelper.SetSeriesPrecision(s, precision);
+    m_chartHelper.RunChartUpdateSeries();
+}
+
+void wxEChartsMainFrame::OnChartSave(wxCommandEvent&)
+{
+    const int chartWidth = wxGetNumberFromUser(_("Enter chart width (height is computed with the width/height ratio"),
+                             _("Width"), _("Save chart"),
+                             1000, 400, 4000, this);
+
+    if ( chartWidth != -1 )
+        m_chartHelper.RunChartGetPNG(chartWidth);;
+}
+
+void wxEChartsMainFrame::OnSaveChartPreview(wxCommandEvent&)
+{
+    const shared_ptr<const ChartSnapshot> snapshot = m_chartHelper.PublishSnapshot();
+    vector<wxColour> colors;
+
+    // the colors are not known until the chart is created
+    if ( !m_chartHelper.GetChartColors(colors) )
+        colors = ChartPreview::GetDefaultColors();
+
+    wxSize size = m_webView->GetClientSize();
+
+    if ( size.x < 100 || size.y < 100 )
+        size = FromDIP(wxSize(800, 600));
+
+    wxStopWatch stopWatch;
+    const wxImage image = ChartPreview::Render(*snapshot, colors, size);
+
+    wxLogMessage(_("Native chart preview of %zu values (%d x %d pixels) rendered in %ld ms."),
+                 snapshot->GetVariableCount() * snapshot->GetSeriesCount(), size.x, size.y, stopWatch.Time());
+
+    if ( !image.IsOk() )
+        return;
+
+    const wxString fileName = wxFileSelector(_("Select file name for chart preview image"), "", "chart-preview", "",
+                                _("PNG files (*.png)|*.png"), wxFD_SAVE | wxFD_OVERWRITE_PROMPT, this);
+
+    if ( fileName.empty() )
+        return;
+
+    if ( !image.SaveFile(fileName, wxBITMAP_TYPE_PNG) )
+        wxLogError(_("Could not save the chart preview to '%s'."), fileName);
+}
+
+namespace {
+
+// random walk within the range allowed in the grid
+void GenerateRandomWalk(mt19937& generator, double value, const size_t count, vector<double>& data)
+{
+    normal_distribution<double> step(0, 1);
+
+    data.reserve(data.size() + count);
+    for ( size_t i = 0; i < count; ++i )
+    {
+        value = max(-100.0, min(100.0, value + step(generator)));
+        data.push_back(value);
+    }
+}
+
+} // anonymous namespace
+
+// for demonstration of the level of detail with a large number of variables
+void wxEChartsMainFrame::OnAppendGeneratedData(wxCommandEvent&)
+{
+    if ( m_chartHelper.HasDataFile() )
+    {
+        wxLogError(_("Data cannot be appended to a data file."));
+        return;
+    }
+    if ( m_chartHelper.IsLiveMode() )
+    {
+        wxLogError(_("Data cannot be appended to live data."));
+        return;
+    }
+
+    const long count = wxGetNumberFromUser(_("Enter the number of variables to append to all series"),
+                         _("Count"), _("Append Generated Data"),
+                         1000000, 1, 100000000, this);
+
+    if ( count == -1 )
+        return;
+
+    wxBusyCursor busyCursor;
+    const size_t oldCount = m_chartHelper.GetVariableNamesCount();
+    vector<vector<double>> seriesData(m_chartHelper.GetSeriesCount());
+    mt19937 generator(static_cast<unsigned>(oldCount));
+    bool appended;
+
+    for ( size_t s = 0; s < seriesData.size(); ++s )
+    {
+        double value = 0;
+
+        if ( oldCount > 0 )
+            m_chartHelper.GetSeriesValue(s, oldCount - 1, value);
+        GenerateRandomWalk(generator, value, count, seriesData[s]);
+    }
+
+    if ( m_chartHelper.IsTimeMode() )
+    {
+        vector<int64_t> timestamps;
+        int64_t timestamp = 0;
+
+        m_chartHelper.GetTimestamp(oldCount - 1, timestamp);
+        timestamps.reserve(count);
+        for ( long i = 0; i < count; ++i )
+            timestamps.push_back(timestamp += 1000);
+        appended = m_chartHelper.AppendData(timestamps, seriesData);
+    }
+    else
+    {
+        vector<wxString> names;
+
+        names.reserve(count);
+        for ( size_t i = 0; i < static_cast<size_t>(count); ++i )
+            names.push_back(wxString::Format("Variable %zu", oldCount + i + 1));
+        appended = m_chartHelper.AppendData(names, seriesData);
+    }
+
+    if ( !appended )
+        return;
+
+    m_gridTable->NotifyRowsAppended(count);
+    m_chartHelper.RunChartUpdateSeries();
+
+    wxLogMessage(_("Appended %ld variables, the chart now has %zu variables."),
+                 count, m_chartHelper.GetVariableNamesCount());
+}
+
+// for demonstration of the time axis, one value per second until now
+void wxEChartsMainFrame::OnNewTimeSeries(wxCommandEvent&)
+{
+    const long count = wxGetNumberFromUser(_("Enter the number of values in each series"),
+                         _("Count"), _("New Time Series"),
+                         3600, 2, 100000000, this);
+
+    if ( count == -1 )
+        return;
+
+    StopLiveData();
+
+    wxBusyCursor busyCursor;
+    const int64_t now = wxGetUTCTimeMillis().GetValue() / 1000 * 1000;
+    vector<int64_t> timestamps;
+    mt19937 generator(static_cast<unsigned>(count));
+
+    timestamps.reserve(count);
+    for ( long i = 0; i < count; ++i )
+        timestamps.push_back(now - static_cast<int64_t>(count - 1 - i) * 1000);
+
+    m_chartHelper.Clear();
+    m_chartHelper.AddTimestamps(timestamps);
+
+    for ( const auto name : {"Sensor A", "Sensor B"} )
+    {
+        ChartHelper::ValueSeries s;
+
+        s.name = name;
+        s.type = ChartHelper::Line;
+        GenerateRandomWalk(generator, 0, count, s.data);
+        m_chartHelper.AddSeries(s);
+    }
+
+    m_gridTable->NotifyDataReplaced();
+    m_grid->EnableEditing(true);
+    m_chartHelper.RunChartUpdateSeries();
+}
+
+void wxEChartsMainFrame::OnOpenDataFile(wxCommandEvent&)
+{
+    const wxString fileName = wxFileSelector(_("Select chart data file"), "", "", "",
+                                _("Chart data files (*.wxecdata)|*.wxecdata|Arrow files (*.arrow;*.arrows;*.feather)|*.arrow;*.arrows;*.feather|All files (*.*)|*.*"),
+                                wxFD_OPEN | wxFD_FILE_MUST_EXIST, this);
+
+    if ( fileName.empty() )
+        return;
+
+    StopLiveData();
+
+    // called from a worker thread, CallAfter() is thread-safe
+    auto onLODReady = [this]() { CallAfter(&wxEChartsMainFrame::OnDataFileLODReady); };
+    wxStopWatch stopWatch;
+
+    if ( !m_chartHelper.OpenDataFile(fileName, onLODReady) )
+        return;
+
+    const long openTime = stopWatch.Time();
+    const wxString options = m_chartHelper.GetDataFileOptions();
+
+    m_gridTable->NotifyDataReplaced();
+    m_grid->EnableEditing(false);
+    if ( !options.empty() )
+        m_chartHelper.RunChartSetOptions(options);
+    m_chartHelper.RunChartUpdateSeries();
+
+    wxLogMessage(_("Opened data file '%s' with %zu series of %zu values in %ld ms."),
+                 fileName, m_chartHelper.GetSeriesCount(), m_chartHelper.GetVariableNamesCount(), openTime);
+}
+
+void wxEChartsMainFrame::OnDataFileLODReady()
+{
+    wxLogMessage(_("The level of detail index for the data file was built."));
+    m_chartHelper.RunChartUpdateSeries();
+}
+
+void wxEChartsMainFrame::OnSaveDataFile(wxCommandEvent&)
+{
+    if ( m_chartHelper.IsLiveMode() )
+    {
+        wxLogError(_("Live data cannot be saved."));
+        return;
+    }
+
+    const wxString fileName = wxFileSelector(_("Save chart data file"), "", "", "wxecdata",
+                                _("Chart data files (*.wxecdata)|*.wxecdata"),
+                                wxFD_SAVE | wxFD_OVERWRITE_PROMPT, this);
+
+    if ( fileName.empty() )
+        return;
+
+    const bool compress = wxMessageBox(_("Compress the data?\n\n"
+                                         "Compressed data are smaller, but they have to be "
+                                         "loaded to memory instead of being used in place."),
+                                       _("Save Data File"), wxYES_NO | wxNO_DEFAULT, this) == wxYES;
+    wxBusyCursor busyCursor;
+    wxStopWatch stopWatch;
+
+    if ( !m_chartHelper.SaveDataFile(fileName, m_chartHelper.GetChartOptions(), compress) )
+    {
+        wxLogError(_("Could not save data file '%s'."), fileName);
+        return;
+    }
+
+    wxLogMessage(_("Saved %zu series of %zu values to '%s' in %ld ms."),
+                 m_chartHelper.GetSeriesCount(), m_chartHelper.GetVariableNamesCount(),
+                 fileName, stopWatch.Time());
+}
+
+void wxEChartsMainFrame::OnImportCSV(wxCommandEvent&)
+{
+    if ( m_CSVImporter )
+    {
+        wxLogError(_("Another file is being imported."));
+        return;
+    }
+
+    const wxString fileName = wxFileSelector(_("Select CSV or TSV file"), "", "", "",
+                                _("CSV and TSV files (*.csv;*.tsv;*.txt)|*.csv;*.tsv;*.txt|All files (*.*)|*.*"),
+                                wxFD_OPEN | wxFD_FILE_MUST_EXIST, this);
+
+    if ( fileName.empty() )
+        return;
+
+    unique_ptr<CSVImporter> importer(new CSVImporter);
+
+    // called from a worker thread, CallAfter() is thread-safe
+    auto onDone = [this]() { CallAfter(&wxEChartsMainFrame::OnCSVImportDone); };
+
+    if ( !importer->Start(fileName, onDone) )
+        return;
+
+    m_CSVImporter = move(importer);
+
+    // the importer runs in worker threads, the dialog only shows
+    // its progress and allows cancelling it
+    m_CSVImportProgressDlg.reset(new wxProgressDialog(_("Import"),
+                                   wxString::Format(_("Importing '%s'..."), fileName), 1000, this,
+                                   wxPD_CAN_ABORT | wxPD_ELAPSED_TIME | wxPD_REMAINING_TIME));
+    m_CSVImportProgressTimer.Start(100);
+}
+
+void wxEChartsMainFrame::OnCSVImportProgressTimer(wxTimerEvent&)
+{
+    if ( !m_CSVImporter || !m_CSVImportProgressDlg )
+        return;
+
+    // the maximum would close the dialog before the import is done
+    const int progress = min(999, static_cast<int>(m_CSVImporter->GetProgress() * 1000));
+
+    if ( !m_CSVImportProgressDlg->Update(progress) )
+        m_CSVImporter->Cancel();
+}
+
+void wxEChartsMainFrame::OnCSVImportDone()
+{
+    unique_ptr<CSVImporter> importer(move(m_CSVImporter));
+
+    m_CSVImportProgressTimer.Stop();
+    m_CSVImportProgressDlg.reset();
+
+    if ( !importer )
+        return;
+
+    switch ( importer->GetStatus() )
+    {
+        case CSVImporter::Cancelled:
+            wxLogMessage(_("Import cancelled."));
+            return;
+        case CSVImporter::Failed:
+            wxLogError(_("Import failed: %s"), importer->GetError());
+            return;
+        default:
+            break;
+    }
+
+    vector<wxString> variableNames;
+    vector<ChartHelper::ValueSeries> series;
+
+    StopLiveData();
+
+    wxBusyCursor busyCursor;
+
+    if ( !importer->TakeData(variableNames, series)
+         || !m_chartHelper.SetData(move(variableNames), move(series)) )
+        return;
+
+    m_gridTable->NotifyDataReplaced();
+    m_grid->EnableEditing(true);
+    m_chartHelper.RunChartUpdateSeries();
+
+    wxLogMessage(_("Imported %zu series of %zu values in %ld ms."),
+                 m_chartHelper.GetSeriesCount(), m_chartHelper.GetVariableNamesCount(),
+                 importer->GetElapsedTime());
+}
+
+// for demonstration of the live data, showing the last 10 minutes
+// of values pushed 10 times per second
+void wxEChartsMainFrame::OnLiveData(wxCommandEvent& e)
+{
+    static constexpr size_t capacity = 10 * 60 * 10;
+    static constexpr int pushInterval = 100; // in milliseconds
+
+    if ( !e.IsChecked() )
+    {
+        m_liveDataTimer.Stop();
+        return;
+    }
+
+    StopStdinIngest();
+    StopMetricsListener();
+    DetachSharedRingBuffer();
+    StopUpdateWorkers();
+    if ( !m_chartHelper.StartLiveMode(capacity, {"Sensor A", "Sensor B"}) )
+    {
+        GetMenuBar()->Check(ID_LIVE_DATA, false);
+        return;
+    }
+
+    m_gridTable->NotifyDataReplaced();
+    m_grid->EnableEditing(false);
+    m_chartHelper.RunChartUpdateSeries();
+    m_liveDataTimer.Start(pushInterval);
+}
+
+void wxEChartsMainFrame::OnLiveDataTimer(wxTimerEvent&)
+{
+    const int64_t timestamp = wxGetUTCTimeMillis().GetValue();
+    const size_t count = m_chartHelper.GetVariableNamesCount();
+    mt19937 generator(static_cast<unsigned>(timestamp));
+    vector<double> values;
+
+    for ( size_t s = 0; s < m_chartHelper.GetSeriesCount(); ++s )
+    {
+        double value = 0;
+
+        if ( count > 0 )
+            m_chartHelper.GetSeriesValue(s, count - 1, value);
+        GenerateRandomWalk(generator, value, 1, values);
+    }
+
+    if ( !m_chartHelper.PushLiveValues(timestamp, values) )
+    {
+        StopLiveData();
+        return;
+    }
+
+    m_gridTable->NotifyLiveValuesPushed();
+    m_chartHelper.RunChartUpdateSeries();
+}
+
+void wxEChartsMainFrame::StopLiveData()
+{
+    m_liveDataTimer.Stop();
+    GetMenuBar()->Check(ID_LIVE_DATA, false);
+    StopStdinIngest();
+    StopMetricsListener();
+    DetachSharedRingBuffer();
+    StopUpdateWorkers();
+
+    // the next live source must not push to the series of this one
+    if ( m_chartHelper.IsLiveMode() )
+    {
+        m_chartHelper.StopLiveMode();
+        m_gridTable->NotifyDataReplaced();
+        m_grid->EnableEditing(true);
+        if ( m_webViewConfigured )
+            m_chartHelper.RunChartUpdateSeries();
+    }
+}
+
+bool wxEChartsMainFrame::AddLiveSeries(const std::vector<wxString>& names, const size_t capacity)
+{
+    if ( names.empty() )
+        return true;
+
+    for ( const auto& name : names )
+    {
+        const bool added = m_chartHelper.IsLiveMode() ? m_chartHelper.AddLiveSeries(name)
+                                                      : m_chartHelper.StartLiveMode(capacity, {name});
+        if ( !added )
+            return false;
+    }
+
+    m_gridTable->NotifyDataReplaced();
+    m_grid->EnableEditing(false);
+    return true;
+}
+
+void wxEChartsMainFrame::StartStdinIngest(const size_t capacity)
+{
+    wxCHECK_RET(capacity > 0, "Invalid capacity");
+
+    StopLiveData();
+
+    m_stdinReader.reset(new LineProtocolReader);
+    m_stdinCapacity = capacity;
+    m_stdinIgnoredPointCount = 0;
+    if ( !m_stdinReader->Start() )
+    {
+        m_stdinReader.reset();
+        return;
+    }
+
+    if ( m_webViewConfigured )
+        m_stdinReaderTimer.Start(StdinReaderInterval);
+    wxLogMessage(_("Reading live values from the standard input."));
+}
+
+// the values read since the last tick are all pushed at once,
+// so that no matter how many there are, the chart is updated
+// at most once per tick, i.e., frame
+void wxEChartsMainFrame::OnStdinReaderTimer(wxTimerEvent&)
+{
+    LineProtocolReader::Batch batch;
+    // the values with the same timestamp are pushed together,
+    // the missing ones are NaN
+    vector<double> row;
+    int64_t rowTimestamp = 0;
+    bool hasRow = false;
+    bool seriesAdded = false;
+    bool pushed = false;
+
+    auto pushRow = [&]()
+    {
+        if ( !hasRow )
+            return true;
+
+        hasRow = false;
+        pushed = true;
+        return m_chartHelper.PushLiveValues(rowTimestamp, row);
+    };
+
+    while ( m_stdinReader->TryPop(batch) )
+    {
+        if ( !AddLiveSeries(batch.newSeriesNames, m_stdinCapacity) )
+        {
+            StopStdinIngest();
+            return;
+        }
+        seriesAdded = seriesAdded || !batch.newSeriesNames.empty();
+        row.resize(m_chartHelper.GetSeriesCount(), numeric_limits<double>::quiet_NaN());
+
+        for ( const auto& point : batch.points )
+        {
+            if ( hasRow && point.timestamp == rowTimestamp )
+            {
+                row[point.seriesIdx] = point.value;
+                continue;
+            }
+
+            if ( !pushRow() )
+            {
+                StopStdinIngest();
+                return;
+            }
+
+            // the live series cannot go back in time, compared
+            // with the newest values including the row just pushed
+            int64_t newestTimestamp = 0;
+            const size_t count = m_chartHelper.GetVariableNamesCount();
+
+            if ( count > 0 && m_chartHelper.GetTimestamp(count - 1, newestTimestamp)
+                 && point.timestamp < newestTimestamp )
+            {
+                ++m_stdinIgnoredPointCount;
+                continue;
+            }
+
+            row.assign(row.size(), numeric_limits<double>::quiet_NaN());
+            row[point.seriesIdx] = point.value;
+            rowTimestamp = point.timestamp;
+            hasRow = true;
+        }
+    }
+
+    if ( !pushRow() )
+    {
+        StopStdinIngest();
+        return;
+    }
+
+    if ( pushed )
+        m_gridTable->NotifyLiveValuesPushed();
+
+    if ( seriesAdded || pushed )
+        m_chartHelper.RunChartUpdateSeries();
+
+    if ( m_stdinReader->IsFinished() )
+    {
+        wxLogMessage(_("The standard input ended: %zu values read, %zu invalid lines and %zu values out of order ignored."),
+                     m_stdinReader->GetPointCount(), m_stdinReader->GetInvalidLineCount(), m_stdinIgnoredPointCount);
+        StopStdinIngest();
+    }
+}
+
+void wxEChartsMainFrame::StopStdinIngest()
+{
+    m_stdinReaderTimer.Stop();
+    m_stdinReader.reset();
+}
+
+bool wxEChartsMainFrame::StartMetricsListener(const uint16_t port, const size_t capacity)
+{
+    wxCHECK(capacity > 0, false);
+
+    StopLiveData();
+
+    m_metricsListener.reset(new MetricsListener);
+    m_metricsCapacity = capacity;
+    if ( !m_metricsListener->Start(port) )
+    {
+        m_metricsListener.reset();
+        return false;
+    }
+
+    if ( m_webViewConfigured )
+        m_metricsTimer.Start(MetricsInterval);
+    GetMenuBar()->Check(ID_METRICS_LISTENER, true);
+    wxLogMessage(_("Listening to metrics on UDP and TCP port %u."), static_cast<unsigned>(port));
+    return true;
+}
+
+// for demonstration of the live metrics, the listener
+// receives the samples from a local test generator
+void wxEChartsMainFrame::OnMetricsListener(wxCommandEvent& e)
+{
+    static constexpr size_t capacity = 10 * 60; // 10 minutes
+    static constexpr size_t samplesPerSecond = 100000;
+
+    if ( !e.IsChecked() )
+    {
+        StopMetricsListener();
+        return;
+    }
+
+    if ( !StartMetricsListener(MetricsListener::DefaultPort, capacity) )
+    {
+        GetMenuBar()->Check(ID_METRICS_LISTENER, false);
+        return;
+    }
+
+    m_metricsGenerator.reset(new MetricsTestGenerator);
+    if ( m_metricsGenerator->Start(MetricsListener::DefaultPort, samplesPerSecond) )
+        wxLogMessage(_("Sending %zu test samples per second."), samplesPerSecond);
+}
+
+// the samples were aggregated by the listener, so no matter
+// how many there are, only one value per metric is pushed
+void wxEChartsMainFrame::OnMetricsTimer(wxTimerEvent&)
+{
+    MetricsListener::Interval interval;
+
+    m_metricsListener->TakeInterval(interval);
+    if ( !AddLiveSeries(interval.newMetricNames, m_metricsCapacity) )
+    {
+        StopMetricsListener();
+        return;
+    }
+
+    if ( interval.aggregates.empty() )
+        return;
+
+    const size_t count = m_chartHelper.GetVariableNamesCount();
+    int64_t timestamp = wxGetUTCTimeMillis().GetValue();
+    int64_t newestTimestamp = 0;
+    vector<double> values;
+
+    // the system clock can be set back
+    if ( count > 0 && m_chartHelper.GetTimestamp(count - 1, newestTimestamp) )
+        timestamp = max(timestamp, newestTimestamp);
+
+    for ( const auto& aggregate : interval.aggregates )
+        values.push_back(aggregate.GetValue());
+
+    if ( !m_chartHelper.PushLiveValues(timestamp, values) )
+    {
+        StopMetricsListener();
+        return;
+    }
+
+    m_gridTable->NotifyLiveValuesPushed();
+    m_chartHelper.RunChartUpdateSeries();
+}
+
+void wxEChartsMainFrame::StopMetricsListener()
+{
+    m_metricsTimer.Stop();
+    m_metricsGenerator.reset();
+    if ( m_metricsListener )
+    {
+        m_metricsListener->Stop();
+        wxLogMessage(_("Stopped listening to metrics: %zu samples received, %zu invalid."),
+                     m_metricsListener->GetSampleCount(), m_metricsListener->GetInvalidSampleCount());
+        m_metricsListener.reset();
+    }
+    GetMenuBar()->Check(ID_METRICS_LISTENER, false);
+}
+
+bool wxEChartsMainFrame::AttachSharedRingBuffer(const wxString& name, const size_t capacity)
+{
+    StopLiveData();
+
+    if ( !m_chartHelper.AttachSharedRingBuffer(name, capacity) )
+        return false;
+
+    const SharedRingBuffer* buffer = m_chartHelper.GetSharedRingBuffer();
+
+    m_gridTable->NotifyDataReplaced();
+    m_grid->EnableEditing(false);
+    // the chart cannot be updated before it is created
+    if ( m_webViewConfigured )
+    {
+        m_chartHelper.RunChartUpdateSeries();
+        m_sharedRingBufferTimer.Start(SharedRingBufferInterval);
+    }
+    GetMenuBar()->Check(ID_SHARED_RING_BUFFER, true);
+    wxLogMessage(_("Reading %zu live series from shared memory '%s' with capacity %zu."),
+                 buffer->GetSeriesNames().size(), buffer->GetName(), buffer->GetCapacity());
+    return true;
+}
+
+void wxEChartsMainFrame::OnSharedRingBuffer(wxCommandEvent& e)
+{
+#ifdef __WXMSW__
+    static const wxString defaultName("Local\\wxECharts");
+#else
+    static const wxString defaultName("/wxECharts");
+#endif
+
+    if ( !e.IsChecked() )
+    {
+        DetachSharedRingBuffer();
+        return;
+    }
+
+    const wxString name = wxGetTextFromUser(_("Enter the name of the shared memory"),
+                                            _("Live Shared Memory"), defaultName, this);
+
+    if ( name.empty() || !AttachSharedRingBuffer(name, 0) )
+        GetMenuBar()->Check(ID_SHARED_RING_BUFFER, false);
+}
+
+// the producer can write any number of values between
+// the ticks but the chart is updated at most once per tick
+void wxEChartsMainFrame::OnSharedRingBufferTimer(wxTimerEvent&)
+{
+    if ( m_chartHelper.ReadSharedRingBuffer() == 0 )
+        return;
+
+    m_gridTable->NotifyLiveValuesPushed();
+    m_chartHelper.RunChartUpdateSeries();
+}
+
+void wxEChartsMainFrame::DetachSharedRingBuffer()
+{
+    const SharedRingBuffer* buffer = m_chartHelper.GetSharedRingBuffer();
+
+    m_sharedRingBufferTimer.Stop();
+    if ( buffer )
+    {
+        wxLogMessage(_("Detached from shared memory '%s': %llu values overwritten before they could be read."),
+                     buffer->GetName(), static_cast<unsigned long long>(buffer->GetLostRowCount()));
+        m_chartHelper.DetachSharedRingBuffer();
+    }
+    GetMenuBar()->Check(ID_SHARED_RING_BUFFER, false);
+}
+
+// for demonstration of updating the chart from worker threads,
+// each worker keeps recomputing the data of its own series
+void wxEChartsMainFrame::OnWorkerUpdates(wxCommandEvent& e)
+{
+    static constexpr size_t workerCount = 4;
+    static constexpr size_t count = 1000;
+
+    if ( !e.IsChecked() )
+    {
+        StopUpdateWorkers();
+        return;
+    }
+
+    StopLiveData();
+
+    vector<wxString> variableNames;
+    vector<ChartHelper::ValueSeries> series(workerCount);
 
-    CreateGrid(gridAndHelpPanel);
-    gridAndHelpPanelSizer->Add(m_grid, wxSizerFlags().Expand().Border());
+    for ( size_t i = 0; i < count; ++i )
+        variableNames.push_back(wxString::Format("Variable %zu", i + 1));
+    for ( size_t s = 0; s < series.size(); ++s )
+    {
+        series[s].name = wxString::Format("Worker %zu", s + 1);
+        series[s].type = ChartHelper::Line;
+        series[s].data.assign(count, 0);
+    }
 
-    const auto helpText = "To interact with the chart:\n"
-                          "* use the Chart menu,\n"
-                          "* change a value in the grid,\n"
-                          "* doubleclick a data point or the y axis,\n"
-                          "* right click the chart window.\n";
+    if ( !m_chartHelper.SetData(move(variableNames), move(series)) )
+    {
+        GetMenuBar()->Check(ID_WORKER_UPDATES, false);
+        return;
+    }
 
-    wxTextCtrl* helpCtrl = new wxTextCtrl(gridAndHelpPanel, wxID_ANY, helpText, wxDefaultPosition, wxDefaultSize, wxTE_MULTILINE | wxTE_READONLY);
-    helpCtrl->SetBackgroundColour(gridAndHelpPanel->GetBackgroundColour());
-    gridAndHelpPanelSizer->Add(helpCtrl, wxSizerFlags().Expand().Border());
+    m_gridTable->NotifyDataReplaced();
+    m_grid->EnableEditing(true);
+    m_chartHelper.RunChartUpdateSeries();
 
-    gridAndHelpPanel->SetSizer(gridAndHelpPanelSizer);
+    m_stopUpdateWorkers = false;
+    m_appliedUpdateCount = m_coalescedUpdateCount = 0;
+    for ( size_t s = 0; s < workerCount; ++s )
+        m_updateWorkers.emplace_back(&wxEChartsMainFrame::RunUpdateWorker, this, s, count);
+    GetMenuBar()->Check(ID_WORKER_UPDATES, true);
+}
 
-    CreateWebView(topSplitter, chartAssetsFolder);
+void wxEChartsMainFrame::RunUpdateWorker(const size_t seriesIdx, const size_t count)
+{
+    // much more often than the chart can be updated
+    static constexpr int postInterval = 2; // in milliseconds
 
-    wxTextCtrl* logCtrl = new wxTextCtrl(mainSplitter, wxID_ANY, wxEmptyString, wxDefaultPosition, wxDefaultSize, wxTE_MULTILINE | wxTE_READONLY | wxTE_RICH2);
-    wxLog::SetActiveTarget(new wxLogTextCtrl(logCtrl));
-    wxLog::DisableTimestamp();
+    mt19937 generator(static_cast<unsigned>(seriesIdx));
 
-    topSplitter->SetSashGravity(0);
-    topSplitter->SetMinimumPaneSize(FromDIP(20));
-    topSplitter->SplitVertically(gridAndHelpPanel, m_webView, gridAndHelpPanel->GetBestWidth(-1));
-    topSplitter->Bind(wxEVT_SPLITTER_DOUBLECLICKED, [topSplitter, gridAndHelpPanel](wxSplitterEvent&)
-        { topSplitter->SetSashPosition(gridAndHelpPanel->GetBestWidth(-1)); });
+    while ( !m_stopUpdateWorkers )
+    {
+        vector<double> data;
 
-    mainSplitter->SetSashGravity(1);
-    mainSplitter->SetMinimumPaneSize(FromDIP(100));
+        GenerateRandomWalk(generator, 0, count, data);
+        m_chartHelper.PostSeriesData(seriesIdx, move(data));
+        this_thread::sleep_for(chrono::milliseconds(postInterval));
+    }
+}
 
-    mainSplitter->SplitHorizontally(topSplitter, logCtrl, -FromDIP(60));
+void wxEChartsMainFrame::StopUpdateWorkers()
+{
+    if ( m_updateWorkers.empty() )
+        return;
 
-    wxLogMessage("Using chart assets folder '%s'.", chartAssetsFolder);
-    wxLogMessage("Using wxWebView backend '%s'.", wxWebView::GetBackendVersionInfo(m_webViewBackend).ToString());
+    m_stopUpdateWorkers = true;
+    for ( auto& worker : m_updateWorkers )
+        worker.join();
+    m_updateWorkers.clear();
+    m_chartHelper.DiscardPostedUpdates();
+
+    wxLogMessage(_("Stopped worker threads: %zu updates applied, %zu coalesced."),
+                 m_appliedUpdateCount, m_coalescedUpdateCount);
+    GetMenuBar()->Check(ID_WORKER_UPDATES, false);
 }
 
-void wxEChartsMainFrame::InitChartData()
+// all the updates posted since the last call are applied at once,
+// so that the chart and grid are updated only once
+void wxEChartsMainFrame::OnPostedUpdates()
 {
-    m_chartHelper.AddVariableNames({"Variable 1", "Variable 2", "Variable 3"});
+    const ChartHelper::AppliedUpdates result = m_chartHelper.ApplyPostedUpdates();
 
-    ChartHelper::ValueSeries s;
+    m_appliedUpdateCount += result.appliedCount;
+    m_coalescedUpdateCount += result.coalescedCount;
 
-    s.name = "Group A";
-    s.type = ChartHelper::Bar;
-    s.data = {10, 20, 30};
-    m_chartHelper.AddSeries(s);
+    if ( result.appendedCount > 0 )
+        m_gridTable->NotifyRowsAppended(result.appendedCount);
+    if ( result.liveValuesPushed )
+        m_gridTable->NotifyLiveValuesPushed();
+    if ( result.valuesChanged )
+        m_grid->ForceRefresh();
 
-    s.name = "Group B";
-    s.type = ChartHelper::Bar;
-    s.data = {15, 25, 35};
-    m_chartHelper.AddSeries(s);
+    if ( result.appliedCount > 0 && m_webViewConfigured )
+        m_chartHelper.RunChartUpdateSeries();
 }
 
-void wxEChartsMainFrame::CreateGrid(wxWindow* parent)
+// for demonstration of reading the data in another thread,
+// the statistics are computed from the published snapshot
+void wxEChartsMainFrame::OnSeriesStatistics(wxCommandEvent&)
 {
-    const auto variableNames = m_chartHelper.GetVariableNames();
-    const auto seriesNames = m_chartHelper.GetSeriesNames();
+    if ( m_statisticsRunning )
+    {
+        wxLogMessage(_("The statistics are still being computed."));
+        return;
+    }
 
-    m_grid = new wxGrid(parent, wxID_ANY);
-    m_grid->SetDefaultRenderer(new wxGridCellFloatRenderer(-1, 1));
-    m_grid->SetDefaultEditor(new wxGridCellFloatEditor(-1, 1));
-    m_grid->EnableDragRowSize(false);
-    m_grid->CreateGrid(variableNames.size(), seriesNames.size());
+    // the previous computation is done, joining it does not wait
+    if ( m_statisticsThread.joinable() )
+        m_statisticsThread.join();
 
-    for ( size_t row = 0; row < variableNames.size(); ++row )
-        m_grid->SetRowLabelValue(row, variableNames[row]);
+    shared_ptr<const ChartSnapshot> snapshot = m_chartHelper.PublishSnapshot();
 
-    for ( size_t col = 0; col < seriesNames.size(); ++col )
+    m_statisticsRunning = true;
+    m_statisticsThread = thread([this, snapshot]()
     {
-        vector<double> data;
+        // the values are scanned in blocks, checking for stopping between them
+        static constexpr size_t blockSize = 1024 * 1024;
 
-        m_grid->SetColLabelValue(col, seriesNames[col]);
-        if ( m_chartHelper.GetSeriesData(col, data) )
-        {
-            for ( size_t row = 0; row < variableNames.size(); ++row )
-                m_grid->SetCellValue(row, col, wxString::FromDouble(data[row]));
-        }
-    }
+        const wxStopWatch stopWatch;
+        wxString statistics;
 
-    m_grid->Bind(wxEVT_GRID_CELL_CHANGING, &wxEChartsMainFrame::OnGridCellChanging, this);
-    m_grid->Bind(wxEVT_GRID_CELL_CHANGED, &wxEChartsMainFrame::OnGridCellChanged, this);
-}
+        for ( size_t s = 0; s < snapshot->GetSeriesCount() && !m_stopStatistics; ++s )
+        {
+            const ChartSnapshot::Series& series = snapshot->GetSeries(s);
+            size_t count = 0;
+            double minValue = numeric_limits<double>::infinity();
+            double maxValue = -numeric_limits<double>::infinity();
+            double sum = 0;
 
-void wxEChartsMainFrame::CreateWebView(wxWindow* parent, const wxString& assetsFolder)
-{
-    const wxString url = wxString::Format("file://%s", wxFileName(assetsFolder, "wxecharts.html").GetFullPath());
+            series.values.ForEachChunk(0, series.values.GetSize(), [&](const double* values, const size_t valueCount)
+            {
+                for ( size_t first = 0; first < valueCount && !m_stopStatistics; first += blockSize )
+                {
+                    const size_t last = min(first + blockSize, valueCount);
+
+                    for ( size_t i = first; i < last; ++i )
+                    {
+                        if ( std::isnan(values[i]) )
+                            continue;
+                        minValue = min(minValue, values[i]);
+                        maxValue = max(maxValue, values[i]);
+                        sum += values[i];
+                        ++count;
+                    }
+                }
+            });
 
-    m_webViewBackend = wxWebViewBackendDefault;
-#if USING_WEBVIEW_EDGE
-    m_webViewBackend = wxWebViewBackendEdge;
-#endif
+            statistics += wxString::Format("\n'%s': %zu values", series.name, count);
+            if ( count > 0 )
+                statistics += wxString::Format(", min %g, max %g, mean %g", minValue, maxValue, sum / count);
+        }
 
-    m_webView = wxWebView::New(parent, wxID_ANY, url, wxDefaultPosition, wxDefaultSize, m_webViewBackend);
-    m_webView->EnableContextMenu(false);
-    m_webView->EnableHistory(false);
+        // the frame is being destroyed
+        if ( m_stopStatistics )
+            return;
 
-    m_webView->Bind(wxEVT_WEBVIEW_SCRIPT_RESULT, &wxEChartsMainFrame::OnWebViewScriptResult, this);
-    if ( m_webView->AddScriptMessageHandler("wxmsg") )
-        m_webView->Bind(wxEVT_WEBVIEW_SCRIPT_MESSAGE_RECEIVED, &wxEChartsMainFrame::OnWebViewMessageReceived, this);
-    else
-        wxLogError(_("Could not install the webview message handler, the application will be unusable."));
+        statistics.Prepend(wxString::Format(_("Statistics of data version %llu computed in %ld ms:"),
+                                            static_cast<unsigned long long>(snapshot->GetVersion()),
+                                            stopWatch.Time()));
+        // called from a worker thread, CallAfter() is thread-safe
+        CallAfter(&wxEChartsMainFrame::OnSeriesStatisticsDone, statistics);
+        m_statisticsRunning = false;
+    });
+}
 
-#if wxCHECK_VERSION(3, 3, 0)
-    m_webView->Bind(wxEVT_WEBVIEW_CREATED, [this](wxWebViewEvent&){ ConfigureWebView(); });
-#endif // #if wxCHECK_VERSION(3, 3, 0)
-    m_webView->Bind(wxEVT_WEBVIEW_LOADED, &wxEChartsMainFrame::OnWebViewPageLoaded, this);
-    m_webView->Bind(wxEVT_WEBVIEW_ERROR, &wxEChartsMainFrame::OnWebViewError, this);
+void wxEChartsMainFrame::OnSeriesStatisticsDone(const wxString& statistics)
+{
+    wxLogMessage("%s", statistics);
 }
 
-void wxEChartsMainFrame::ConfigureWebView()
+void wxEChartsMainFrame::OnBenchmarkJSONSerializers(wxCommandEvent&)
 {
-    if ( m_webViewConfigured )
-        return;
+    RunBenchmark(&Benchmarks::RunJSONSerializers);
+}
 
-    void* nativeBackend = m_webView->GetNativeBackend();
+void wxEChartsMainFrame::OnBenchmarkDataFile(wxCommandEvent&)
+{
+    RunBenchmark(&Benchmarks::RunDataFile);
+}
 
-    if ( !nativeBackend )
-        return;
+void wxEChartsMainFrame::OnBenchmarkTaskPool(wxCommandEvent&)
+{
+    RunBenchmark(&Benchmarks::RunTaskPool);
+}
 
-    m_webViewConfigured = true;
+void wxEChartsMainFrame::OnBenchmarkWebViewStartup(wxCommandEvent&)
+{
+    const wxString profileName = WebKitProfile::GetName(WebKitProfile::Get());
+    const long pageLoadedTime = m_webViewPageLoadedTime;
+    const long chartRenderedTime = m_chartFirstRenderedTime;
 
-#if USING_WEBVIEW_EDGE
-    ICoreWebView2* webView2 = static_cast<ICoreWebView2*>(nativeBackend);
-    HRESULT hr;
-    wxCOMPtr<ICoreWebView2Settings> settings;
+    RunBenchmark([profileName, pageLoadedTime, chartRenderedTime]()
+    {
+        return Benchmarks::RunWebViewStartup(profileName, pageLoadedTime, chartRenderedTime);
+    });
+}
 
-    hr = webView2->get_Settings(&settings);
-    if ( FAILED(hr) )
+void wxEChartsMainFrame::OnBenchmarkChartWindows(wxCommandEvent&)
+{
+    if ( m_chartWindowsBenchmark )
     {
-        wxLogError(_("Could not obtain WebView2Settings (error code 0x%08lx)."), (long)hr);
+        wxLogError(_("The chart windows benchmark is already running."));
         return;
     }
-    settings->put_IsBuiltInErrorPageEnabled(FALSE);
-    settings->put_IsZoomControlEnabled(FALSE);
 
-    wxCOMPtr<ICoreWebView2Settings3> settings3;
+    const size_t baseFootprint = Benchmarks::GetMemoryFootprint();
 
-    hr = settings->QueryInterface(wxIID_PPV_ARGS(ICoreWebView2Settings3, &settings3));
-    if ( FAILED(hr) )
+    if ( baseFootprint == 0 )
     {
-        wxLogError(_("Could not obtain WebView2Settings3 (error code 0x%08lx)."), (long)hr);
+        wxLogError(_("Memory footprint is not available on this platform."));
         return;
     }
-    settings3->put_AreBrowserAcceleratorKeysEnabled(FALSE);
-#endif // #if USING_WEBVIEW_EDGE
+
+    m_chartWindowsBenchmark.reset(new ChartWindowsBenchmark);
+    m_chartWindowsBenchmark->windowCounts = {1, 10, 50};
+    m_chartWindowsBenchmark->baseFootprint = baseFootprint;
+    m_chartWindowsBenchmark->report.Printf(_("Memory footprint of chart windows with WebKit profile '%s', %.1f MB without them:"),
+                                           WebKitProfile::GetName(WebKitProfile::Get()), baseFootprint / (1024.0 * 1024.0));
+
+    wxLogMessage(_("Running the chart windows benchmark, please do not close the chart windows..."));
+    // the first step is started after the settle time
+    m_chartWindowsBenchmark->stopWatch.Start();
+    m_chartWindowsBenchmarkTimer.Start(ChartWindowsBenchmarkInterval);
 }
 
-void wxEChartsMainFrame::OnGridCellChanging(wxGridEvent& e)
+void wxEChartsMainFrame::StartChartWindowsBenchmarkStep()
 {
-    static constexpr double minAllowedValue = -100;
-    static constexpr double maxAllowedValue = 100;
+    ChartWindowsBenchmark& benchmark = *m_chartWindowsBenchmark;
+    const size_t windowCount = benchmark.windowCounts.front();
+    const wxSize windowSize = FromDIP(wxSize(320, 240));
 
-    double d;
+    benchmark.shownCount = 0;
+    benchmark.allShownTime = -1;
+    benchmark.stopWatch.Start();
 
-    if ( !e.GetString().ToDouble(&d)
-          || d < minAllowedValue || d > maxAllowedValue )
+    for ( size_t i = 0; i < windowCount; ++i )
     {
-        e.Veto();
-        wxLogError(_("Invalid series value '%s' (col %d, row %d)."), e.GetString(), e.GetCol(), e.GetRow());
+        ChartWindow* window = new ChartWindow(this, wxString::Format(_("Chart %zu of %zu"), i + 1, windowCount),
+                                              m_chartAssetsFolder, m_webViewBackend,
+                                              [this](bool) { OnChartWindowsBenchmarkWindowShown(); });
+
+        InitChartData(window->GetChartHelper());
+        window->SetSize(wxRect(FromDIP(wxPoint(40 + 20 * (i % 25), 40 + 20 * (i % 25))), windowSize));
+        window->Show();
+        benchmark.windows.push_back(window);
     }
 }
 
-void wxEChartsMainFrame::OnGridCellChanged(wxGridEvent& e)
+void wxEChartsMainFrame::OnChartWindowsBenchmarkWindowShown()
 {
-    const int row = e.GetRow();
-    const int col = e.GetCol();
-    const wxString sVal = m_grid->GetCellValue(row, col);
+    if ( !m_chartWindowsBenchmark )
+        return;
+
+    ChartWindowsBenchmark& benchmark = *m_chartWindowsBenchmark;
+
+    benchmark.shownCount++;
+    if ( benchmark.shownCount == benchmark.windowCounts.front() )
+        benchmark.allShownTime = benchmark.stopWatch.Time();
+}
 
-    vector<double> data;
+void wxEChartsMainFrame::OnChartWindowsBenchmarkTimer(wxTimerEvent&)
+{
+    ChartWindowsBenchmark& benchmark = *m_chartWindowsBenchmark;
+    const long time = benchmark.stopWatch.Time();
 
-    if ( m_chartHelper.GetSeriesData(col, data) )
+    if ( benchmark.windows.empty() )
     {
-        sVal.ToDouble(&data[row]);
-        m_chartHelper.SetSeriesData(col, data);
-        m_chartHelper.RunChartUpdateSeries();
+        if ( time >= ChartWindowsBenchmarkSettleTime )
+            StartChartWindowsBenchmarkStep();
+        return;
+    }
+
+    if ( benchmark.allShownTime < 0 && time < ChartWindowsBenchmarkTimeout )
+        return;
+    if ( benchmark.allShownTime >= 0 && time - benchmark.allShownTime < ChartWindowsBenchmarkSettleTime )
+        return;
+
+    const size_t windowCount = benchmark.windowCounts.front();
+    const double megabyte = 1024.0 * 1024.0;
+    const double footprint = Benchmarks::GetMemoryFootprint() / megabyte;
+    const double chartsFootprint = footprint - benchmark.baseFootprint / megabyte;
+
+    benchmark.report += wxString::Format(_("\n%zu chart windows: %.1f MB, %.1f MB per chart"),
+                                         windowCount, footprint, chartsFootprint / windowCount);
+    if ( benchmark.shownCount < windowCount )
+        benchmark.report += wxString::Format(_(" (only %zu charts were rendered)"), benchmark.shownCount);
+
+    for ( auto& window : benchmark.windows )
+    {
+        if ( window )
+            window->Destroy();
+    }
+    benchmark.windows.clear();
+    benchmark.windowCounts.erase(benchmark.windowCounts.begin());
+    benchmark.stopWatch.Start();
+
+    if ( benchmark.windowCounts.empty() )
+    {
+        m_chartWindowsBenchmarkTimer.Stop();
+        wxLogMessage("%s", benchmark.report);
+        m_chartWindowsBenchmark.reset();
     }
 }
 
-void wxEChartsMainFrame::OnChartColors(wxCommandEvent&)
+void wxEChartsMainFrame::OnSentUpdateStatistics(wxCommandEvent&)
 {
-    m_chartHelper.RunChartGetColors();
-}
+    const ChartHelper::SentUpdateStats stats = m_chartHelper.GetSentUpdateStats();
 
+    const double megabyte = 1024.0 * 1024.0;
 
-void wxEChartsMainFrame::OnChartSizingOptions(wxCommandEvent&)
+    wxLogMessage(_("Chart updates sent: %zu (%.2f MB), skipped as the same as sent before: %zu, not sent in all: %.2f MB."),
+                 stats.sentCount, stats.sentBytes / megabyte, stats.skippedCount, stats.savedBytes / megabyte);
+    wxLogMessage(_("Chart updates suspended while the chart was hidden: %zu."), stats.suspendedCount);
+}
+
+void wxEChartsMainFrame::RunBenchmark(const std::function<wxString()>& benchmark)
 {
-    m_chartHelper.RunChartGetSizingOptions();
+    if ( m_benchmarkThread.joinable() )
+        m_benchmarkThread.join();
+
+    m_benchmarkThread = thread([this, benchmark]()
+    {
+        const wxString report = benchmark();
+
+        // called from a worker thread, CallAfter() is thread-safe
+        CallAfter(&wxEChartsMainFrame::OnBenchmarkDone, report);
+    });
 }
 
-void wxEChartsMainFrame::OnChartSave(wxCommandEvent&)
+void wxEChartsMainFrame::OnBenchmarkDone(const wxString& report)
 {
-    const int chartWidth = wxGetNumberFromUser(_("Enter chart width (height is computed with the width/height ratio"),
-                             _("Width"), _("Save chart"),
-                             1000, 400, 4000, this);
+    wxLogMessage("%s", report);
+}
 
-    if ( chartWidth != -1 )
-        m_chartHelper.RunChartGetPNG(chartWidth);;
+void wxEChartsMainFrame::OnChartUpdateReady()
+{
+    m_chartHelper.RunReadyChartUpdate();
 }
 
 void wxEChartsMainFrame::OnShowDevTools(wxCommandEvent&)
@@ -328,6 +1523,9 @@ void wxEChartsMainFrame::OnShowDevTools(wxCommandEvent&)
 
 void wxEChartsMainFrame::OnWebViewPageLoaded(wxWebViewEvent&)
 {
+    if ( m_webViewPageLoadedTime < 0 )
+        m_webViewPageLoadedTime = m_webViewStopWatch.Time();
+
     ConfigureWebView();
 
     m_chartHelper.SetWebView(m_webView);
@@ -336,6 +1534,14 @@ void wxEChartsMainFrame::OnWebViewPageLoaded(wxWebViewEvent&)
     m_chartHelper.RunChartCreate();
     m_chartHelper.RunChartUpdateVariableNames();
     m_chartHelper.RunChartUpdateSeries();
+
+    // the chart cannot be updated before it is created
+    if ( m_stdinReader && !m_stdinReaderTimer.IsRunning() )
+        m_stdinReaderTimer.Start(StdinReaderInterval);
+    if ( m_metricsListener && !m_metricsTimer.IsRunning() )
+        m_metricsTimer.Start(MetricsInterval);
+    if ( m_chartHelper.GetSharedRingBuffer() && !m_sharedRingBufferTimer.IsRunning() )
+        m_sharedRingBufferTimer.Start(SharedRingBufferInterval);
 }
 
 void wxEChartsMainFrame::OnWebViewError(wxWebViewEvent&)
@@ -367,29 +1573,36 @@ void wxEChartsMainFrame::OnWebViewScriptResult(wxWebViewEvent& evt)
                 failedScript = _("update the chart data");
             break;
 
-        case ChartHelper::GetColors:
+        case ChartHelper::SetColors:
             if ( isError )
-                failedScript = _("obtain the chart colors");
-            else
-                CallAfter(&wxEChartsMainFrame::ChartChangeColors, evt.GetString());
+                failedScript = _("change the chart colors");
             break;
 
-        case ChartHelper::SetColors:
+        case ChartHelper::SetSizingOptions:
             if ( isError )
-                failedScript = _("change the chart colors");
+                failedScript = _("change chart sizing options");
             break;
 
-        case ChartHelper::GetSizingOptions:
+        case ChartHelper::SetRenderingOptions:
             if ( isError )
-                failedScript = _("obtain the chart sizing options");
+                failedScript = _("change chart rendering options");
+            break;
+
+        case ChartHelper::SetResizeSettleMode:
+            if ( isError )
+                failedScript = _("change chart resize mode");
+            break;
+
+        case ChartHelper::GetOptions:
+            if ( isError )
+                failedScript = _("obtain the chart options");
             else
-               //ChartChangeSizingOptions(evt.GetString());
-                CallAfter(&wxEChartsMainFrame::ChartChangeSizingOptions, evt.GetString());
+                m_chartHelper.SyncChartOptions(evt.GetString());
             break;
 
-        case ChartHelper::SetSizingOptions:
+        case ChartHelper::SetOptions:
             if ( isError )
-                failedScript = _("change chart sizing options");
+                failedScript = _("change the chart options");
             break;
 
         case ChartHelper::GetPNG:
@@ -446,6 +1659,14 @@ void wxEChartsMainFrame::OnWebViewMessageReceived(wxWebViewEvent& evt)
         {
             OnMessageChartContextMenu();
         }
+        else if ( msgType == "datazoom" )
+        {
+            OnMessageChartDataZoom(msgFields, msg);
+        }
+        else if ( msgType == "rendered" )
+        {
+            OnMessageChartRendered(msgFields, msg);
+        }
         else
         {
             wxLogMessage(_("Unknown wxECharts message type '%s' ('%s')."), msgType, msg);
@@ -453,36 +1674,6 @@ void wxEChartsMainFrame::OnWebViewMessageReceived(wxWebViewEvent& evt)
     }
 }
 
-void wxEChartsMainFrame::ChartChangeColors(const wxString& colorsJSONStr)
-{
-    vector<wxColour> colors;
-
-    if ( !ChartHelper::JSONToColors(colorsJSONStr, colors) )
-        return;
-
-    ChartColorsDlg dlg(this, colors);
-
-    if ( dlg.ShowModal() == wxID_OK )
-        m_chartHelper.RunChartSetColors(dlg.GetColors());
-}
-
-void wxEChartsMainFrame::ChartChangeSizingOptions(const wxString& sizingOptionsJSONStr)
-{
-    double widthToHeightRatio;
-    int minWidth, minHeight;
-
-    if ( !ChartHelper::JSONToSizingOptions(sizingOptionsJSONStr, widthToHeightRatio, minWidth, minHeight) )
-        return;
-
-    ChartSizingOptionsDlg dlg(this, widthToHeightRatio, minWidth, minHeight);
-
-    if ( dlg.ShowModal() == wxID_OK )
-    {
-        dlg.GetSizingOptions(widthToHeightRatio, minWidth, minHeight);
-        m_chartHelper.RunChartSetSizingOptions(widthToHeightRatio, minWidth, minHeight);
-    }
-}
-
 void wxEChartsMainFrame::ChartSavePNG(const wxString& PNGAsBase64Str)
 {
     wxString base64Str;
@@ -553,7 +1744,9 @@ void wxEChartsMainFrame::OnMessageChartDoubleClick(const wxArrayString& params,
         }
         else if ( params[0] == "series" )
         {
-            const size_t variableIdx = j.at("dataIndex").get<size_t>();
+            // with a value or time x axis, the data index is not the variable index
+            const size_t variableIdx = j.contains("x") ? m_chartHelper.GetNearestVariableIdx(j.at("x").get<double>())
+                                                       : j.at("dataIndex").get<size_t>();
             const size_t seriesIdx = j.at("seriesIndex").get<size_t>();
             const wxString value = wxString::Format("%g", j.at("value").get<double>());
             const wxColor color = wxColor(wxString::FromUTF8(j.at("color").get<string>()));
@@ -574,13 +1767,11 @@ void wxEChartsMainFrame::OnMessageChartDoubleClick(const wxArrayString& params,
                 if (dlg.ShowModal() != wxID_OK )
                     return;
 
-                if ( m_chartHelper.SetVariableName(variableIdx, variableName) )
-                {
+                if ( m_chartHelper.HasVariableNames() && !m_chartHelper.HasDataFile()
+                     && m_chartHelper.SetVariableName(variableIdx, variableName) )
                     m_chartHelper.RunChartUpdateVariableNames();
-                    m_grid->SetRowLabelValue(variableIdx, variableName);
-                }
-                if ( m_chartHelper.SetSeriesName(seriesIdx, seriesName) )
-                    m_grid->SetColLabelValue(seriesIdx, seriesName);
+                m_chartHelper.SetSeriesName(seriesIdx, seriesName);
+                m_grid->Refresh();
                  m_chartHelper.SetSeriesType(seriesIdx, static_cast<ChartHelper::SeriesType>(seriesTypeInt));
                  m_chartHelper.RunChartUpdateSeries();
             }
@@ -599,4 +1790,56 @@ void wxEChartsMainFrame::OnMessageChartDoubleClick(const wxArrayString& params,
 void wxEChartsMainFrame::OnMessageChartContextMenu()
 {
     wxLogMessage(_("wxECharts 'contextmenu' message received."));
+}
+
+void wxEChartsMainFrame::OnMessageChartDataZoom(const wxArrayString& params, const wxString& msg)
+{
+    constexpr size_t validMinParamsCount = 2;
+
+    if ( params.size() < validMinParamsCount )
+    {
+        wxLogError(_("Malformed wxECharts datazoom message: '%s'"), msg);
+        return;
+    }
+
+    if ( !m_chartHelper.IsLODActive() )
+        return;
+
+    try
+    {
+        const json j = json::parse(string(params[1].utf8_string()));
+
+        m_chartHelper.RunChartUpdateVisibleRange(j.at("startValue").get<double>(),
+                                                 j.at("endValue").get<double>(),
+                                                 j.at("width").get<int>());
+    }
+    catch (const json::exception& e)
+    {
+        wxLogError(_("JSON parsing error in %s (%s)."), __FUNCTION__, e.what());
+    }
+}
+
+void wxEChartsMainFrame::OnMessageChartRendered(const wxArrayString& params, const wxString& msg)
+{
+    constexpr size_t validMinParamsCount = 2;
+
+    if ( params.size() < validMinParamsCount )
+    {
+        wxLogError(_("Malformed wxECharts rendered message: '%s'"), msg);
+        return;
+    }
+
+    try
+    {
+        const json j = json::parse(string(params[1].utf8_string()));
+
+        m_chartHelper.OnChartRendered(j.at("time").get<double>(),
+                                      j.at("devicePixelRatio").get<double>());
+        if ( m_chartFirstRenderedTime < 0 )
+            m_chartFirstRenderedTime = m_webViewStopWatch.Time();
+    }
+    catch (const json::exception& e)
+    {
+        wxLogError(_("JSON parsing error in %s (%s)."), __FUNCTION__, e.what());
+    }
 }
\ No newline at end of file
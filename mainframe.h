@@ -12,11 +12,19 @@
 #pragma once
 
 #include <wx/frame.h>
+#include <wx/stopwatch.h>
+#include <wx/timer.h>
+#include <wx/weakref.h>
+
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <vector>
 
 #include "charthelper.h"
 
-#if !wxUSE_WEBVIEW
-  #error "wxWidgets must be built with a support for wxWebView"
+#if !wxUSE_WEBVIEW
+  #error "wxWidgets must be built with a support for wxWebView"
 #endif
 
 #ifdef __WXMSW__
@@ -30,6 +38,13 @@
 
 class wxArrayString;
 class wxGrid;
+class wxProgressDialog;
+class ChartGridTable;
+class ChartWindow;
+class CSVImporter;
+class LineProtocolReader;
+class MetricsListener;
+class MetricsTestGenerator;
 class wxGridEvent;
 class wxWebView;
 class wxWebViewEvent;
@@ -38,32 +53,182 @@ class wxEChartsMainFrame : public wxFrame
 {
 public:
     wxEChartsMainFrame(wxWindow* parent, const wxString& chartAssetsFolder);
+    ~wxEChartsMainFrame();
+
+    // reads the values of live series from the standard input,
+    // each series keeps up to capacity values
+    void StartStdinIngest(const size_t capacity);
+    // receives StatsD metrics on the local port, see MetricsListener
+    bool StartMetricsListener(const uint16_t port, const size_t capacity);
+    // reads the values of live series from the ring buffer in the named
+    // shared memory, see SharedRingBuffer; capacity 0 means the capacity
+    // of the shared ring buffer
+    bool AttachSharedRingBuffer(const wxString& name, const size_t capacity);
 private:
     enum
     {
         ID_CHART_COLORS = wxID_HIGHEST + 10,
         ID_CHART_SIZING_OPTIONS,
+        ID_CHART_RENDERING_OPTIONS,
+        ID_RESIZE_SETTLE_MODE,
+        ID_SERIES_PRECISION,
+        ID_SAVE_CHART_PREVIEW,
+        ID_APPEND_GENERATED_DATA,
+        ID_NEW_TIME_SERIES,
+        ID_OPEN_DATA_FILE,
+        ID_SAVE_DATA_FILE,
+        ID_IMPORT_CSV,
+        ID_LIVE_DATA,
+        ID_METRICS_LISTENER,
+        ID_SHARED_RING_BUFFER,
+        ID_WORKER_UPDATES,
+        ID_SERIES_STATISTICS,
+        ID_BENCHMARK_JSON_SERIALIZERS,
+        ID_BENCHMARK_DATA_FILE,
+        ID_BENCHMARK_TASK_POOL,
+        ID_BENCHMARK_WEBVIEW_STARTUP,
+        ID_BENCHMARK_CHART_WINDOWS,
+        ID_SENT_UPDATE_STATISTICS,
         ID_SHOW_DEVTOOLS,
     };
 
     ChartHelper m_chartHelper;
     wxGrid* m_grid{nullptr};
+    ChartGridTable* m_gridTable{nullptr};
+    wxString m_chartAssetsFolder;
     wxWebView* m_webView{nullptr};
     bool m_webViewConfigured{false};
     wxString m_webViewBackend;
+    // the startup times of the webview, negative until reached
+    wxStopWatch m_webViewStopWatch;
+    long m_webViewPageLoadedTime{-1};
+    long m_chartFirstRenderedTime{-1};
+    wxTimer m_liveDataTimer;
+
+    std::unique_ptr<CSVImporter> m_CSVImporter;
+    std::unique_ptr<wxProgressDialog> m_CSVImportProgressDlg;
+    wxTimer m_CSVImportProgressTimer;
+
+    // in milliseconds, about one frame at 60 Hz
+    static constexpr int StdinReaderInterval = 16;
+
+    std::unique_ptr<LineProtocolReader> m_stdinReader;
+    wxTimer m_stdinReaderTimer;
+    size_t m_stdinCapacity{0};
+    size_t m_stdinIgnoredPointCount{0};
+
+    // the aggregation interval of the metrics, in milliseconds
+    static constexpr int MetricsInterval = 1000;
+
+    std::unique_ptr<MetricsListener> m_metricsListener;
+    std::unique_ptr<MetricsTestGenerator> m_metricsGenerator;
+    wxTimer m_metricsTimer;
+    size_t m_metricsCapacity{0};
+
+    // in milliseconds, about one frame at 60 Hz
+    static constexpr int SharedRingBufferInterval = 16;
+
+    wxTimer m_sharedRingBufferTimer;
 
-    void InitChartData();
+    // for demonstration of the updates posted from worker threads
+    std::vector<std::thread> m_updateWorkers;
+    std::atomic<bool> m_stopUpdateWorkers{false};
+    size_t m_appliedUpdateCount{0};
+    size_t m_coalescedUpdateCount{0};
+
+    // computes the statistics from a data snapshot, which can take
+    // minutes with a large data file, so it is never waited for
+    // in the GUI thread unless it is stopped
+    std::thread m_statisticsThread;
+    std::atomic<bool> m_statisticsRunning{false};
+    std::atomic<bool> m_stopStatistics{false};
+    // runs the benchmarks, one at a time
+    std::thread m_benchmarkThread;
+
+    // in milliseconds
+    static constexpr int ChartWindowsBenchmarkInterval = 250;
+    // for the web processes to start or exit
+    static constexpr long ChartWindowsBenchmarkSettleTime = 2000;
+    // for the charts in the windows to be rendered
+    static constexpr long ChartWindowsBenchmarkTimeout = 60000;
+
+    // the state of the benchmark with multiple chart windows
+    struct ChartWindowsBenchmark
+    {
+        // the numbers of windows still to measure, the first one is being measured
+        std::vector<size_t> windowCounts;
+        // empty while waiting for the windows of the previous step to close
+        std::vector<wxWeakRef<ChartWindow>> windows;
+        size_t shownCount{0};
+        // since the windows were created or closed
+        wxStopWatch stopWatch;
+        long allShownTime{-1};
+        size_t baseFootprint{0};
+        wxString report;
+    };
+
+    std::unique_ptr<ChartWindowsBenchmark> m_chartWindowsBenchmark;
+    wxTimer m_chartWindowsBenchmarkTimer;
+
+    static void InitChartData(ChartHelper& chartHelper);
 
     void CreateGrid(wxWindow* parent);
     void CreateWebView(wxWindow* parent, const wxString& assetsFolder);
     void ConfigureWebView();
 
+    void OnIconize(wxIconizeEvent& e);
+
     void OnGridCellChanging(wxGridEvent& e);
     void OnGridCellChanged(wxGridEvent& e);
 
     void OnChartColors(wxCommandEvent&);
     void OnChartSizingOptions(wxCommandEvent&);
+    void OnChartRenderingOptions(wxCommandEvent&);
+    void OnResizeSettleMode(wxCommandEvent& e);
+    void OnSeriesPrecision(wxCommandEvent&);
     void OnChartSave(wxCommandEvent&);
+    void OnSaveChartPreview(wxCommandEvent&);
+    void OnAppendGeneratedData(wxCommandEvent&);
+    void OnNewTimeSeries(wxCommandEvent&);
+    void OnOpenDataFile(wxCommandEvent&);
+    void OnDataFileLODReady();
+    void OnSaveDataFile(wxCommandEvent&);
+    void OnImportCSV(wxCommandEvent&);
+    void OnCSVImportProgressTimer(wxTimerEvent&);
+    void OnCSVImportDone();
+    void OnLiveData(wxCommandEvent& e);
+    void OnLiveDataTimer(wxTimerEvent&);
+    void StopLiveData();
+    void OnStdinReaderTimer(wxTimerEvent&);
+    void StopStdinIngest();
+    void OnMetricsListener(wxCommandEvent& e);
+    void OnMetricsTimer(wxTimerEvent&);
+    void StopMetricsListener();
+    void OnSharedRingBuffer(wxCommandEvent& e);
+    void OnSharedRingBufferTimer(wxTimerEvent&);
+    void DetachSharedRingBuffer();
+    void OnWorkerUpdates(wxCommandEvent& e);
+    // runs in a worker thread
+    void RunUpdateWorker(const size_t seriesIdx, const size_t count);
+    void StopUpdateWorkers();
+    void OnPostedUpdates();
+    void OnSeriesStatistics(wxCommandEvent&);
+    void OnSeriesStatisticsDone(const wxString& statistics);
+    void OnBenchmarkJSONSerializers(wxCommandEvent&);
+    void OnBenchmarkDataFile(wxCommandEvent&);
+    void OnBenchmarkTaskPool(wxCommandEvent&);
+    void OnBenchmarkWebViewStartup(wxCommandEvent&);
+    void OnBenchmarkChartWindows(wxCommandEvent&);
+    void StartChartWindowsBenchmarkStep();
+    void OnChartWindowsBenchmarkWindowShown();
+    void OnChartWindowsBenchmarkTimer(wxTimerEvent&);
+    void OnSentUpdateStatistics(wxCommandEvent&);
+    // runs the benchmark in a worker thread and logs its report
+    void RunBenchmark(const std::function<wxString()>& benchmark);
+    void OnBenchmarkDone(const wxString& report);
+    void OnChartUpdateReady();
+    // starts the live mode with the series or adds them to it
+    bool AddLiveSeries(const std::vector<wxString>& names, const size_t capacity);
     void OnShowDevTools(wxCommandEvent&);
 
     void OnWebViewPageLoaded(wxWebViewEvent&);
@@ -71,12 +236,12 @@ private:
     void OnWebViewScriptResult(wxWebViewEvent&);
     void OnWebViewMessageReceived(wxWebViewEvent& evt);
 
-    void ChartChangeColors(const wxString& colorsJSONStr);
-    void ChartChangeSizingOptions(const wxString& sizingOptionsJSONStr);
     void ChartSavePNG(const wxString& PNGAsBase64Str);
     void ChartShowVersion(const wxString& version);
 
     void OnMessageChartError(const wxArrayString& params, const wxString& msg);
     void OnMessageChartDoubleClick(const wxArrayString& params, const wxString& msg);
     void OnMessageChartContextMenu();
+    void OnMessageChartDataZoom(const wxArrayString& params, const wxString& msg);
+    void OnMessageChartRendered(const wxArrayString& params, const wxString& msg);
 };
\ No newline at end of file
@@ -0,0 +1,223 @@
+///////////////////////////////////////////////////////////////////////////////
+// Project:     wxECharts
+// Home:        https://github.com/PBfordev/wxecharts
+// File Name:   mappedfile.cpp
+// Purpose:     Implementation of read-only memory-mapped file
+// Author:      PB
+// Created:     2026-10-18
+// Copyright:   (c) 2026 PB
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#include <wx/wx.h>
+
+#ifdef __WXMSW__
+    #include <wx/msw/wrapwin.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#include "mappedfile.h"
+
+#ifdef __WXMSW__
+
+MappedFile::MappedFile()
+    : m_file(INVALID_HANDLE_VALUE), m_mapping(nullptr)
+{}
+
+bool MappedFile::Open(const wxString& fileName)
+{
+    Close();
+
+    HANDLE file = ::CreateFileW(fileName.wc_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+    if ( file == INVALID_HANDLE_VALUE )
+    {
+        wxLogSysError(_("Could not open file '%s'"), fileName);
+        return false;
+    }
+
+    LARGE_INTEGER size;
+
+    if ( !::GetFileSizeEx(file, &size) )
+    {
+        wxLogSysError(_("Could not obtain size of file '%s'"), fileName);
+        ::CloseHandle(file);
+        return false;
+    }
+
+    m_file = file;
+    m_size = static_cast<size_t>(size.QuadPart);
+    m_opened = true;
+
+    // an empty file cannot be mapped
+    if ( m_size == 0 )
+        return true;
+
+    m_mapping = ::CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if ( !m_mapping )
+    {
+        wxLogSysError(_("Could not create mapping of file '%s'"), fileName);
+        Close();
+        return false;
+    }
+
+    m_data = static_cast<const char*>(::MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+    if ( !m_data )
+    {
+        wxLogSysError(_("Could not map file '%s'"), fileName);
+        Close();
+        return false;
+    }
+
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if ( m_data )
+        ::UnmapViewOfFile(m_data);
+    if ( m_mapping )
+        ::CloseHandle(m_mapping);
+    if ( m_file != INVALID_HANDLE_VALUE )
+        ::CloseHandle(m_file);
+
+    m_file = INVALID_HANDLE_VALUE;
+    m_mapping = nullptr;
+    m_data = nullptr;
+    m_size = 0;
+    m_opened = false;
+}
+
+void MappedFile::Advise(const AccessPattern WXUNUSED(pattern))
+{
+    // Windows has no equivalent of madvise() for mapped files
+}
+
+void MappedFile::DiscardPages(const size_t offset, const size_t size)
+{
+    wxCHECK_RET(offset + size <= m_size, "Invalid range");
+
+    if ( !m_data || size == 0 )
+        return;
+
+    // unlocking pages which are not locked removes them from the working set
+    ::VirtualUnlock(const_cast<char*>(m_data) + offset, size);
+}
+
+#else // #ifdef __WXMSW__
+
+MappedFile::MappedFile()
+{}
+
+bool MappedFile::Open(const wxString& fileName)
+{
+    Close();
+
+    const int fd = open(fileName.fn_str(), O_RDONLY);
+
+    if ( fd == -1 )
+    {
+        wxLogSysError(_("Could not open file '%s'"), fileName);
+        return false;
+    }
+
+    struct stat st;
+
+    if ( fstat(fd, &st) != 0 )
+    {
+        wxLogSysError(_("Could not obtain size of file '%s'"), fileName);
+        close(fd);
+        return false;
+    }
+
+    m_fd = fd;
+    m_size = static_cast<size_t>(st.st_size);
+    m_opened = true;
+
+    // an empty file cannot be mapped
+    if ( m_size == 0 )
+        return true;
+
+    void* data = mmap(nullptr, m_size, PROT_READ, MAP_SHARED, fd, 0);
+
+    if ( data == MAP_FAILED )
+    {
+        wxLogSysError(_("Could not map file '%s'"), fileName);
+        Close();
+        return false;
+    }
+
+    m_data = static_cast<const char*>(data);
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if ( m_data )
+        munmap(const_cast<char*>(m_data), m_size);
+    if ( m_fd != -1 )
+        close(m_fd);
+
+    m_fd = -1;
+    m_data = nullptr;
+    m_size = 0;
+    m_opened = false;
+}
+
+void MappedFile::Advise(const AccessPattern pattern)
+{
+    if ( !m_data )
+        return;
+
+    int advice = MADV_NORMAL;
+
+    if ( pattern == Sequential )
+        advice = MADV_SEQUENTIAL;
+    else if ( pattern == Random )
+        advice = MADV_RANDOM;
+
+    madvise(const_cast<char*>(m_data), m_size, advice);
+}
+
+void MappedFile::DiscardPages(const size_t offset, const size_t size)
+{
+    wxCHECK_RET(offset + size <= m_size, "Invalid range");
+
+    if ( !m_data || size == 0 )
+        return;
+
+    // madvise() requires a page-aligned address
+    static const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    const size_t alignedOffset = offset / pageSize * pageSize;
+
+    // the mapping is read-only and shared, so the pages are just dropped
+    // and will be read from the file again when accessed
+    madvise(const_cast<char*>(m_data) + alignedOffset, size + offset - alignedOffset, MADV_DONTNEED);
+}
+
+#endif // #else // #ifdef __WXMSW__
+
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+bool MappedFile::IsOpened() const
+{
+    return m_opened;
+}
+
+const char* MappedFile::GetData() const
+{
+    return m_data;
+}
+
+size_t MappedFile::GetSize() const
+{
+    return m_size;
+}
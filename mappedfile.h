@@ -0,0 +1,65 @@
+///////////////////////////////////////////////////////////////////////////////
+// Project:     wxECharts
+// Home:        https://github.com/PBfordev/wxecharts
+// File Name:   mappedfile.h
+// Purpose:     Declaration of read-only memory-mapped file
+// Author:      PB
+// Created:     2026-10-18
+// Copyright:   (c) 2026 PB
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+
+#include <wx/string.h>
+
+/*****************************************************************
+
+MappedFile
+---------------
+read-only memory-mapped file, its pages are loaded by the OS
+only when accessed and can be dropped from the working set
+without any I/O
+
+******************************************************************/
+
+class MappedFile final
+{
+public:
+    enum AccessPattern
+    {
+        Normal,
+        Sequential,
+        Random,
+    };
+
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool Open(const wxString& fileName);
+    void Close();
+
+    bool IsOpened() const;
+    const char* GetData() const;
+    size_t GetSize() const;
+
+    // hints for the OS how the pages will be accessed
+    void Advise(const AccessPattern pattern);
+    // removes the pages in the range from the process working set
+    void DiscardPages(const size_t offset, const size_t size);
+private:
+#ifdef __WXMSW__
+    void* m_file; // HANDLE
+    void* m_mapping; // HANDLE
+#else
+    int m_fd{-1};
+#endif
+    const char* m_data{nullptr};
+    size_t m_size{0};
+    bool m_opened{false};
+};
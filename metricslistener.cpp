@@ -0,0 +1,598 @@
+///////////////////////////////////////////////////////////////////////////////
+// Project:     wxECharts
+// Home:        https://github.com/PBfordev/wxecharts
+// File Name:   metricslistener.cpp
+// Purpose:     Implementation of StatsD-style metrics listener
+// Author:      PB
+// Created:     2026-10-18
+// Copyright:   (c) 2026 PB
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#include <wx/wx.h>
+
+#ifdef __WXMSW__
+    #include <winsock2.h>
+    #include <ws2tcpip.h>
+#else
+    #include <arpa/inet.h>
+    #include <cerrno>
+    #include <fcntl.h>
+    #include <netinet/in.h>
+    #include <poll.h>
+    #include <sys/socket.h>
+    #include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <random>
+
+#include "csvimporter.h"
+#include "metricslistener.h"
+
+using namespace std;
+
+namespace {
+
+typedef MetricsListener::SocketHandle SocketHandle;
+
+#ifdef __WXMSW__
+const SocketHandle InvalidSocket = INVALID_SOCKET;
+
+int GetLastSocketError()
+{
+    return ::WSAGetLastError();
+}
+
+bool InitializeSockets()
+{
+    WSADATA data;
+
+    return ::WSAStartup(MAKEWORD(2, 2), &data) == 0;
+}
+
+void UninitializeSockets()
+{
+    ::WSACleanup();
+}
+
+bool SetNonBlocking(const SocketHandle socket)
+{
+    u_long nonBlocking = 1;
+
+    return ::ioctlsocket(socket, FIONBIO, &nonBlocking) == 0;
+}
+
+int PollSockets(pollfd* fds, const size_t count, const int timeout)
+{
+    return ::WSAPoll(fds, static_cast<ULONG>(count), timeout);
+}
+
+void CloseSocket(SocketHandle& socket)
+{
+    if ( socket != InvalidSocket )
+        ::closesocket(socket);
+    socket = InvalidSocket;
+}
+#else // #ifdef __WXMSW__
+const SocketHandle InvalidSocket = -1;
+
+int GetLastSocketError()
+{
+    return errno;
+}
+
+bool InitializeSockets()
+{
+    return true;
+}
+
+void UninitializeSockets()
+{}
+
+bool SetNonBlocking(const SocketHandle socket)
+{
+    const int flags = ::fcntl(socket, F_GETFL, 0);
+
+    return flags != -1 && ::fcntl(socket, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+int PollSockets(pollfd* fds, const size_t count, const int timeout)
+{
+    return ::poll(fds, static_cast<nfds_t>(count), timeout);
+}
+
+void CloseSocket(SocketHandle& socket)
+{
+    if ( socket != InvalidSocket )
+        ::close(socket);
+    socket = InvalidSocket;
+}
+#endif // #else // #ifdef __WXMSW__
+
+sockaddr_in GetLoopbackAddress(const uint16_t port)
+{
+    sockaddr_in address;
+
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    return address;
+}
+
+// waiting for the sockets is interrupted regularly to check whether to stop
+constexpr int PollTimeout = 100; // in milliseconds
+
+// the largest UDP datagram
+constexpr size_t ReadBufferSize = 64 * 1024;
+// so that a flood of datagrams does not starve the TCP clients
+constexpr size_t MaxDatagramsPerPoll = 256;
+
+} // anonymous namespace
+
+void MetricsListener::Aggregate::Add(const double value)
+{
+    if ( count == 0 )
+    {
+        min = value;
+        max = value;
+    }
+    else
+    {
+        min = std::min(min, value);
+        max = std::max(max, value);
+    }
+
+    sum += value;
+    ++count;
+    last = value;
+}
+
+double MetricsListener::Aggregate::GetValue() const
+{
+    switch ( type )
+    {
+        case Counter:
+            return sum;
+        case Gauge:
+            return last;
+        case Timing:
+            return count > 0 ? sum / count : numeric_limits<double>::quiet_NaN();
+    }
+
+    return numeric_limits<double>::quiet_NaN();
+}
+
+MetricsListener::MetricsListener()
+    : m_UDPSocket(InvalidSocket), m_TCPSocket(InvalidSocket)
+{}
+
+MetricsListener::~MetricsListener()
+{
+    Stop();
+}
+
+bool MetricsListener::Start(const uint16_t port)
+{
+    wxCHECK_MSG(!m_thread.joinable(), false, "Listener already started");
+
+    if ( !InitializeSockets() )
+    {
+        wxLogError(_("Could not initialize sockets."));
+        return false;
+    }
+    m_socketsInitialized = true;
+
+    const sockaddr_in address = GetLoopbackAddress(port);
+    // so that samples are not dropped when the worker thread is busy
+    const int receiveBufferSize = 4 * 1024 * 1024;
+
+    m_UDPSocket = ::socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    m_TCPSocket = ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+
+#ifndef __WXMSW__
+    // the port can be reused right after the previous listener closed,
+    // on MS Windows this option would allow stealing the port instead
+    const int reuseAddress = 1;
+
+    if ( m_TCPSocket != InvalidSocket )
+        ::setsockopt(m_TCPSocket, SOL_SOCKET, SO_REUSEADDR,
+                     reinterpret_cast<const char*>(&reuseAddress), sizeof(reuseAddress));
+#endif
+
+    if ( m_UDPSocket == InvalidSocket || m_TCPSocket == InvalidSocket
+         || ::bind(m_UDPSocket, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0
+         || ::bind(m_TCPSocket, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0
+         || ::listen(m_TCPSocket, SOMAXCONN) != 0
+         || !SetNonBlocking(m_UDPSocket) || !SetNonBlocking(m_TCPSocket) )
+    {
+        wxLogError(_("Could not listen on port %u (error %d)."), static_cast<unsigned>(port), GetLastSocketError());
+        Stop();
+        return false;
+    }
+
+    ::setsockopt(m_UDPSocket, SOL_SOCKET, SO_RCVBUF,
+                 reinterpret_cast<const char*>(&receiveBufferSize), sizeof(receiveBufferSize));
+
+    m_readBuffer.resize(ReadBufferSize);
+    m_stop = false;
+    m_thread = thread(&MetricsListener::Listen, this);
+    return true;
+}
+
+void MetricsListener::Stop()
+{
+    m_stop = true;
+    if ( m_thread.joinable() )
+        m_thread.join();
+
+    for ( auto& client : m_clients )
+        CloseSocket(client.socket);
+    m_clients.clear();
+    CloseSocket(m_UDPSocket);
+    CloseSocket(m_TCPSocket);
+
+    if ( m_socketsInitialized )
+    {
+        UninitializeSockets();
+        m_socketsInitialized = false;
+    }
+}
+
+void MetricsListener::TakeInterval(Interval& interval)
+{
+    lock_guard<mutex> lock(m_intervalMutex);
+
+    interval.newMetricNames.swap(m_interval.newMetricNames);
+    m_interval.newMetricNames.clear();
+    interval.aggregates = m_interval.aggregates;
+
+    for ( auto& aggregate : m_interval.aggregates )
+    {
+        // only the last value is kept, for gauges
+        aggregate.sum = 0;
+        aggregate.count = 0;
+        aggregate.min = 0;
+        aggregate.max = 0;
+    }
+}
+
+size_t MetricsListener::GetSampleCount() const
+{
+    return m_sampleCount;
+}
+
+size_t MetricsListener::GetInvalidSampleCount() const
+{
+    return m_invalidSampleCount;
+}
+
+void MetricsListener::Listen()
+{
+    vector<pollfd> fds;
+
+    while ( !m_stop )
+    {
+        fds.clear();
+        fds.push_back({m_UDPSocket, POLLIN, 0});
+        fds.push_back({m_TCPSocket, POLLIN, 0});
+        for ( const auto& client : m_clients )
+            fds.push_back({client.socket, POLLIN, 0});
+
+        if ( PollSockets(fds.data(), fds.size(), PollTimeout) <= 0 )
+            continue;
+
+        if ( fds[0].revents & POLLIN )
+            ReadDatagrams();
+
+        // from the last one, so that removing a client does not shift the others
+        for ( size_t i = m_clients.size(); i-- > 0; )
+        {
+            if ( (fds[2 + i].revents & (POLLIN | POLLHUP | POLLERR)) && !ReadClient(m_clients[i]) )
+            {
+                CloseSocket(m_clients[i].socket);
+                m_clients.erase(m_clients.begin() + i);
+            }
+        }
+
+        // after reading the clients, so that the indices in fds still match
+        if ( fds[1].revents & POLLIN )
+            AcceptClient();
+    }
+}
+
+void MetricsListener::ReadDatagrams()
+{
+    char* buffer = m_readBuffer.data();
+
+    for ( size_t i = 0; i < MaxDatagramsPerPoll; ++i )
+    {
+        const auto size = ::recv(m_UDPSocket, buffer, static_cast<int>(m_readBuffer.size()), 0);
+
+        // no more datagrams
+        if ( size <= 0 )
+            break;
+
+        ParseLines(buffer, buffer + size);
+    }
+}
+
+void MetricsListener::AcceptClient()
+{
+    SocketHandle socket = ::accept(m_TCPSocket, nullptr, nullptr);
+
+    if ( socket == InvalidSocket )
+        return;
+
+    if ( m_clients.size() >= MaxClientCount || !SetNonBlocking(socket) )
+    {
+        CloseSocket(socket);
+        return;
+    }
+
+    m_clients.push_back({socket, string()});
+}
+
+bool MetricsListener::ReadClient(Client& client)
+{
+    char* buffer = m_readBuffer.data();
+    const auto size = ::recv(client.socket, buffer, static_cast<int>(m_readBuffer.size()), 0);
+
+    if ( size == 0 )
+        return false;
+
+    if ( size < 0 )
+    {
+        const int error = GetLastSocketError();
+
+#ifdef __WXMSW__
+        return error == WSAEWOULDBLOCK;
+#else
+        return error == EAGAIN || error == EWOULDBLOCK || error == EINTR;
+#endif
+    }
+
+    const char* first = buffer;
+    const char* const last = buffer + size;
+    const char* lastLineEnd = last;
+
+    while ( lastLineEnd > first && lastLineEnd[-1] != '\n' )
+        --lastLineEnd;
+
+    // the line continues in the next read
+    if ( lastLineEnd == first )
+    {
+        client.pending.append(first, last);
+        if ( client.pending.size() > MaxLineLength )
+        {
+            ++m_invalidSampleCount;
+            client.pending.clear();
+        }
+        return true;
+    }
+
+    // complete the line started in the previous read
+    if ( !client.pending.empty() )
+    {
+        const char* firstLineEnd = static_cast<const char*>(memchr(first, '\n', last - first));
+
+        client.pending.append(first, firstLineEnd);
+        ParseLines(client.pending.data(), client.pending.data() + client.pending.size());
+        client.pending.clear();
+        first = firstLineEnd + 1;
+    }
+
+    ParseLines(first, lastLineEnd);
+    client.pending.assign(lastLineEnd, last);
+    return true;
+}
+
+void MetricsListener::ParseLines(const char* first, const char* last)
+{
+    size_t sampleCount = 0;
+    size_t invalidSampleCount = 0;
+
+    {
+        // locked only once for all the samples
+        lock_guard<mutex> lock(m_intervalMutex);
+
+        while ( first < last )
+        {
+            const char* lineEnd = find(first, last, '\n');
+            const char* lineLast = lineEnd;
+
+            if ( lineLast > first && lineLast[-1] == '\r' )
+                --lineLast;
+
+            if ( lineLast > first )
+            {
+                if ( ParseSample(first, lineLast) )
+                    ++sampleCount;
+                else
+                    ++invalidSampleCount;
+            }
+
+            first = lineEnd == last ? last : lineEnd + 1;
+        }
+    }
+
+    m_sampleCount += sampleCount;
+    m_invalidSampleCount += invalidSampleCount;
+}
+
+bool MetricsListener::ParseSample(const char* first, const char* last)
+{
+    const char* nameLast = find(first, last, ':');
+
+    if ( nameLast == first || nameLast == last )
+        return false;
+
+    const char* valueFirst = nameLast + 1;
+    const char* valueLast = find(valueFirst, last, '|');
+
+    if ( valueLast == last )
+        return false;
+
+    const char* typeFirst = valueLast + 1;
+    const char* typeLast = find(typeFirst, last, '|');
+    const string typeStr(typeFirst, typeLast);
+    MetricType type = Counter;
+
+    if ( typeStr == "c" )
+        type = Counter;
+    else if ( typeStr == "g" )
+        type = Gauge;
+    else if ( typeStr == "ms" || typeStr == "h" || typeStr == "d" )
+        type = Timing;
+    else
+        return false;
+
+    double sampleRate = 1;
+
+    for ( const char* field = typeLast; field < last; )
+    {
+        const char* fieldFirst = field + 1;
+        const char* fieldLast = find(fieldFirst, last, '|');
+
+        // the tags and other extensions are ignored
+        if ( fieldFirst < fieldLast && *fieldFirst == '@'
+             && (!CSVImporter::ParseDouble(fieldFirst + 1, fieldLast, sampleRate)
+                 || !(sampleRate > 0 && sampleRate <= 1)) )
+            return false;
+        field = fieldLast;
+    }
+
+    double value = 0;
+
+    // an empty value is NaN
+    if ( !CSVImporter::ParseDouble(valueFirst, valueLast, value) || !std::isfinite(value) )
+        return false;
+
+    const auto result = m_metricIndices.emplace(string(first, nameLast), m_metricIndices.size());
+
+    if ( result.second )
+    {
+        m_interval.newMetricNames.push_back(wxString::FromUTF8(first, nameLast - first));
+        m_interval.aggregates.emplace_back();
+        m_interval.aggregates.back().type = type;
+    }
+
+    Aggregate& aggregate = m_interval.aggregates[result.first->second];
+
+    if ( aggregate.type == Counter )
+        aggregate.Add(value / sampleRate);
+    else if ( aggregate.type == Gauge && (*valueFirst == '+' || *valueFirst == '-') )
+        aggregate.Add(aggregate.last + value);
+    else
+        aggregate.Add(value);
+
+    return true;
+}
+
+MetricsTestGenerator::MetricsTestGenerator()
+    : m_socket(InvalidSocket)
+{}
+
+MetricsTestGenerator::~MetricsTestGenerator()
+{
+    Stop();
+}
+
+bool MetricsTestGenerator::Start(const uint16_t port, const size_t samplesPerSecond)
+{
+    wxCHECK_MSG(!m_thread.joinable(), false, "Generator already started");
+    wxCHECK(samplesPerSecond > 0, false);
+
+    if ( !InitializeSockets() )
+    {
+        wxLogError(_("Could not initialize sockets."));
+        return false;
+    }
+    m_socketsInitialized = true;
+
+    const sockaddr_in address = GetLoopbackAddress(port);
+
+    m_socket = ::socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if ( m_socket == InvalidSocket
+         || ::connect(m_socket, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 )
+    {
+        wxLogError(_("Could not create the socket for sending metrics (error %d)."), GetLastSocketError());
+        Stop();
+        return false;
+    }
+
+    m_stop = false;
+    m_thread = thread(&MetricsTestGenerator::Generate, this, samplesPerSecond);
+    return true;
+}
+
+void MetricsTestGenerator::Stop()
+{
+    m_stop = true;
+    if ( m_thread.joinable() )
+        m_thread.join();
+
+    CloseSocket(m_socket);
+    if ( m_socketsInitialized )
+    {
+        UninitializeSockets();
+        m_socketsInitialized = false;
+    }
+}
+
+void MetricsTestGenerator::Generate(const size_t samplesPerSecond)
+{
+    // samples are sent in small bursts, each packed into as few
+    // datagrams as possible, which do not exceed the usual MTU
+    static constexpr int burstInterval = 10; // in milliseconds
+    static constexpr size_t maxDatagramSize = 1400;
+
+    const size_t samplesPerBurst = max<size_t>(1, samplesPerSecond * burstInterval / 1000);
+    mt19937 generator(random_device{}());
+    lognormal_distribution<double> latency(3, 0.5);
+    uniform_int_distribution<int> step(-1, 1);
+    string datagram;
+    char sample[64];
+    auto nextBurst = chrono::steady_clock::now();
+
+    while ( !m_stop )
+    {
+        for ( size_t i = 0; i < samplesPerBurst; ++i )
+        {
+            switch ( i % 3 )
+            {
+                case 0:
+                    snprintf(sample, sizeof(sample), "demo.requests:1|c\n");
+                    break;
+                case 1:
+                    snprintf(sample, sizeof(sample), "demo.latency:%.2f|ms\n", latency(generator));
+                    break;
+                default:
+                    snprintf(sample, sizeof(sample), "demo.queue:%+d|g\n", step(generator));
+                    break;
+            }
+
+            if ( datagram.size() + strlen(sample) > maxDatagramSize )
+            {
+                ::send(m_socket, datagram.data(), static_cast<int>(datagram.size()), 0);
+                datagram.clear();
+            }
+            datagram += sample;
+        }
+
+        if ( !datagram.empty() )
+        {
+            ::send(m_socket, datagram.data(), static_cast<int>(datagram.size()), 0);
+            datagram.clear();
+        }
+
+        nextBurst += chrono::milliseconds(burstInterval);
+        this_thread::sleep_until(nextBurst);
+    }
+}
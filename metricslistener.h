@@ -0,0 +1,169 @@
+///////////////////////////////////////////////////////////////////////////////
+// Project:     wxECharts
+// Home:        https://github.com/PBfordev/wxecharts
+// File Name:   metricslistener.h
+// Purpose:     Declaration of StatsD-style metrics listener
+// Author:      PB
+// Created:     2026-10-18
+// Copyright:   (c) 2026 PB
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <wx/string.h>
+
+/*****************************************************************
+
+MetricsListener
+---------------
+receives metric samples in the StatsD format on a local UDP
+and TCP port and aggregates them in a worker thread
+
+Each sample is one line
+
+  <metric>:<value>|<type>[|@<sample rate>][|#<tags>]
+
+where type is c (counter), g (gauge), ms, h or d (timing,
+histogram, distribution). A UDP datagram can contain several
+lines, TCP clients send a stream of lines. A gauge value
+starting with a sign changes the last value of the gauge.
+
+The samples are aggregated per metric (sum, count, min, max
+and last) until the aggregates are taken by TakeInterval(),
+usually on a timer in the GUI thread. Thus any number of
+samples results in just one value per metric and interval.
+
+******************************************************************/
+
+class MetricsListener final
+{
+public:
+    static constexpr uint16_t DefaultPort = 8125;
+
+#ifdef __WXMSW__
+    typedef uintptr_t SocketHandle; // SOCKET
+#else
+    typedef int SocketHandle;
+#endif
+
+    enum MetricType
+    {
+        Counter,
+        Gauge,
+        Timing,
+    };
+
+    struct Aggregate
+    {
+        MetricType type{Counter};
+        double sum{0};
+        size_t count{0};
+        double min{0};
+        double max{0};
+        // for gauges, kept from previous intervals
+        double last{0};
+
+        void Add(const double value);
+
+        // the value charted for the interval: the sum for counters,
+        // the last value for gauges and the mean for timings
+        double GetValue() const;
+    };
+
+    struct Interval
+    {
+        // the metrics received for the first time in this interval,
+        // their indices continue after the metrics from previous intervals
+        std::vector<wxString> newMetricNames;
+        // one for each metric received so far, count is 0
+        // if the metric was not received in the interval
+        std::vector<Aggregate> aggregates;
+    };
+
+    MetricsListener();
+    ~MetricsListener();
+
+    // listens on the loopback interface only
+    bool Start(const uint16_t port = DefaultPort);
+    void Stop();
+
+    // returns the aggregates since the last call and starts a new interval
+    void TakeInterval(Interval& interval);
+
+    size_t GetSampleCount() const;
+    size_t GetInvalidSampleCount() const;
+private:
+    struct Client
+    {
+        SocketHandle socket;
+        // the incomplete line from the previous read
+        std::string pending;
+    };
+
+    static constexpr size_t MaxClientCount = 64;
+    // longer lines are skipped as invalid
+    static constexpr size_t MaxLineLength = 4096;
+
+    SocketHandle m_UDPSocket;
+    SocketHandle m_TCPSocket;
+    std::vector<Client> m_clients;
+    std::vector<char> m_readBuffer;
+    bool m_socketsInitialized{false};
+    std::thread m_thread;
+    std::atomic<bool> m_stop{false};
+
+    std::atomic<size_t> m_sampleCount{0};
+    std::atomic<size_t> m_invalidSampleCount{0};
+
+    // used only in the worker thread
+    std::unordered_map<std::string, size_t> m_metricIndices;
+
+    std::mutex m_intervalMutex;
+    Interval m_interval;
+
+    // runs in the worker thread
+    void Listen();
+    void ReadDatagrams();
+    void AcceptClient();
+    // returns false when the client disconnected
+    bool ReadClient(Client& client);
+    // parses the lines in [first, last) and aggregates the samples
+    void ParseLines(const char* first, const char* last);
+    bool ParseSample(const char* first, const char* last);
+};
+
+/*****************************************************************
+
+MetricsTestGenerator
+---------------
+sends random metric samples over UDP to a MetricsListener
+on the loopback interface, for testing and demonstration
+
+******************************************************************/
+
+class MetricsTestGenerator final
+{
+public:
+    MetricsTestGenerator();
+    ~MetricsTestGenerator();
+
+    bool Start(const uint16_t port, const size_t samplesPerSecond);
+    void Stop();
+private:
+    MetricsListener::SocketHandle m_socket;
+    bool m_socketsInitialized{false};
+    std::thread m_thread;
+    std::atomic<bool> m_stop{false};
+
+    // runs in the worker thread
+    void Generate(const size_t samplesPerSecond);
+};
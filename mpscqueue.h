@@ -0,0 +1,103 @@
+///////////////////////////////////////////////////////////////////////////////
+// Project:     wxECharts
+// Home:        https://github.com/PBfordev/wxecharts
+// File Name:   mpscqueue.h
+// Purpose:     Lock-free multiple-producer single-consumer queue
+// Author:      PB
+// Created:     2026-10-18
+// Copyright:   (c) 2026 PB
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+/*****************************************************************
+
+MPSCQueue
+---------------
+unbounded lock-free queue for passing items from any number
+of producer threads to exactly one consumer thread
+
+Each item is moved into its own node linked to the queue with
+one atomic exchange, so pushing never waits for other producers
+or the consumer (but allocating the node may take a lock in the
+memory allocator). The items pushed by one thread are popped in
+the order they were pushed, the items pushed by different threads
+in the order their exchanges happened.
+
+An item may not be poppable for a short while after another
+producer started pushing before it, i.e., TryPop() can fail
+while a Push() is in progress in another thread. Once Push()
+returned, the item and all the items before it can be popped.
+
+******************************************************************/
+
+template <typename T>
+class MPSCQueue final
+{
+public:
+    MPSCQueue()
+    {
+        Node* stub = new Node;
+
+        m_head.store(stub, std::memory_order_relaxed);
+        m_tail = stub;
+    }
+
+    ~MPSCQueue()
+    {
+        T item;
+
+        while ( TryPop(item) )
+            ;
+        delete m_tail;
+    }
+
+    MPSCQueue(const MPSCQueue&) = delete;
+    MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+    // can be called from any thread
+    void Push(T&& item)
+    {
+        Node* node = new Node(std::move(item));
+        Node* prev = m_head.exchange(node, std::memory_order_acq_rel);
+
+        prev->next.store(node, std::memory_order_release);
+    }
+
+    // called only from the consumer thread
+    bool TryPop(T& item)
+    {
+        Node* tail = m_tail;
+        Node* next = tail->next.load(std::memory_order_acquire);
+
+        if ( !next )
+            return false;
+
+        // next becomes the new stub, its item is no longer needed
+        item = std::move(next->item);
+        m_tail = next;
+        delete tail;
+        return true;
+    }
+private:
+    static constexpr size_t CacheLineSize = 64;
+
+    struct Node
+    {
+        std::atomic<Node*> next{nullptr};
+        T item;
+
+        Node() {}
+        explicit Node(T&& item_) : item(std::move(item_)) {}
+    };
+
+    // the producers and the consumer positions are on their own cache lines
+    std::atomic<Node*> m_head;
+    char m_headPadding[CacheLineSize - sizeof(std::atomic<Node*>)];
+    Node* m_tail;
+};
@@ -0,0 +1,84 @@
+///////////////////////////////////////////////////////////////////////////////
+// Project:     wxECharts
+// Home:        https://github.com/PBfordev/wxecharts
+// File Name:   ringbuffer.h
+// Purpose:     Fixed-capacity ring buffer
+// Author:      PB
+// Created:     2026-10-18
+// Copyright:   (c) 2026 PB
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+/*****************************************************************
+
+RingBuffer
+---------------
+fixed-capacity buffer, where pushing an item into the full
+buffer evicts the oldest item; the memory is allocated only
+once and both pushing and evicting are O(1)
+
+******************************************************************/
+
+template <typename T>
+class RingBuffer final
+{
+public:
+    explicit RingBuffer(const size_t capacity = 0)
+        : m_items(capacity)
+    {}
+
+    size_t GetCapacity() const { return m_items.size(); }
+    size_t GetSize() const { return m_size; }
+    bool IsEmpty() const { return m_size == 0; }
+    bool IsFull() const { return m_size == m_items.size(); }
+
+    // returns true if the oldest item was evicted
+    bool Push(const T& item)
+    {
+        if ( m_items.empty() )
+            return false;
+
+        size_t idx = m_first + m_size;
+
+        if ( idx >= m_items.size() )
+            idx -= m_items.size();
+        m_items[idx] = item;
+
+        if ( m_size < m_items.size() )
+        {
+            ++m_size;
+            return false;
+        }
+
+        if ( ++m_first == m_items.size() )
+            m_first = 0;
+        return true;
+    }
+
+    // idx 0 is the oldest item
+    const T& operator[](const size_t idx) const
+    {
+        size_t itemIdx = m_first + idx;
+
+        if ( itemIdx >= m_items.size() )
+            itemIdx -= m_items.size();
+        return m_items[itemIdx];
+    }
+
+    const T& GetNewest() const { return (*this)[m_size - 1]; }
+
+    void Clear()
+    {
+        m_first = 0;
+        m_size = 0;
+    }
+private:
+    std::vector<T> m_items;
+    size_t m_first{0};
+    size_t m_size{0};
+};
@@ -0,0 +1,324 @@
+///////////////////////////////////////////////////////////////////////////////
+// Project:     wxECharts
+// Home:        https://github.com/PBfordev/wxecharts
+// File Name:   seriespyramid.cpp
+// Purpose:     Implementation of min/max pyramid for series level of detail
+// Author:      PB
+// Created:     2026-10-18
+// Copyright:   (c) 2026 PB
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#include <wx/wx.h>
+
+#include <algorithm>
+#include <limits>
+
+#include "seriespyramid.h"
+
+using namespace std;
+
+namespace {
+
+SeriesPyramid::MinMax EmptyMinMax()
+{
+    return { numeric_limits<double>::infinity(), -numeric_limits<double>::infinity() };
+}
+
+// NaN values are ignored, as all the comparisons with them are false
+inline void AddValue(SeriesPyramid::MinMax& minMax, const double value)
+{
+    if ( value < minMax.min )
+        minMax.min = value;
+    if ( value > minMax.max )
+        minMax.max = value;
+}
+
+inline void AddMinMax(SeriesPyramid::MinMax& minMax, const SeriesPyramid::MinMax& other)
+{
+    if ( other.min < minMax.min )
+        minMax.min = other.min;
+    if ( other.max > minMax.max )
+        minMax.max = other.max;
+}
+
+} // anonymous namespace
+
+SeriesPyramid::SeriesPyramid(const size_t baseItemSize)
+    : m_baseItemSize(baseItemSize)
+{
+    wxASSERT(m_baseItemSize > 1);
+}
+
+void SeriesPyramid::Clear()
+{
+    m_levels.clear();
+    m_levelViews.clear();
+    m_attached = false;
+    m_valueCount = 0;
+}
+
+void SeriesPyramid::Build(const double* values, const size_t count)
+{
+    Clear();
+    Update(values, count, 0, count);
+}
+
+void SeriesPyramid::Update(const double* values, const size_t count, const size_t first, const size_t last)
+{
+    wxCHECK_RET(values || count == 0, "values is null");
+    wxCHECK_RET(!m_attached, "Attached pyramid cannot be updated");
+
+    size_t levelFirst = first;
+    size_t levelLast = min(last, count);
+    size_t prevLevelSize = count;
+    size_t levelCount = 0;
+
+    m_valueCount = count;
+
+    while ( prevLevelSize > (levelCount == 0 ? m_baseItemSize : Fanout) )
+    {
+        const size_t childCount = levelCount == 0 ? m_baseItemSize : Fanout;
+        const size_t levelSize = (prevLevelSize + childCount - 1) / childCount;
+
+        if ( m_levels.size() <= levelCount )
+            m_levels.emplace_back();
+
+        vector<MinMax>& items = m_levels[levelCount];
+        const size_t oldLevelSize = items.size();
+
+        items.resize(levelSize);
+
+        // items which did not exist before must be computed too
+        levelFirst = min(levelFirst / childCount, oldLevelSize);
+        levelLast = min(max((levelLast + childCount - 1) / childCount, levelFirst), levelSize);
+        if ( oldLevelSize < levelSize )
+            levelLast = levelSize;
+
+        for ( size_t i = levelFirst; i < levelLast; ++i )
+        {
+            const size_t childFirst = i * childCount;
+            const size_t childLast = min(childFirst + childCount, prevLevelSize);
+            MinMax minMax = EmptyMinMax();
+
+            if ( levelCount == 0 )
+            {
+                for ( size_t c = childFirst; c < childLast; ++c )
+                    AddValue(minMax, values[c]);
+            }
+            else
+            {
+                const vector<MinMax>& children = m_levels[levelCount - 1];
+
+                for ( size_t c = childFirst; c < childLast; ++c )
+                    AddMinMax(minMax, children[c]);
+            }
+            items[i] = minMax;
+        }
+
+        prevLevelSize = levelSize;
+        ++levelCount;
+    }
+
+    m_levels.resize(levelCount);
+
+    m_levelViews.clear();
+    for ( const auto& l : m_levels )
+        m_levelViews.push_back({l.data(), l.size()});
+}
+
+bool SeriesPyramid::Attach(const MinMax* items, const size_t itemCount, const size_t valueCount)
+{
+    const vector<size_t> levelSizes = GetLevelSizes(valueCount, m_baseItemSize);
+    size_t expectedItemCount = 0;
+
+    for ( const auto s : levelSizes )
+        expectedItemCount += s;
+
+    wxCHECK(items || expectedItemCount == 0, false);
+    wxCHECK_MSG(itemCount == expectedItemCount, false, "Invalid number of pyramid items");
+
+    Clear();
+    for ( const auto s : levelSizes )
+    {
+        m_levelViews.push_back({items, s});
+        items += s;
+    }
+    m_attached = true;
+    m_valueCount = valueCount;
+    return true;
+}
+
+size_t SeriesPyramid::GetBaseItemSize() const
+{
+    return m_baseItemSize;
+}
+
+size_t SeriesPyramid::GetLevelCount() const
+{
+    return m_levelViews.size();
+}
+
+size_t SeriesPyramid::GetValueCount() const
+{
+    return m_valueCount;
+}
+
+size_t SeriesPyramid::GetMemoryUsage() const
+{
+    size_t usage = 0;
+
+    for ( const auto& l : m_levels )
+        usage += l.capacity() * sizeof(MinMax);
+    return usage;
+}
+
+const SeriesPyramid::MinMax* SeriesPyramid::GetLevelItems(const size_t level, size_t& itemCount) const
+{
+    wxCHECK(level > 0 && level <= m_levelViews.size(), nullptr);
+
+    itemCount = m_levelViews[level - 1].size;
+    return m_levelViews[level - 1].items;
+}
+
+vector<size_t> SeriesPyramid::GetLevelSizes(const size_t valueCount, const size_t baseItemSize)
+{
+    vector<size_t> sizes;
+    size_t prevLevelSize = valueCount;
+
+    while ( prevLevelSize > (sizes.empty() ? baseItemSize : Fanout) )
+    {
+        const size_t childCount = sizes.empty() ? baseItemSize : Fanout;
+
+        prevLevelSize = (prevLevelSize + childCount - 1) / childCount;
+        sizes.push_back(prevLevelSize);
+    }
+    return sizes;
+}
+
+void SeriesPyramid::GetBuckets(const double* values, const size_t first, const size_t last,
+                               const size_t maxBuckets, std::vector<Bucket>& buckets) const
+{
+    buckets.clear();
+
+    wxCHECK_RET(values, "values is null");
+    wxCHECK_RET(last <= m_valueCount, "Invalid range");
+
+    if ( first >= last || maxBuckets == 0 )
+        return;
+
+    const size_t bucketSize = (last - first + maxBuckets - 1) / maxBuckets;
+
+    buckets.reserve((last - first + bucketSize - 1) / bucketSize);
+
+    if ( bucketSize == 1 )
+    {
+        for ( size_t i = first; i < last; ++i )
+            buckets.push_back({i, i + 1, {values[i], values[i]}});
+        return;
+    }
+
+    // the coarsest level whose items are not larger than the bucket,
+    // so that a bucket is aggregated from at most 2 * Fanout items per level
+    size_t level = 0;
+
+    while ( level < m_levelViews.size() && GetItemSize(level + 1) <= bucketSize )
+        ++level;
+
+    for ( size_t bucketFirst = first; bucketFirst < last; bucketFirst += bucketSize )
+    {
+        const size_t bucketLast = min(bucketFirst + bucketSize, last);
+        MinMax minMax = EmptyMinMax();
+
+        Accumulate(values, level, bucketFirst, bucketLast, minMax);
+        buckets.push_back({bucketFirst, bucketLast, minMax});
+    }
+}
+
+void SeriesPyramid::GetLevelBuckets(const double* values, const size_t minBuckets,
+                                    std::vector<Bucket>& buckets) const
+{
+    size_t level = m_levelViews.size();
+
+    while ( level > 0 && m_levelViews[level - 1].size < minBuckets )
+        --level;
+
+    if ( level == 0 )
+    {
+        GetBuckets(values, 0, m_valueCount, minBuckets, buckets);
+        return;
+    }
+
+    const LevelView& view = m_levelViews[level - 1];
+    const size_t itemSize = GetItemSize(level);
+
+    buckets.clear();
+    buckets.reserve(view.size);
+    for ( size_t i = 0; i < view.size; ++i )
+        buckets.push_back({i * itemSize, min((i + 1) * itemSize, m_valueCount), view.items[i]});
+}
+
+void SeriesPyramid::GetSampledBuckets(const double* values, const size_t first, const size_t last,
+                                      const size_t maxBuckets, std::vector<Bucket>& buckets)
+{
+    buckets.clear();
+
+    wxCHECK_RET(values, "values is null");
+
+    if ( first >= last || maxBuckets == 0 )
+        return;
+
+    const size_t bucketSize = (last - first + maxBuckets - 1) / maxBuckets;
+
+    buckets.reserve((last - first + bucketSize - 1) / bucketSize);
+    for ( size_t bucketFirst = first; bucketFirst < last; bucketFirst += bucketSize )
+    {
+        const double value = values[bucketFirst];
+
+        buckets.push_back({bucketFirst, min(bucketFirst + bucketSize, last), {value, value}});
+    }
+}
+
+size_t SeriesPyramid::GetItemSize(const size_t level) const
+{
+    if ( level == 0 )
+        return 1;
+
+    size_t size = m_baseItemSize;
+
+    for ( size_t i = 1; i < level; ++i )
+        size *= Fanout;
+    return size;
+}
+
+void SeriesPyramid::Accumulate(const double* values, const size_t level,
+                               const size_t first, const size_t last, MinMax& minMax) const
+{
+    if ( first >= last )
+        return;
+
+    if ( level == 0 )
+    {
+        for ( size_t i = first; i < last; ++i )
+            AddValue(minMax, values[i]);
+        return;
+    }
+
+    const size_t itemSize = GetItemSize(level);
+    const size_t fullFirst = (first + itemSize - 1) / itemSize;
+    // the last item at a level may cover fewer values than itemSize
+    const size_t fullLast = last == m_valueCount ? (last + itemSize - 1) / itemSize : last / itemSize;
+
+    if ( fullFirst >= fullLast )
+    {
+        Accumulate(values, level - 1, first, last, minMax);
+        return;
+    }
+
+    const MinMax* items = m_levelViews[level - 1].items;
+
+    Accumulate(values, level - 1, first, fullFirst * itemSize, minMax);
+    for ( size_t i = fullFirst; i < fullLast; ++i )
+        AddMinMax(minMax, items[i]);
+    Accumulate(values, level - 1, min(fullLast * itemSize, last), last, minMax);
+}
@@ -0,0 +1,117 @@
+///////////////////////////////////////////////////////////////////////////////
+// Project:     wxECharts
+// Home:        https://github.com/PBfordev/wxecharts
+// File Name:   seriespyramid.h
+// Purpose:     Declaration of min/max pyramid for series level of detail
+// Author:      PB
+// Created:     2026-10-18
+// Copyright:   (c) 2026 PB
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+/*****************************************************************
+
+SeriesPyramid
+---------------
+min/max pyramid over series values, used to obtain
+a fixed number of min/max buckets for any range of values
+without visiting all the values in the range
+
+Level 0 is the values themselves, they are not stored in
+the pyramid and must be passed to the methods which need
+them. An item at level 1 aggregates baseItemSize values,
+an item at level N > 1 aggregates Fanout items at level N-1.
+
+The pyramid either owns its levels (built from the values) or
+uses levels stored elsewhere, e.g., in a memory-mapped file,
+see Attach(). Such pyramid cannot be updated.
+
+******************************************************************/
+
+class SeriesPyramid final
+{
+public:
+    static constexpr size_t Fanout = 8;
+
+    struct MinMax
+    {
+        double min;
+        double max;
+    };
+
+    // a range of values [first, last) aggregated into one min/max pair
+    struct Bucket
+    {
+        size_t first;
+        size_t last;
+        MinMax value;
+    };
+
+    explicit SeriesPyramid(const size_t baseItemSize = Fanout);
+
+    void Clear();
+
+    // (re)builds the whole pyramid for the values
+    void Build(const double* values, const size_t count);
+
+    // updates the pyramid after the values in [first, last) were changed
+    // or appended, count is the current number of values
+    void Update(const double* values, const size_t count, const size_t first, const size_t last);
+
+    // uses the levels stored in items, which must remain valid while used
+    // by the pyramid, items must contain all levels one after another
+    // in the order from level 1, with sizes as returned by GetLevelSizes()
+    bool Attach(const MinMax* items, const size_t itemCount, const size_t valueCount);
+
+    size_t GetBaseItemSize() const;
+    size_t GetLevelCount() const;
+    size_t GetValueCount() const;
+    size_t GetMemoryUsage() const;
+
+    // returns the items of the level (1 to GetLevelCount())
+    const MinMax* GetLevelItems(const size_t level, size_t& itemCount) const;
+
+    // returns the number of items in each level, starting with level 1
+    static std::vector<size_t> GetLevelSizes(const size_t valueCount, const size_t baseItemSize);
+
+    // aggregates the values in [first, last) into at most maxBuckets
+    // buckets of the same size; when the range has no more than maxBuckets
+    // values, every bucket holds exactly one value
+    void GetBuckets(const double* values, const size_t first, const size_t last,
+                    const size_t maxBuckets, std::vector<Bucket>& buckets) const;
+
+    // the items of the coarsest level with at least minBuckets items as
+    // the buckets of all the values, so no values are read; when there
+    // is no such level, the same as GetBuckets() for all the values
+    void GetLevelBuckets(const double* values, const size_t minBuckets,
+                         std::vector<Bucket>& buckets) const;
+
+    // as GetBuckets() but without a pyramid, each bucket is represented
+    // just by its first value; useful as a preview until the pyramid is built
+    static void GetSampledBuckets(const double* values, const size_t first, const size_t last,
+                                  const size_t maxBuckets, std::vector<Bucket>& buckets);
+private:
+    struct LevelView
+    {
+        const MinMax* items;
+        size_t size;
+    };
+
+    size_t m_baseItemSize;
+    // m_levels[0] is level 1 and so on, empty for an attached pyramid
+    std::vector<std::vector<MinMax>> m_levels;
+    // all levels, either owned or attached
+    std::vector<LevelView> m_levelViews;
+    bool m_attached{false};
+    size_t m_valueCount{0};
+
+    size_t GetItemSize(const size_t level) const;
+
+    void Accumulate(const double* values, const size_t level,
+                    const size_t first, const size_t last, MinMax& minMax) const;
+};
@@ -0,0 +1,315 @@
+///////////////////////////////////////////////////////////////////////////////
+// Project:     wxECharts
+// Home:        https://github.com/PBfordev/wxecharts
+// File Name:   sharedringbuffer.cpp
+// Purpose:     Implementation of reader of shared-memory ring buffer
+// Author:      PB
+// Created:     2026-10-18
+// Copyright:   (c) 2026 PB
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#include <wx/wx.h>
+
+#ifdef __WXMSW__
+    #include <wx/msw/wrapwin.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cstring>
+
+#include "sharedringbuffer.h"
+
+using namespace std;
+
+namespace {
+
+const char     Magic[8]          = { 'w', 'x', 'E', 'C', 'S', 'H', 'R', 'B' };
+const uint32_t Version           = 1;
+const uint32_t MaxSeriesCount    = 1024;
+const size_t   HeaderSize        = 128;
+const size_t   WriteIndexOffset  = 64;
+const size_t   SeriesNameSize    = 64;
+const size_t   RowHeaderSize     = 16; // sequence and timestamp
+
+static_assert(sizeof(atomic<uint64_t>) == sizeof(uint64_t), "Unsupported atomic<uint64_t>");
+
+const atomic<uint64_t>* GetAtomic(const char* data)
+{
+    return reinterpret_cast<const atomic<uint64_t>*>(data);
+}
+
+// the reserved parts of the header must be 0, so that they
+// can be used by the later layout versions
+bool AreReservedBytesZero(const char* header)
+{
+    auto isZero = [](const char c) { return c == 0; };
+
+    return all_of(header + 24, header + WriteIndexOffset, isZero)
+           && all_of(header + WriteIndexOffset + sizeof(uint64_t), header + HeaderSize, isZero);
+}
+
+} // anonymous namespace
+
+SharedRingBuffer::SharedRingBuffer()
+{}
+
+SharedRingBuffer::~SharedRingBuffer()
+{
+    Detach();
+}
+
+#ifdef __WXMSW__
+
+bool SharedRingBuffer::Attach(const wxString& name)
+{
+    Detach();
+
+    m_mapping = ::OpenFileMappingW(FILE_MAP_READ, FALSE, name.wc_str());
+    if ( !m_mapping )
+    {
+        wxLogSysError(_("Could not open shared memory '%s'"), name);
+        return false;
+    }
+
+    m_data = static_cast<const char*>(::MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+    if ( !m_data )
+    {
+        wxLogSysError(_("Could not map shared memory '%s'"), name);
+        Detach();
+        return false;
+    }
+
+    MEMORY_BASIC_INFORMATION info;
+
+    // the view is as large as the mapping, rounded up to the page size
+    if ( ::VirtualQuery(m_data, &info, sizeof(info)) == 0 )
+    {
+        wxLogSysError(_("Could not obtain size of shared memory '%s'"), name);
+        Detach();
+        return false;
+    }
+
+    m_size = info.RegionSize;
+    m_name = name;
+
+    if ( !ReadHeader() )
+    {
+        Detach();
+        return false;
+    }
+
+    return true;
+}
+
+void SharedRingBuffer::Detach()
+{
+    if ( m_data )
+        ::UnmapViewOfFile(m_data);
+    if ( m_mapping )
+        ::CloseHandle(m_mapping);
+
+    m_mapping = nullptr;
+    m_data = nullptr;
+    m_size = 0;
+    m_name.clear();
+    m_seriesNames.clear();
+    m_rows = nullptr;
+}
+
+#else // #ifdef __WXMSW__
+
+bool SharedRingBuffer::Attach(const wxString& name)
+{
+    Detach();
+
+    wxString objectName(name);
+
+    if ( !objectName.StartsWith("/") )
+        objectName.insert(0, "/");
+
+    const int fd = shm_open(objectName.fn_str(), O_RDONLY, 0);
+
+    if ( fd == -1 )
+    {
+        wxLogSysError(_("Could not open shared memory '%s'"), objectName);
+        return false;
+    }
+
+    struct stat st;
+
+    if ( fstat(fd, &st) != 0 )
+    {
+        wxLogSysError(_("Could not obtain size of shared memory '%s'"), objectName);
+        close(fd);
+        return false;
+    }
+
+    if ( static_cast<size_t>(st.st_size) < HeaderSize )
+    {
+        wxLogError(_("Shared memory '%s' is not a ring buffer."), objectName);
+        close(fd);
+        return false;
+    }
+
+    void* data = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+
+    // the mapping stays valid after the descriptor is closed
+    close(fd);
+
+    if ( data == MAP_FAILED )
+    {
+        wxLogSysError(_("Could not map shared memory '%s'"), objectName);
+        return false;
+    }
+
+    m_data = static_cast<const char*>(data);
+    m_size = static_cast<size_t>(st.st_size);
+    m_name = objectName;
+
+    if ( !ReadHeader() )
+    {
+        Detach();
+        return false;
+    }
+
+    return true;
+}
+
+void SharedRingBuffer::Detach()
+{
+    if ( m_data )
+        munmap(const_cast<char*>(m_data), m_size);
+
+    m_data = nullptr;
+    m_size = 0;
+    m_name.clear();
+    m_seriesNames.clear();
+    m_rows = nullptr;
+}
+
+#endif // #else // #ifdef __WXMSW__
+
+bool SharedRingBuffer::IsAttached() const
+{
+    return m_data != nullptr;
+}
+
+const wxString& SharedRingBuffer::GetName() const
+{
+    return m_name;
+}
+
+size_t SharedRingBuffer::GetCapacity() const
+{
+    return static_cast<size_t>(m_capacity);
+}
+
+const std::vector<wxString>& SharedRingBuffer::GetSeriesNames() const
+{
+    return m_seriesNames;
+}
+
+uint64_t SharedRingBuffer::GetLostRowCount() const
+{
+    return m_lostRowCount;
+}
+
+bool SharedRingBuffer::ReadHeader()
+{
+    uint32_t version = 0;
+    uint32_t seriesCount = 0;
+    uint64_t capacity = 0;
+
+    if ( m_size < HeaderSize || memcmp(m_data, Magic, sizeof(Magic)) != 0 )
+    {
+        wxLogError(_("Shared memory '%s' is not a ring buffer."), m_name);
+        return false;
+    }
+
+    memcpy(&version, m_data + 8, sizeof(version));
+    memcpy(&seriesCount, m_data + 12, sizeof(seriesCount));
+    memcpy(&capacity, m_data + 16, sizeof(capacity));
+
+    if ( version != Version )
+    {
+        wxLogError(_("Unsupported version %u of ring buffer in shared memory '%s'."), version, m_name);
+        return false;
+    }
+
+    if ( seriesCount == 0 || seriesCount > MaxSeriesCount || capacity == 0
+         || !AreReservedBytesZero(m_data) )
+    {
+        wxLogError(_("Invalid header of ring buffer in shared memory '%s'."), m_name);
+        return false;
+    }
+
+    const size_t rowsOffset = HeaderSize + seriesCount * SeriesNameSize;
+    const size_t rowSize = RowHeaderSize + seriesCount * sizeof(double);
+
+    if ( m_size < rowsOffset || capacity > (m_size - rowsOffset) / rowSize )
+    {
+        wxLogError(_("Shared memory '%s' is too small for the ring buffer."), m_name);
+        return false;
+    }
+
+    m_seriesNames.clear();
+    m_seriesNames.reserve(seriesCount);
+    for ( size_t i = 0; i < seriesCount; ++i )
+    {
+        const char* nameData = m_data + HeaderSize + i * SeriesNameSize;
+        wxString name = wxString::FromUTF8(nameData, strnlen(nameData, SeriesNameSize));
+
+        if ( name.empty() )
+            name.Printf(_("Series %zu"), i + 1);
+
+        for ( const auto& n : m_seriesNames )
+        {
+            if ( n.IsSameAs(name, true) )
+            {
+                wxLogError(_("Series name '%s' is used more than once in shared memory '%s'."), name, m_name);
+                return false;
+            }
+        }
+        m_seriesNames.push_back(name);
+    }
+
+    m_capacity = capacity;
+    m_rowSize = rowSize;
+    m_rows = m_data + rowsOffset;
+    m_values.resize(seriesCount);
+
+    // the rows still in the ring are read too
+    const uint64_t writeIndex = GetWriteIndex();
+
+    m_readIndex = writeIndex > m_capacity ? writeIndex - m_capacity : 0;
+    m_lostRowCount = 0;
+
+    return true;
+}
+
+uint64_t SharedRingBuffer::GetWriteIndex() const
+{
+    return GetAtomic(m_data + WriteIndexOffset)->load(memory_order_acquire);
+}
+
+bool SharedRingBuffer::ReadRow(const uint64_t idx, int64_t& timestamp)
+{
+    const char* row = m_rows + (idx % m_capacity) * m_rowSize;
+    const atomic<uint64_t>* sequence = GetAtomic(row);
+
+    if ( sequence->load(memory_order_acquire) != idx + 1 )
+        return false;
+
+    memcpy(&timestamp, row + sizeof(uint64_t), sizeof(timestamp));
+    memcpy(m_values.data(), row + RowHeaderSize, m_values.size() * sizeof(double));
+
+    // the row was not overwritten while being read
+    atomic_thread_fence(memory_order_acquire);
+    return sequence->load(memory_order_relaxed) == idx + 1;
+}
@@ -0,0 +1,155 @@
+///////////////////////////////////////////////////////////////////////////////
+// Project:     wxECharts
+// Home:        https://github.com/PBfordev/wxecharts
+// File Name:   sharedringbuffer.h
+// Purpose:     Declaration of reader of shared-memory ring buffer
+// Author:      PB
+// Created:     2026-10-18
+// Copyright:   (c) 2026 PB
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include <wx/string.h>
+
+/*****************************************************************
+
+SharedRingBuffer
+---------------
+reads timestamped values written into a named shared memory
+by another process on the same host, without any locking
+
+The shared memory is created and written by the producer,
+the reader only maps it read-only: on Linux it is a POSIX
+shared memory object (shm_open()), on MS Windows a named
+file mapping.
+
+All numbers are little-endian and naturally aligned.
+
+Header (128 bytes)
+  0  char[8]  magic "wxECSHRB"
+  8  uint32   layout version (1)
+  12 uint32   number of series N (1 to 1024)
+  16 uint64   capacity C: the number of rows in the ring
+  24 -        reserved, must be 0
+  64 uint64   write index: the number of rows written so far,
+              accessed atomically, alone on its cache line
+  72 -        reserved, must be 0
+
+Series names, following the header (64 bytes for each series),
+UTF-8, padded with '\0'.
+
+Rows, following the names (C rows of 16 + 8 * N bytes), the row
+with index i is stored in the slot i % C:
+  0  uint64   sequence, accessed atomically: i + 1 when the row
+              is complete, 0 while it is being written
+  8  int64    timestamp in milliseconds since the Unix epoch,
+              not smaller than the timestamp of the previous row
+  16 float64  values, one for each series
+
+The producer writes the row i as follows:
+  1. store 0 to the sequence
+  2. release fence
+  3. write the timestamp and values
+  4. store i + 1 to the sequence with release semantics
+  5. store i + 1 to the write index with release semantics
+
+The reader reads the row and then checks that its sequence did
+not change, so the rows overwritten while they were read are
+detected (seqlock) and skipped as lost.
+
+******************************************************************/
+
+class SharedRingBuffer final
+{
+public:
+    SharedRingBuffer();
+    ~SharedRingBuffer();
+
+    // on Linux, the name must start with '/', which is added if missing
+    bool Attach(const wxString& name);
+    void Detach();
+    bool IsAttached() const;
+
+    const wxString& GetName() const;
+    size_t GetCapacity() const;
+    const std::vector<wxString>& GetSeriesNames() const;
+
+    // calls onRow(int64_t timestamp, const double* values) for each row written
+    // since the last call, but at most for the newest maxRows rows
+    // returns the number of rows passed to onRow
+    template <typename OnRow>
+    size_t ReadNewRows(const size_t maxRows, OnRow onRow);
+
+    // the rows overwritten by the producer before they could be read
+    uint64_t GetLostRowCount() const;
+private:
+    wxString m_name;
+    const char* m_data{nullptr};
+    size_t m_size{0};
+#ifdef __WXMSW__
+    void* m_mapping{nullptr}; // HANDLE
+#endif
+
+    std::vector<wxString> m_seriesNames;
+    uint64_t m_capacity{0};
+    size_t m_rowSize{0};
+    const char* m_rows{nullptr};
+
+    // the index of the next row to read
+    uint64_t m_readIndex{0};
+    uint64_t m_lostRowCount{0};
+    // the values of the last row read
+    std::vector<double> m_values;
+
+    bool ReadHeader();
+    uint64_t GetWriteIndex() const;
+    // reads the row into m_values, returns false if it was overwritten
+    bool ReadRow(const uint64_t idx, int64_t& timestamp);
+};
+
+template <typename OnRow>
+size_t SharedRingBuffer::ReadNewRows(const size_t maxRows, OnRow onRow)
+{
+    wxCHECK(m_data, 0);
+
+    const uint64_t writeIndex = GetWriteIndex();
+    // the older rows were already overwritten
+    const uint64_t firstAvailable = writeIndex > m_capacity ? writeIndex - m_capacity : 0;
+    size_t count = 0;
+
+    // the producer started anew
+    if ( writeIndex < m_readIndex )
+        m_readIndex = firstAvailable;
+
+    if ( m_readIndex < firstAvailable )
+    {
+        m_lostRowCount += firstAvailable - m_readIndex;
+        m_readIndex = firstAvailable;
+    }
+
+    // the older rows are not needed by the caller
+    m_readIndex = std::max(m_readIndex, writeIndex - std::min<uint64_t>(writeIndex, maxRows));
+
+    for ( ; m_readIndex < writeIndex; ++m_readIndex )
+    {
+        int64_t timestamp = 0;
+
+        if ( !ReadRow(m_readIndex, timestamp) )
+        {
+            ++m_lostRowCount;
+            continue;
+        }
+
+        onRow(timestamp, static_cast<const double*>(m_values.data()));
+        ++count;
+    }
+
+    return count;
+}
@@ -0,0 +1,93 @@
+///////////////////////////////////////////////////////////////////////////////
+// Project:     wxECharts
+// Home:        https://github.com/PBfordev/wxecharts
+// File Name:   spscqueue.h
+// Purpose:     Lock-free single-producer single-consumer queue
+// Author:      PB
+// Created:     2026-10-18
+// Copyright:   (c) 2026 PB
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/*****************************************************************
+
+SPSCQueue
+---------------
+bounded lock-free queue for passing items from exactly one
+producer thread to exactly one consumer thread
+
+The items are moved in and out of slots allocated only once.
+Neither side ever blocks: TryPush() fails when the queue is
+full and TryPop() when it is empty, the caller decides whether
+to wait, retry later or drop the item.
+
+******************************************************************/
+
+template <typename T>
+class SPSCQueue final
+{
+public:
+    // one slot is always kept empty to tell a full queue from an empty one
+    SPSCQueue(const size_t capacity)
+        : m_items(capacity + 1)
+    {}
+
+    size_t GetCapacity() const { return m_items.size() - 1; }
+
+    // called only from the producer thread
+    bool TryPush(T&& item)
+    {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        const size_t next = Next(tail);
+
+        if ( next == m_head.load(std::memory_order_acquire) )
+            return false;
+
+        m_items[tail] = std::move(item);
+        m_tail.store(next, std::memory_order_release);
+        return true;
+    }
+
+    // called only from the consumer thread
+    bool TryPop(T& item)
+    {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+
+        if ( head == m_tail.load(std::memory_order_acquire) )
+            return false;
+
+        item = std::move(m_items[head]);
+        m_head.store(Next(head), std::memory_order_release);
+        return true;
+    }
+
+    // exact only when called from the consumer thread
+    // while the producer is not pushing
+    bool IsEmpty() const
+    {
+        return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+    }
+private:
+    static constexpr size_t CacheLineSize = 64;
+
+    std::vector<T> m_items;
+    // the consumer and producer positions are on their own cache lines,
+    // so that the threads do not invalidate each other's cache lines
+    char m_itemsPadding[CacheLineSize];
+    std::atomic<size_t> m_head{0};
+    char m_headPadding[CacheLineSize - sizeof(std::atomic<size_t>)];
+    std::atomic<size_t> m_tail{0};
+    char m_tailPadding[CacheLineSize - sizeof(std::atomic<size_t>)];
+
+    size_t Next(const size_t idx) const
+    {
+        return idx + 1 == m_items.size() ? 0 : idx + 1;
+    }
+};
@@ -0,0 +1,140 @@
+///////////////////////////////////////////////////////////////////////////////
+// Project:     wxECharts
+// Home:        https://github.com/PBfordev/wxecharts
+// File Name:   taskpool.cpp
+// Purpose:     Implementation of pool of threads running parallel loops
+// Author:      PB
+// Created:     2026-10-18
+// Copyright:   (c) 2026 PB
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#include <wx/wx.h>
+
+#include <algorithm>
+
+#include "taskpool.h"
+
+using namespace std;
+
+TaskPool::TaskPool(const size_t threadCount)
+{
+    size_t count = threadCount;
+
+    if ( count == 0 )
+        count = max(thread::hardware_concurrency(), 1u) - 1;
+
+    for ( size_t i = 0; i < count; ++i )
+        m_threads.emplace_back(&TaskPool::Run, this);
+}
+
+TaskPool::~TaskPool()
+{
+    {
+        lock_guard<mutex> lock(m_mutex);
+
+        m_stop = true;
+    }
+    m_condition.notify_all();
+    for ( auto& t : m_threads )
+        t.join();
+}
+
+size_t TaskPool::GetThreadCount() const
+{
+    return m_threads.size();
+}
+
+TaskPool& TaskPool::GetShared()
+{
+    static TaskPool pool;
+
+    return pool;
+}
+
+void TaskPool::ParallelFor(const size_t count, const std::function<void(size_t)>& f)
+{
+    if ( count == 0 )
+        return;
+
+    // not worth waking up the pool threads
+    if ( count == 1 || m_threads.empty() )
+    {
+        for ( size_t i = 0; i < count; ++i )
+            f(i);
+        return;
+    }
+
+    Loop loop;
+
+    loop.f = &f;
+    loop.count = count;
+
+    {
+        lock_guard<mutex> lock(m_mutex);
+
+        m_loops.push_back(&loop);
+    }
+    m_condition.notify_all();
+
+    const size_t doneCount = RunIterations(loop);
+    unique_lock<mutex> lock(m_mutex);
+
+    RemoveLoop(&loop);
+    loop.doneCount += doneCount;
+    // the pool threads must not access the loop after it is destroyed
+    loop.done.wait(lock, [&loop]() { return loop.doneCount == loop.count && loop.threadCount == 0; });
+}
+
+void TaskPool::Run()
+{
+    unique_lock<mutex> lock(m_mutex);
+
+    for ( ;; )
+    {
+        m_condition.wait(lock, [this]() { return m_stop || !m_loops.empty(); });
+        if ( m_stop )
+            return;
+
+        Loop* loop = m_loops.front();
+
+        ++loop->threadCount;
+        lock.unlock();
+
+        const size_t doneCount = RunIterations(*loop);
+
+        lock.lock();
+        // all the iterations were started
+        RemoveLoop(loop);
+        loop->doneCount += doneCount;
+        --loop->threadCount;
+        if ( loop->doneCount == loop->count && loop->threadCount == 0 )
+            loop->done.notify_one();
+    }
+}
+
+size_t TaskPool::RunIterations(Loop& loop)
+{
+    size_t doneCount = 0;
+
+    for ( ;; )
+    {
+        const size_t idx = loop.next.fetch_add(1, memory_order_relaxed);
+
+        if ( idx >= loop.count )
+            break;
+
+        (*loop.f)(idx);
+        ++doneCount;
+    }
+
+    return doneCount;
+}
+
+void TaskPool::RemoveLoop(Loop* loop)
+{
+    const auto it = find(m_loops.begin(), m_loops.end(), loop);
+
+    if ( it != m_loops.end() )
+        m_loops.erase(it);
+}
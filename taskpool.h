@@ -0,0 +1,84 @@
+///////////////////////////////////////////////////////////////////////////////
+// Project:     wxECharts
+// Home:        https://github.com/PBfordev/wxecharts
+// File Name:   taskpool.h
+// Purpose:     Declaration of pool of threads running parallel loops
+// Author:      PB
+// Created:     2026-10-18
+// Copyright:   (c) 2026 PB
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*****************************************************************
+
+TaskPool
+---------------
+pool of threads running the iterations of parallel loops,
+see ParallelFor()
+
+The thread calling ParallelFor() runs the iterations too, so
+a loop never waits for the pool threads to become available,
+only for the iterations they already started. Several threads
+can run their loops at once, the pool threads help with them
+in the order they were started, so the whole application can
+share one pool, see GetShared().
+
+******************************************************************/
+
+class TaskPool final
+{
+public:
+    // threadCount 0 means one thread less than the number of processors
+    explicit TaskPool(const size_t threadCount = 0);
+    // must not be called while a loop is running
+    ~TaskPool();
+
+    TaskPool(const TaskPool&) = delete;
+    TaskPool& operator=(const TaskPool&) = delete;
+
+    size_t GetThreadCount() const;
+
+    // the pool with the default number of threads shared by the application,
+    // created on the first call
+    static TaskPool& GetShared();
+
+    // calls f(idx) for each idx in [0, count) in any order, in the pool
+    // threads and the calling thread, returns after all the calls returned;
+    // f must not throw
+    void ParallelFor(const size_t count, const std::function<void(size_t)>& f);
+private:
+    struct Loop
+    {
+        const std::function<void(size_t)>* f{nullptr};
+        size_t count{0};
+        std::atomic<size_t> next{0};
+        // accessed under m_mutex
+        size_t doneCount{0};
+        size_t threadCount{0}; // the pool threads working on the loop
+        std::condition_variable done;
+    };
+
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    // the loops with iterations not started yet
+    std::deque<Loop*> m_loops;
+    bool m_stop{false};
+    std::vector<std::thread> m_threads;
+
+    void Run();
+    // runs the iterations not started yet, returns their number
+    static size_t RunIterations(Loop& loop);
+    // called with m_mutex locked
+    void RemoveLoop(Loop* loop);
+};
@@ -0,0 +1,189 @@
+///////////////////////////////////////////////////////////////////////////////
+// Project:     wxECharts
+// Home:        https://github.com/PBfordev/wxecharts
+// File Name:   updatepipeline.h
+// Purpose:     Worker pool preparing chart update frames
+// Author:      PB
+// Created:     2026-10-18
+// Copyright:   (c) 2026 PB
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/*****************************************************************
+
+UpdatePipeline
+---------------
+processes frames (e.g., chart updates) submitted by the GUI
+thread in a pool of worker threads, so that the GUI thread only
+takes the processed frames and does not wait for them
+
+Only the newest frame matters, so the frames are coalesced:
+a submitted frame not yet taken by a worker is replaced by the
+next submitted one, and a processed frame not yet taken by
+the GUI thread is replaced by a newer processed one. The frames
+are numbered as submitted and taken only in ascending order, a
+frame finished after a newer one was taken is dropped.
+
+With more than one worker, the next frame is processed while the
+previous one is still being processed or used by the GUI thread.
+
+******************************************************************/
+
+template <typename Frame>
+class UpdatePipeline final
+{
+public:
+    // process(Frame&) is called in a worker thread, onFrameReady() too when
+    // there is a processed frame to take with TakeReadyFrame(), it must
+    // schedule it in the GUI thread, e.g., with CallAfter()
+    UpdatePipeline(const size_t workerCount, const std::function<void(Frame&)>& process,
+                   const std::function<void()>& onFrameReady)
+        : m_process(process), m_onFrameReady(onFrameReady)
+    {
+        for ( size_t i = 0; i < workerCount; ++i )
+            m_workers.emplace_back(&UpdatePipeline::Run, this);
+    }
+
+    // the frames being processed are waited for and dropped
+    ~UpdatePipeline()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            m_stop = true;
+        }
+        m_condition.notify_all();
+        for ( auto& worker : m_workers )
+            worker.join();
+    }
+
+    UpdatePipeline(const UpdatePipeline&) = delete;
+    UpdatePipeline& operator=(const UpdatePipeline&) = delete;
+
+    void Submit(Frame&& frame)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            if ( m_hasPending )
+                ++m_droppedCount;
+            m_pending = std::move(frame);
+            m_pendingNumber = ++m_submittedCount;
+            m_hasPending = true;
+        }
+        m_condition.notify_one();
+    }
+
+    // obtains the newest processed frame, returns false if there is none
+    bool TakeReadyFrame(Frame& frame)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if ( !m_hasReady )
+            return false;
+
+        frame = std::move(m_ready);
+        m_takenNumber = m_readyNumber;
+        m_hasReady = false;
+        return true;
+    }
+
+    // drops all the frames submitted so far, including those being processed
+    void Cancel()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if ( m_hasPending )
+            ++m_droppedCount;
+        if ( m_hasReady )
+            ++m_droppedCount;
+        m_pending = Frame();
+        m_ready = Frame();
+        m_hasPending = false;
+        m_hasReady = false;
+        m_takenNumber = m_submittedCount;
+    }
+
+    // the frames submitted but superseded before they were taken
+    uint64_t GetDroppedFrameCount() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        return m_droppedCount;
+    }
+private:
+    const std::function<void(Frame&)> m_process;
+    const std::function<void()> m_onFrameReady;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::vector<std::thread> m_workers;
+    bool m_stop{false};
+
+    uint64_t m_submittedCount{0};
+    uint64_t m_takenNumber{0}; // the frames up to this one are no longer needed
+    uint64_t m_droppedCount{0};
+
+    Frame m_pending;
+    uint64_t m_pendingNumber{0};
+    bool m_hasPending{false};
+
+    Frame m_ready;
+    uint64_t m_readyNumber{0};
+    bool m_hasReady{false};
+
+    void Run()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        for ( ;; )
+        {
+            m_condition.wait(lock, [this]() { return m_stop || m_hasPending; });
+            if ( m_stop )
+                return;
+
+            Frame frame(std::move(m_pending));
+            const uint64_t number = m_pendingNumber;
+
+            m_pending = Frame();
+            m_hasPending = false;
+
+            lock.unlock();
+            m_process(frame);
+            lock.lock();
+
+            // superseded while being processed
+            if ( number <= m_takenNumber || (m_hasReady && m_readyNumber > number) )
+            {
+                ++m_droppedCount;
+                continue;
+            }
+
+            const bool notify = !m_hasReady;
+
+            if ( m_hasReady )
+                ++m_droppedCount;
+            m_ready = std::move(frame);
+            m_readyNumber = number;
+            m_hasReady = true;
+
+            // the GUI thread was already notified about the replaced frame
+            if ( notify && m_onFrameReady )
+            {
+                lock.unlock();
+                m_onFrameReady();
+                lock.lock();
+            }
+        }
+    }
+};
@@ -0,0 +1,144 @@
+///////////////////////////////////////////////////////////////////////////////
+// Project:     wxECharts
+// Home:        https://github.com/PBfordev/wxecharts
+// File Name:   webkitprofile.cpp
+// Purpose:     Implementation of WebKitGTK performance profiles
+// Author:      PB
+// Created:     2026-10-18
+// Copyright:   (c) 2026 PB
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#include <wx/wx.h>
+#include <wx/webview.h>
+
+#ifdef __WXGTK__
+    #include <webkit2/webkit2.h>
+#endif // #ifdef __WXGTK__
+
+#include "webkitprofile.h"
+
+namespace {
+
+// indexed by WebKitProfile::Profile
+const char* const ProfileNames[] = { "default", "lightweight" };
+
+} // anonymous namespace
+
+WebKitProfile::Profile WebKitProfile::ms_profile = WebKitProfile::Default;
+
+bool WebKitProfile::FromName(const wxString& name, Profile& profile)
+{
+    for ( size_t i = 0; i < WXSIZEOF(ProfileNames); ++i )
+    {
+        if ( name.IsSameAs(ProfileNames[i], false) )
+        {
+            profile = static_cast<Profile>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+wxString WebKitProfile::GetName(const Profile profile)
+{
+    wxCHECK_MSG(profile >= Default && profile <= Lightweight, wxString(), "invalid profile");
+
+    return ProfileNames[profile];
+}
+
+wxString WebKitProfile::GetNames()
+{
+    wxString names;
+
+    for ( const auto name : ProfileNames )
+    {
+        if ( !names.empty() )
+            names += "|";
+        names += name;
+    }
+    return names;
+}
+
+void WebKitProfile::Set(const Profile profile)
+{
+    wxCHECK_RET(profile >= Default && profile <= Lightweight, "invalid profile");
+
+    ms_profile = profile;
+
+#ifdef __WXGTK__
+    if ( profile == Lightweight )
+    {
+        // the renderer probing the GPU is slow without one, the environment
+        // is inherited by the web processes, unless set by the user
+        if ( !wxGetEnv("WEBKIT_DISABLE_DMABUF_RENDERER", nullptr) )
+            wxSetEnv("WEBKIT_DISABLE_DMABUF_RENDERER", "1");
+    }
+
+    ApplyToWebContext(webkit_web_context_get_default());
+#endif // #ifdef __WXGTK__
+}
+
+WebKitProfile::Profile WebKitProfile::Get()
+{
+    return ms_profile;
+}
+
+void WebKitProfile::ApplyToWebContext(void* webContext)
+{
+    wxCHECK_RET(webContext, "null webContext");
+
+#ifdef __WXGTK__
+    WebKitWebContext* context = static_cast<WebKitWebContext*>(webContext);
+
+    if ( ms_profile != Lightweight )
+        return;
+
+    // the chart page is loaded once, there is nothing to cache
+    webkit_web_context_set_cache_model(context, WEBKIT_CACHE_MODEL_DOCUMENT_VIEWER);
+
+#if !WEBKIT_CHECK_VERSION(2, 26, 0)
+    // newer versions always use a web process per webview
+    webkit_web_context_set_process_model(context, WEBKIT_PROCESS_MODEL_SHARED_SECONDARY_PROCESS);
+#endif
+#endif // #ifdef __WXGTK__
+}
+
+void WebKitProfile::Apply(wxWebView* webView)
+{
+    wxCHECK_RET(webView, "null webView");
+
+#ifdef __WXGTK__
+    WebKitWebView* webKitView = static_cast<WebKitWebView*>(webView->GetNativeBackend());
+
+    if ( !webKitView || ms_profile != Lightweight )
+        return;
+
+    WebKitSettings* settings = webkit_web_view_get_settings(webKitView);
+
+    if ( !settings )
+    {
+        wxLogError(_("Could not apply the WebKit profile (failed to obtain WebKitSettings)."));
+        return;
+    }
+
+    webkit_settings_set_hardware_acceleration_policy(settings, WEBKIT_HARDWARE_ACCELERATION_POLICY_NEVER);
+    webkit_settings_set_enable_webgl(settings, FALSE);
+#if WEBKIT_CHECK_VERSION(2, 26, 0)
+    webkit_settings_set_enable_media(settings, FALSE);
+#endif
+    webkit_settings_set_enable_webaudio(settings, FALSE);
+    webkit_settings_set_enable_media_stream(settings, FALSE);
+    webkit_settings_set_enable_page_cache(settings, FALSE);
+#if !WEBKIT_CHECK_VERSION(2, 32, 0)
+    // newer versions do not support plugins at all
+    webkit_settings_set_enable_plugins(settings, FALSE);
+#endif
+
+    // in case the webview does not use the default context, the process
+    // model cannot be changed anymore but the cache model can
+    webkit_web_context_set_cache_model(webkit_web_view_get_context(webKitView), WEBKIT_CACHE_MODEL_DOCUMENT_VIEWER);
+#else
+    wxUnusedVar(webView);
+#endif // #ifdef __WXGTK__
+}
@@ -0,0 +1,65 @@
+///////////////////////////////////////////////////////////////////////////////
+// Project:     wxECharts
+// Home:        https://github.com/PBfordev/wxecharts
+// File Name:   webkitprofile.h
+// Purpose:     Declaration of WebKitGTK performance profiles
+// Author:      PB
+// Created:     2026-10-18
+// Copyright:   (c) 2026 PB
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <wx/string.h>
+
+class wxWebView;
+
+/*****************************************************************
+
+WebKitProfile
+---------------
+sets up WebKitGTK for the charts, on other platforms it does nothing
+
+The Lightweight profile is meant for machines without GPU, where
+WebKitGTK probing the hardware acceleration and compositing
+is slow, and for many charts, where each of them costs memory.
+It never uses the hardware acceleration, has the smallest caches,
+disables the features the charts do not need (media, WebGL,
+plugins, page cache) and with old WebKitGTK versions shares
+one web process for all webviews.
+
+The profile is process-wide, as some of the settings are.
+
+******************************************************************/
+
+class WebKitProfile final
+{
+public:
+    enum Profile
+    {
+        // the WebKitGTK defaults
+        Default = 0,
+        Lightweight,
+    };
+
+    // the name is case-insensitive
+    static bool FromName(const wxString& name, Profile& profile);
+    static wxString GetName(const Profile profile);
+    // all the names separated with '|', for the help
+    static wxString GetNames();
+
+    // must be called before any webview is created
+    static void Set(const Profile profile);
+    static Profile Get();
+
+    // applies the process-wide part of the profile to the WebKitWebContext,
+    // before it creates a web process; Set() does it for the default context
+    static void ApplyToWebContext(void* webContext);
+
+    // applies the profile to the webview using the WebKit backend,
+    // should be called as soon as the webview is created
+    static void Apply(wxWebView* webView);
+private:
+    static Profile ms_profile;
+};
@@ -0,0 +1,77 @@
+///////////////////////////////////////////////////////////////////////////////
+// Project:     wxECharts
+// Home:        https://github.com/PBfordev/wxecharts
+// File Name:   webviewfactory.cpp
+// Purpose:     Implementation of the factory of chart webviews
+// Author:      PB
+// Created:     2026-10-18
+// Copyright:   (c) 2026 PB
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#include <wx/wx.h>
+#include <wx/webview.h>
+
+#include "webkitprofile.h"
+#include "webviewfactory.h"
+
+#if wxCHECK_VERSION(3, 3, 0) && defined(__WXGTK__)
+    #define SHARING_WEBKIT_CONFIGURATION 1
+#else
+    #define SHARING_WEBKIT_CONFIGURATION 0
+#endif
+
+namespace {
+
+#if SHARING_WEBKIT_CONFIGURATION
+
+// created by WebViewFactory::Init(), deleted by WebViewFactory::Release()
+wxWebViewConfiguration* sharedWebKitConfiguration = nullptr;
+
+#endif // #if SHARING_WEBKIT_CONFIGURATION
+
+} // anonymous namespace
+
+wxWebView* WebViewFactory::Create(wxWindow* parent, const wxString& url, const wxString& backend)
+{
+#if SHARING_WEBKIT_CONFIGURATION
+    if ( backend == wxWebViewBackendWebKit && sharedWebKitConfiguration )
+    {
+        wxWebView* webView = wxWebView::New(*sharedWebKitConfiguration);
+
+        if ( !webView )
+            return nullptr;
+
+        if ( !webView->Create(parent, wxID_ANY, url) )
+        {
+            delete webView;
+            return nullptr;
+        }
+        return webView;
+    }
+#endif // #if SHARING_WEBKIT_CONFIGURATION
+
+    return wxWebView::New(parent, wxID_ANY, url, wxDefaultPosition, wxDefaultSize, backend);
+}
+
+void WebViewFactory::Init()
+{
+#if SHARING_WEBKIT_CONFIGURATION
+    wxCHECK_RET(!sharedWebKitConfiguration, "WebViewFactory already initialized");
+
+    sharedWebKitConfiguration = new wxWebViewConfiguration(wxWebView::NewConfiguration(wxWebViewBackendWebKit));
+
+    // no webview uses it yet, so it has no web process yet
+    if ( sharedWebKitConfiguration->GetNativeConfiguration() )
+        WebKitProfile::ApplyToWebContext(sharedWebKitConfiguration->GetNativeConfiguration());
+#endif // #if SHARING_WEBKIT_CONFIGURATION
+}
+
+void WebViewFactory::Release()
+{
+#if SHARING_WEBKIT_CONFIGURATION
+    // the webviews still existing keep their own references to it
+    delete sharedWebKitConfiguration;
+    sharedWebKitConfiguration = nullptr;
+#endif // #if SHARING_WEBKIT_CONFIGURATION
+}
@@ -0,0 +1,48 @@
+///////////////////////////////////////////////////////////////////////////////
+// Project:     wxECharts
+// Home:        https://github.com/PBfordev/wxecharts
+// File Name:   webviewfactory.h
+// Purpose:     Declaration of the factory of chart webviews
+// Author:      PB
+// Created:     2026-10-18
+// Copyright:   (c) 2026 PB
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <wx/string.h>
+
+class wxWebView;
+class wxWindow;
+
+/*****************************************************************
+
+WebViewFactory
+---------------
+creates the webviews for the charts
+
+On WebKitGTK, all the webviews created by the factory share one
+WebKitWebContext, i.e. one network process, one set of resource
+caches and, with WebKitGTK older than 2.26 and the lightweight
+WebKitProfile, one web process. wxWidgets 3.2 uses the default
+context for every webview, wxWidgets 3.3 creates every webview
+with its own wxWebViewConfiguration unless given one, so the factory
+gives them the same one, with the WebKitProfile applied to it.
+The application owns that configuration: it is created with Init()
+when the application starts and released with Release() when it
+exits, while wxWidgets and WebKitGTK are still initialized.
+
+******************************************************************/
+
+class WebViewFactory final
+{
+public:
+    // creates the webview with the backend and starts loading the URL,
+    // returns null if the webview could not be created
+    static wxWebView* Create(wxWindow* parent, const wxString& url, const wxString& backend);
+
+    // must be called after WebKitProfile::Set() and before creating the webviews
+    static void Init();
+    static void Release();
+};
@@ -10,6 +10,7 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include <wx/wx.h>
+#include <wx/cmdline.h>
 #include <wx/config.h>
 #include <wx/filedlg.h>
 #include <wx/filename.h>
@@ -18,6 +19,7 @@
 
 #include "wxecharts.h"
 #include "mainframe.h"
+#include "webviewfactory.h"
 
 bool wxEChartsApp::OnInit()
 {
@@ -55,18 +57,91 @@ bool wxEChartsApp::OnInit()
 
     wxInitAllImageHandlers();
 
+    WebKitProfile::Set(m_webKitProfile);
+    WebViewFactory::Init();
+
     wxEChartsMainFrame* mainFrame = new wxEChartsMainFrame(nullptr, assetsFolder);
     mainFrame->Show();
 
+    // e.g., "collector | wxECharts --stdin"
+    if ( m_readStdin )
+        mainFrame->StartStdinIngest(static_cast<size_t>(m_liveCapacity));
+    else if ( m_metricsPort > 0 )
+        mainFrame->StartMetricsListener(static_cast<uint16_t>(m_metricsPort), static_cast<size_t>(m_liveCapacity));
+    else if ( !m_sharedRingBufferName.empty() )
+        mainFrame->AttachSharedRingBuffer(m_sharedRingBufferName, static_cast<size_t>(m_liveCapacity));
+
     return true;
 }
 
 int wxEChartsApp::OnExit()
 {
+    WebViewFactory::Release();
     delete wxConfigBase::Set(nullptr);
     return wxApp::OnExit();
 }
 
+void wxEChartsApp::OnInitCmdLine(wxCmdLineParser& parser)
+{
+    wxApp::OnInitCmdLine(parser);
+
+    parser.AddSwitch("", "stdin", _("read live values from the standard input, each line as '<series> <timestamp> <value>'"));
+    parser.AddOption("", "statsd", _("receive StatsD metrics on the local UDP and TCP port"), wxCMD_LINE_VAL_NUMBER);
+    parser.AddOption("", "shm", _("read live values from the ring buffer in the named shared memory"));
+    parser.AddOption("", "capacity", _("the number of values kept in each live series"), wxCMD_LINE_VAL_NUMBER);
+#ifdef __WXGTK__
+    parser.AddOption("", "webkit-profile", wxString::Format(_("the WebKit performance profile (%s)"), WebKitProfile::GetNames()));
+#endif // #ifdef __WXGTK__
+}
+
+bool wxEChartsApp::OnCmdLineParsed(wxCmdLineParser& parser)
+{
+    if ( !wxApp::OnCmdLineParsed(parser) )
+        return false;
+
+    m_readStdin = parser.Found("stdin");
+    parser.Found("shm", &m_sharedRingBufferName);
+
+    if ( parser.Found("capacity", &m_liveCapacity) )
+    {
+        if ( m_liveCapacity <= 0 )
+        {
+            wxLogError(_("The capacity must be a positive number."));
+            return false;
+        }
+    }
+    else if ( !m_sharedRingBufferName.empty() )
+    {
+        // use the capacity of the shared ring buffer
+        m_liveCapacity = 0;
+    }
+
+    if ( parser.Found("statsd", &m_metricsPort) && (m_metricsPort <= 0 || m_metricsPort > 65535) )
+    {
+        wxLogError(_("The port must be a number from 1 to 65535."));
+        return false;
+    }
+
+#ifdef __WXGTK__
+    wxString webKitProfileName;
+
+    if ( parser.Found("webkit-profile", &webKitProfileName)
+         && !WebKitProfile::FromName(webKitProfileName, m_webKitProfile) )
+    {
+        wxLogError(_("Unknown WebKit profile '%s', use one of %s."), webKitProfileName, WebKitProfile::GetNames());
+        return false;
+    }
+#endif // #ifdef __WXGTK__
+
+    if ( (m_readStdin ? 1 : 0) + (m_metricsPort > 0 ? 1 : 0) + (m_sharedRingBufferName.empty() ? 0 : 1) > 1 )
+    {
+        wxLogError(_("Only one of the live data sources can be used."));
+        return false;
+    }
+
+    return true;
+}
+
 // for demonstration, be flexible when it comes to data assets folder location
 wxString wxEChartsApp::GetChartAssetsFolder()
 {
@@ -13,12 +13,29 @@
 
 #include <wx/app.h>
 
+#include "webkitprofile.h"
+
 class wxEChartsApp : public wxApp
 {
 private:
+    // the default capacity of the live series read from the standard input
+    // or the metrics listener
+    static constexpr long DefaultLiveCapacity = 10 * 60 * 10;
+
+    bool m_readStdin{false};
+    long m_liveCapacity{DefaultLiveCapacity};
+    // 0 if not listening to metrics
+    long m_metricsPort{0};
+    // empty if not attached to a shared ring buffer
+    wxString m_sharedRingBufferName;
+    WebKitProfile::Profile m_webKitProfile{WebKitProfile::Default};
+
     bool OnInit() override;
     int OnExit() override;
 
+    void OnInitCmdLine(wxCmdLineParser& parser) override;
+    bool OnCmdLineParsed(wxCmdLineParser& parser) override;
+
     wxString GetChartAssetsFolder();
 };
 